@@ -0,0 +1,25 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Core/TileConstants.h
+// Dimensions of tiles, sectors and quadrants
+
+#pragma once
+
+namespace TileConstants
+{
+	constexpr int TILE_SIDE_LENGTH = 5;
+	constexpr int SECTOR_SIDE_LENGTH = 50;
+	constexpr int QUADRANT_SIDE_LENGTH = 8;
+
+	constexpr int BASE_QUADRANT_ORIGIN_COORDINATE =
+		-TILE_SIDE_LENGTH *
+		SECTOR_SIDE_LENGTH *
+		QUADRANT_SIDE_LENGTH / 2;
+
+	// Will later be configuration data
+	constexpr int TILE_TYPE_COUNT = 8;
+}
@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Core/typedef.cpp
+// Definitions for the helpers declared alongside the common datatypes
+
+#include "typedef.h"
+#include "TileConstants.h"
+
+PathingDirection Opposite(PathingDirection d)
+{
+	switch (d)
+	{
+	case PathingDirection::NORTH: return PathingDirection::SOUTH;
+	case PathingDirection::SOUTH: return PathingDirection::NORTH;
+	case PathingDirection::EAST:  return PathingDirection::WEST;
+	case PathingDirection::WEST:  return PathingDirection::EAST;
+	}
+	return PathingDirection::_COUNT;
+}
+
+PathingDirection Clockwise90(PathingDirection d)
+{
+	switch (d)
+	{
+	case PathingDirection::NORTH: return PathingDirection::EAST;
+	case PathingDirection::EAST: return PathingDirection::SOUTH;
+	case PathingDirection::SOUTH: return PathingDirection::WEST;
+	case PathingDirection::WEST: return PathingDirection::NORTH;
+	}
+	return PathingDirection::_COUNT;
+}
+
+PathingDirection Counterclockwise90(PathingDirection d)
+{
+	switch (d)
+	{
+	case PathingDirection::NORTH: return PathingDirection::WEST;
+	case PathingDirection::WEST: return PathingDirection::SOUTH;
+	case PathingDirection::SOUTH: return PathingDirection::EAST;
+	case PathingDirection::EAST: return PathingDirection::NORTH;
+	}
+	return PathingDirection::_COUNT;
+}
+
+Direction Opposite(Direction d)
+{
+	switch (d)
+	{
+	case Direction::NORTH: return Direction::SOUTH;
+	case Direction::SOUTH: return Direction::NORTH;
+	case Direction::EAST:  return Direction::WEST;
+	case Direction::WEST:  return Direction::EAST;
+	case Direction::NORTHEAST: return Direction::SOUTHWEST;
+	case Direction::SOUTHEAST: return Direction::NORTHWEST;
+	case Direction::NORTHWEST:  return Direction::SOUTHEAST;
+	case Direction::SOUTHWEST:  return Direction::NORTHEAST;
+	}
+	return Direction::_COUNT;
+}
+
+TilePosition& TilePosition::operator+=(const TilePosition& other)
+{
+	m_quadrantCoords += other.m_quadrantCoords;
+	m_sectorCoords += other.m_sectorCoords;
+	m_coords += other.m_coords;
+	for (; m_coords.m_x < 0; m_coords.m_x += TileConstants::SECTOR_SIDE_LENGTH, --m_sectorCoords.m_x);
+	for (; m_coords.m_y < 0; m_coords.m_y += TileConstants::SECTOR_SIDE_LENGTH, --m_sectorCoords.m_y);
+	for (; m_sectorCoords.m_x < 0; m_sectorCoords.m_x += TileConstants::QUADRANT_SIDE_LENGTH, --m_quadrantCoords.m_x);
+	for (; m_sectorCoords.m_y < 0; m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH, --m_quadrantCoords.m_y);
+
+	m_sectorCoords.m_x += m_coords.m_x / TileConstants::SECTOR_SIDE_LENGTH;
+	m_sectorCoords.m_y += m_coords.m_y / TileConstants::SECTOR_SIDE_LENGTH;
+	m_coords.m_x %= TileConstants::SECTOR_SIDE_LENGTH;
+	m_coords.m_y %= TileConstants::SECTOR_SIDE_LENGTH;
+
+	m_quadrantCoords.m_x += m_sectorCoords.m_x / TileConstants::QUADRANT_SIDE_LENGTH;
+	m_quadrantCoords.m_y += m_sectorCoords.m_y / TileConstants::QUADRANT_SIDE_LENGTH;
+	m_sectorCoords.m_x %= TileConstants::QUADRANT_SIDE_LENGTH;
+	m_sectorCoords.m_y %= TileConstants::QUADRANT_SIDE_LENGTH;
+	return *this;
+}
+
+TilePosition& TilePosition::operator-=(const TilePosition& other)
+{
+	m_quadrantCoords -= other.m_quadrantCoords;
+	m_sectorCoords -= other.m_sectorCoords;
+	m_coords -= other.m_coords;
+
+	while (m_coords.m_x < 0)
+	{
+		--m_sectorCoords.m_x;
+		m_coords.m_x += TileConstants::SECTOR_SIDE_LENGTH;
+	}
+	while (m_coords.m_y < 0)
+	{
+		--m_sectorCoords.m_y;
+		m_coords.m_y += TileConstants::SECTOR_SIDE_LENGTH;
+	}
+
+	while (m_sectorCoords.m_x < 0)
+	{
+		--m_quadrantCoords.m_x;
+		m_sectorCoords.m_x += TileConstants::QUADRANT_SIDE_LENGTH;
+	}
+	while (m_sectorCoords.m_y < 0)
+	{
+		--m_quadrantCoords.m_y;
+		m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH;
+	}
+	return *this;
+}
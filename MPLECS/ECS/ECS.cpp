@@ -1,8 +1,122 @@
 #include "ECS.h"
 
+#include <algorithm>
+
 bool ECS_Core::Components::PopulationKey::operator<(const PopulationKey& other) const
 {
 	if (other.m_birthMonthIndex < m_birthMonthIndex) return false;
 	if (other.m_birthMonthIndex > m_birthMonthIndex) return true;
 	return m_segmentIndex < other.m_segmentIndex;
-}
\ No newline at end of file
+}
+bool ECS_Core::Components::PopulationKey::operator==(const PopulationKey& other) const
+{
+	return m_birthMonthIndex == other.m_birthMonthIndex
+		&& m_segmentIndex == other.m_segmentIndex;
+}
+
+size_t ECS_Core::Components::C_Population::Find(const PopulationKey& key) const
+{
+	auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+	if (iter == m_keys.end() || !(*iter == key))
+	{
+		return c_noCohort;
+	}
+	return iter - m_keys.begin();
+}
+
+size_t ECS_Core::Components::C_Population::FindOrInsert(const PopulationKey& key)
+{
+	auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+	size_t index = iter - m_keys.begin();
+	if (iter != m_keys.end() && *iter == key)
+	{
+		return index;
+	}
+	m_keys.insert(iter, key);
+	m_numWomen.insert(m_numWomen.begin() + index, 1);
+	m_womensHealth.insert(m_womensHealth.begin() + index, 1.);
+	m_numMen.insert(m_numMen.begin() + index, 1);
+	m_mensHealth.insert(m_mensHealth.begin() + index, 1.);
+	m_class.insert(m_class.begin() + index, PopulationClass::CHILDREN);
+	m_specialtyMask.insert(m_specialtyMask.begin() + index, 0);
+	m_specialties.insert(m_specialties.begin() + index * c_specialtyCount, c_specialtyCount, SpecialtyProgress());
+	return index;
+}
+
+size_t ECS_Core::Components::C_Population::InsertUnique(PopulationKey key)
+{
+	// Cohorts born the same month sit next to each other, in segment order
+	auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+	while (iter != m_keys.end() && *iter == key)
+	{
+		++key.m_segmentIndex;
+		++iter;
+	}
+	return FindOrInsert(key);
+}
+
+void ECS_Core::Components::C_Population::CopyCohort(size_t targetIndex, const C_Population& source, size_t sourceIndex)
+{
+	m_numWomen[targetIndex] = source.m_numWomen[sourceIndex];
+	m_womensHealth[targetIndex] = source.m_womensHealth[sourceIndex];
+	m_numMen[targetIndex] = source.m_numMen[sourceIndex];
+	m_mensHealth[targetIndex] = source.m_mensHealth[sourceIndex];
+	m_class[targetIndex] = source.m_class[sourceIndex];
+	m_specialtyMask[targetIndex] = source.m_specialtyMask[sourceIndex];
+	std::copy_n(
+		source.m_specialties.begin() + sourceIndex * c_specialtyCount,
+		c_specialtyCount,
+		m_specialties.begin() + targetIndex * c_specialtyCount);
+}
+
+void ECS_Core::Components::C_Population::Erase(size_t index)
+{
+	m_keys.erase(m_keys.begin() + index);
+	m_numWomen.erase(m_numWomen.begin() + index);
+	m_womensHealth.erase(m_womensHealth.begin() + index);
+	m_numMen.erase(m_numMen.begin() + index);
+	m_mensHealth.erase(m_mensHealth.begin() + index);
+	m_class.erase(m_class.begin() + index);
+	m_specialtyMask.erase(m_specialtyMask.begin() + index);
+	auto specialtyRow = m_specialties.begin() + index * c_specialtyCount;
+	m_specialties.erase(specialtyRow, specialtyRow + c_specialtyCount);
+}
+
+void ECS_Core::Components::C_Population::EraseEmpty()
+{
+	// Slide the surviving cohorts down over the empty ones, keeping them in order
+	size_t kept = 0;
+	for (size_t i = 0; i < Size(); ++i)
+	{
+		if (m_numMen[i] <= 0 && m_numWomen[i] <= 0)
+		{
+			continue;
+		}
+		if (kept != i)
+		{
+			m_keys[kept] = m_keys[i];
+			CopyCohort(kept, *this, i);
+		}
+		++kept;
+	}
+	m_keys.resize(kept);
+	m_numWomen.resize(kept);
+	m_womensHealth.resize(kept);
+	m_numMen.resize(kept);
+	m_mensHealth.resize(kept);
+	m_class.resize(kept);
+	m_specialtyMask.resize(kept);
+	m_specialties.resize(kept * c_specialtyCount);
+}
+
+void ECS_Core::Components::C_Population::Clear()
+{
+	m_keys.clear();
+	m_numWomen.clear();
+	m_womensHealth.clear();
+	m_numMen.clear();
+	m_mensHealth.clear();
+	m_class.clear();
+	m_specialtyMask.clear();
+	m_specialties.clear();
+}
@@ -2,18 +2,28 @@
 
 #include "../ecs/ecs.hpp"
 
+#include "../Core/TileConstants.h"
 #include "../Core/typedef.h"
 
 #include "../Components/ActionComponents.h"
 #include "../Components/GraphicsComponents.h"
 #include "../Components/InputComponents.h"
 
+#include "../Util/CompactPath.h"
+
 #include <SFML/Graphics.hpp>
+#include <cassert>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <set>
 #include <variant>
+#include <vector>
+
+namespace Pathing
+{
+	class IncrementalPath;
+}
 
 namespace ECS_Core
 {
@@ -134,18 +144,10 @@ namespace ECS_Core
 			SpecialtyExperience m_experience{ 0 };
 		};
 
-		using SpecialtyMap = std::map<SpecialtyId, SpecialtyProgress>;
-
-		struct PopulationSegment
-		{
-			// Age in months
-			s32 m_numWomen{ 1 };
-			f64 m_womensHealth{ 1. };
-			s32 m_numMen{ 1 };
-			f64 m_mensHealth{ 1. };
-			SpecialtyMap m_specialties;
-			PopulationClass m_class{ PopulationClass::CHILDREN };
-		};
+		// Specialties are the tile types worked, and there are few of them,
+		// so every cohort keeps a full row of them
+		constexpr SpecialtyId c_specialtyCount = TileConstants::TILE_TYPE_COUNT;
+		static_assert(c_specialtyCount <= 32, "Each cohort's specialties are one bit each of a u32");
 
 		// Age (months)
 		struct PopulationKey
@@ -158,10 +160,82 @@ namespace ECS_Core
 			s32 m_birthMonthIndex{ 0 };
 			int m_segmentIndex{ 0 };
 			bool operator<(const PopulationKey& other) const;
+			bool operator==(const PopulationKey& other) const;
 		};
+
+		// People grouped into cohorts by birth month, stored as parallel arrays sorted by key
+		// Cohort indices are only good until the next insert or erase
 		struct C_Population
 		{
-			std::map<PopulationKey, PopulationSegment> m_populations;
+			static constexpr size_t c_noCohort = static_cast<size_t>(-1);
+
+			size_t Size() const { return m_keys.size(); }
+			bool Empty() const { return m_keys.empty(); }
+
+			// Index of the cohort with the key, or c_noCohort
+			size_t Find(const PopulationKey& key) const;
+			// Index of the cohort with the key, inserting a new cohort of children if there isn't one
+			size_t FindOrInsert(const PopulationKey& key);
+			// Inserts a new cohort, moving its segment index past any cohorts born the same month
+			size_t InsertUnique(PopulationKey key);
+			// Gives the target cohort the source cohort's people, health, class and specialties
+			void CopyCohort(size_t targetIndex, const C_Population& source, size_t sourceIndex);
+			void Erase(size_t index);
+			// Removes every cohort with nobody left in it
+			void EraseEmpty();
+			void Clear();
+
+			bool HasSpecialty(size_t cohort, SpecialtyId specialty) const
+			{
+				assert(cohort < Size() && specialty >= 0 && specialty < c_specialtyCount);
+				return (m_specialtyMask[cohort] & (1u << specialty)) != 0;
+			}
+			// Starts the cohort in the specialty if it hadn't been yet
+			SpecialtyProgress& Specialty(size_t cohort, SpecialtyId specialty)
+			{
+				assert(cohort < Size() && specialty >= 0 && specialty < c_specialtyCount);
+				m_specialtyMask[cohort] |= (1u << specialty);
+				return m_specialties[cohort * c_specialtyCount + specialty];
+			}
+			const SpecialtyProgress& Specialty(size_t cohort, SpecialtyId specialty) const
+			{
+				assert(cohort < Size() && specialty >= 0 && specialty < c_specialtyCount);
+				return m_specialties[cohort * c_specialtyCount + specialty];
+			}
+			// Calls callback(SpecialtyId, SpecialtyProgress&) for each specialty the cohort has, lowest id first
+			template <typename Callback>
+			void ForEachSpecialty(size_t cohort, Callback&& callback)
+			{
+				for (SpecialtyId specialty = 0; specialty < c_specialtyCount; ++specialty)
+				{
+					if (HasSpecialty(cohort, specialty))
+					{
+						callback(specialty, m_specialties[cohort * c_specialtyCount + specialty]);
+					}
+				}
+			}
+			template <typename Callback>
+			void ForEachSpecialty(size_t cohort, Callback&& callback) const
+			{
+				for (SpecialtyId specialty = 0; specialty < c_specialtyCount; ++specialty)
+				{
+					if (HasSpecialty(cohort, specialty))
+					{
+						callback(specialty, m_specialties[cohort * c_specialtyCount + specialty]);
+					}
+				}
+			}
+
+			std::vector<PopulationKey> m_keys;
+			std::vector<s32> m_numWomen;
+			std::vector<f64> m_womensHealth;
+			std::vector<s32> m_numMen;
+			std::vector<f64> m_mensHealth;
+			std::vector<PopulationClass> m_class;
+			// One bit per specialty the cohort has started
+			std::vector<u32> m_specialtyMask;
+			// c_specialtyCount entries per cohort
+			std::vector<SpecialtyProgress> m_specialties;
 		};
 
 		struct C_Territory
@@ -240,12 +314,29 @@ namespace ECS_Core
 			int m_day{ 0 };
 			f64 m_dayProgress{ 0 };
 
-			// Amount of game time between previous frame and current
+			// Amount of game time covered by the current simulation step
 			f64 m_frameDuration{ 0 };
 
 			int m_gameSpeed{ 1 };
 			bool m_paused{ true };
 
+			// The simulation advances in fixed steps of c_stepDays.
+			// Game time owed by the real time that passed piles up in m_pendingDays,
+			// and each rendered frame runs as many whole steps as it covers and its step budget allows.
+			// Steps a frame didn't get to carry over to the next.
+			static constexpr f64 c_stepDays = 1. / 32;
+			// Past this much owed time the simulation can't catch up, and the excess is dropped
+			// rather than fast-forwarding long after the game slows down
+			static constexpr f64 c_maxPendingDays = 30;
+			f64 m_pendingDays{ 0 };
+			// Game time lost to the bound above, shown by the calendar and headless reports
+			f64 m_droppedDays{ 0 };
+			// ACTION and ACTION_RESPONSE run this many times this frame, at least once so commands get processed
+			int m_stepsThisFrame{ 1 };
+			int m_stepsRemaining{ 0 };
+			// Simulation steps run so far, for keying random streams
+			u32 m_stepCount{ 0 };
+
 			bool IsNewMonth() const
 			{
 				return m_day == 1
@@ -271,6 +362,8 @@ namespace ECS_Core
 		struct C_WindowInfo
 		{
 			CartesianVector2<f64> m_windowSize;
+			// No window is open, so there's no graphics context for textures
+			bool m_headless{ false };
 		};
 
 		struct C_ActionPlan
@@ -304,10 +397,16 @@ namespace ECS_Core
 		struct MoveToPoint
 		{
 			TilePosition m_targetPosition;
-			std::vector<MovementTilePosition> m_path;
-			int m_currentPathIndex{ 0 };
+			// Also keeps the tile the unit has got to
+			CompactPath m_path;
 			f64 m_currentMovementProgress{ 0 };
 			s64 m_totalPathCost{ 0 };
+
+			// Kept once tile costs change near the path, so later changes only repair it
+			// Searches a window of tiles, whose corner is in tiles from the world origin
+			// Let go once the unit arrives or walks out of the window
+			std::shared_ptr<Pathing::IncrementalPath> m_repairSearch;
+			CoordinateVector2 m_repairWindowOrigin;
 		};
 
 		struct C_MovingUnit
@@ -360,6 +459,31 @@ namespace ECS_Core
 			ecs::Impl::Handle m_commandee;
 			ecs::Impl::Handle m_governor;
 		};
+
+		// Asks WorldTile for a path from the source to the first reachable target
+		// Searched off the main thread, the answer comes back as a C_PathResult on a later frame
+		struct C_PathRequest
+		{
+			TilePosition m_sourcePosition;
+			std::vector<TilePosition> m_targetPositions;
+			// Killed once a path is found
+			std::optional<ecs::Impl::Handle> m_targetingIcon;
+			// A newer request on the same entity replaces the one in flight
+			u64 m_requestId{ 0 };
+			bool m_submitted{ false };
+			// Asked for the rest of the unit's path after tile costs changed, rather than for new orders
+			bool m_repair{ false };
+			// Set on repairs near enough to keep a search for: its lowest and highest tile, from the world origin
+			std::optional<std::pair<CoordinateVector2, CoordinateVector2>> m_repairWindow;
+		};
+
+		struct C_PathResult
+		{
+			TilePosition m_targetPosition;
+			std::optional<MoveToPoint> m_path;
+			// Joins the unit's current path instead of replacing it
+			bool m_repair{ false };
+		};
 	}
 
 	namespace Tags
@@ -390,6 +514,7 @@ namespace ECS_Core
 		using S_InProgressBuilding = ecs::Signature<Components::C_BuildingDescription, Components::C_TilePosition, Components::C_BuildingConstruction>;
 		using S_CompleteBuilding = ecs::Signature<Components::C_BuildingDescription, Components::C_TilePosition, Components::C_Territory, Components::C_TileProductionPotential, Components::C_ResourceInventory>;
 		using S_Population = ecs::Signature<Components::C_Population, Components::C_ResourceInventory>;
+		using S_ProducingTerritory = ecs::Signature<Components::C_Territory, Components::C_Population, Components::C_TileProductionPotential, Components::C_ResourceInventory>;
 		using S_DestroyedBuilding = ecs::Signature<Components::C_BuildingDescription, Components::C_TilePosition, Tags::T_Dead>;
 		using S_Governor = ecs::Signature<Components::C_Realm, Components::C_Agenda>;
 		using S_PlayerGovernor = ecs::Signature<Components::C_Realm, Tags::T_LocalPlayer>;
@@ -404,6 +529,8 @@ namespace ECS_Core
 		using S_BuilderUnit = ecs::Signature<Components::C_TilePosition, Components::C_MovingUnit, Components::C_BuildingDescription, Components::C_Population>;
 		using S_CaravanUnit = ecs::Signature<Components::C_TilePosition, Components::C_MovingUnit, Components::C_ResourceInventory, Components::C_Population, Components::C_CaravanPath>;
 		using S_CommandUnit = ecs::Signature<Components::C_TilePosition, Components::C_MovingUnit, Components::C_ResourceInventory, Components::C_Population, Components::C_CommandMessage>;
+		using S_PathRequest = ecs::Signature<Components::C_PathRequest>;
+		using S_PathResult = ecs::Signature<Components::C_MovingUnit, Components::C_PathResult>;
 		using S_MovementPlanIndicator = ecs::Signature<Components::C_MovementTarget, Components::C_TilePosition>;
 		using S_CaravanPlanIndicator = ecs::Signature<Components::C_CaravanPlan, Components::C_TilePosition>;
 		using S_ScoutPlanner = ecs::Signature<Components::C_ScoutingPlan>;
@@ -441,7 +568,9 @@ namespace ECS_Core
 		Components::C_CaravanPath,
 		Components::C_ScoutingPlan,
 		Components::C_Vision,
-		Components::C_CommandMessage
+		Components::C_CommandMessage,
+		Components::C_PathRequest,
+		Components::C_PathResult
 	>;
 
 	using MasterTagList = ecs::TagList<
@@ -463,6 +592,7 @@ namespace ECS_Core
 		Signatures::S_InProgressBuilding,
 		Signatures::S_CompleteBuilding,
 		Signatures::S_Population,
+		Signatures::S_ProducingTerritory,
 		Signatures::S_DestroyedBuilding,
 		Signatures::S_Governor,
 		Signatures::S_PlayerGovernor,
@@ -476,6 +606,8 @@ namespace ECS_Core
 		Signatures::S_BuilderUnit,
 		Signatures::S_CaravanUnit,
 		Signatures::S_CommandUnit,
+		Signatures::S_PathRequest,
+		Signatures::S_PathResult,
 		Signatures::S_MovingUnit,
 		Signatures::S_SelectedMovingUnit,
 		Signatures::S_MovementPlanIndicator,
@@ -486,6 +618,7 @@ namespace ECS_Core
 
 	using MasterSettings = ecs::Settings<MasterComponentList, MasterTagList, MasterSignatureList>;
 	using Manager = ecs::Manager<MasterSettings>;
+	using CommandBuffer = ecs::CommandBuffer<MasterSettings>;
 
 	namespace Components
 	{
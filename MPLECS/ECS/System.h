@@ -37,6 +37,49 @@ enum class GameLoopPhase
 	CLEANUP
 };
 
+// Declarations of what a system touches in each phase,
+// used by the SystemScheduler to run systems that don't conflict side by side.
+// Systems list them as
+//	using Access = SystemAccess<
+//		PhaseAccess<GameLoopPhase::ACTION, Reads<C_TimeTracker>, Writes<C_Population>>,
+//		StructuralPhase<GameLoopPhase::CLEANUP>>;
+// A system is only run in the phases it lists.
+namespace SystemAccessFlags
+{
+	constexpr u8 NONE = 0;
+	// Creates or kills entities, or adds or removes components or tags.
+	// Runs alone, on the main thread.
+	constexpr u8 STRUCTURAL = 1 << 0;
+	// Uses the SFML window, which belongs to the main thread
+	constexpr u8 MAIN_THREAD = 1 << 1;
+}
+
+template <typename... Ts> using Reads = ecs::MPL::TypeList<Ts...>;
+template <typename... Ts> using Writes = ecs::MPL::TypeList<Ts...>;
+
+template <GameLoopPhase Phase, typename TReads, typename TWrites, u8 Flags = SystemAccessFlags::NONE>
+struct PhaseAccess
+{
+	static constexpr GameLoopPhase c_phase = Phase;
+	using ReadList = TReads;
+	using WriteList = TWrites;
+	static constexpr u8 c_flags = Flags;
+};
+
+template <GameLoopPhase Phase>
+using StructuralPhase = PhaseAccess<Phase, Reads<>, Writes<>, SystemAccessFlags::STRUCTURAL>;
+
+template <typename... TPhaseAccess> using SystemAccess = ecs::MPL::TypeList<TPhaseAccess...>;
+
+// Systems without an Access declaration run alone in every phase
+using UndeclaredSystemAccess = SystemAccess<
+	StructuralPhase<GameLoopPhase::PREPARATION>,
+	StructuralPhase<GameLoopPhase::INPUT>,
+	StructuralPhase<GameLoopPhase::ACTION>,
+	StructuralPhase<GameLoopPhase::ACTION_RESPONSE>,
+	StructuralPhase<GameLoopPhase::RENDER>,
+	StructuralPhase<GameLoopPhase::CLEANUP>>;
+
 class SystemBase
 {
 public:
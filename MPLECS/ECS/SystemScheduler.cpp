@@ -0,0 +1,176 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// ECS/SystemScheduler.cpp
+// Dependency tracking and execution of the systems of a phase
+
+#include "SystemScheduler.h"
+
+#include "../Util/Profiler.h"
+
+#include <cstring>
+
+SystemScheduler::SystemScheduler(ECS_Core::Manager& manager, ecs::ThreadPool& pool)
+	: m_managerRef(manager)
+	, m_pool(pool)
+{
+}
+
+bool SystemScheduler::Conflicts(const SystemNode& earlier, const SystemNode& later)
+{
+	if ((earlier.m_flags | later.m_flags) & SystemAccessFlags::STRUCTURAL)
+	{
+		return true;
+	}
+	return (earlier.m_writes & (later.m_reads | later.m_writes)).any()
+		|| (later.m_writes & earlier.m_reads).any();
+}
+
+std::string SystemScheduler::SystemName(const char* typeName)
+{
+	// MSVC names types "class Government"
+	std::string name(typeName);
+	for (auto&& prefix : { "class ", "struct " })
+	{
+		if (name.compare(0, strlen(prefix), prefix) == 0)
+		{
+			return name.substr(strlen(prefix));
+		}
+	}
+	return name;
+}
+
+static const char* PhaseName(GameLoopPhase phase)
+{
+	switch (phase)
+	{
+	case GameLoopPhase::PREPARATION: return "PREPARATION";
+	case GameLoopPhase::INPUT: return "INPUT";
+	case GameLoopPhase::ACTION: return "ACTION";
+	case GameLoopPhase::ACTION_RESPONSE: return "ACTION_RESPONSE";
+	case GameLoopPhase::RENDER: return "RENDER";
+	case GameLoopPhase::CLEANUP: return "CLEANUP";
+	}
+	return "";
+}
+
+void SystemScheduler::AddNode(
+	GameLoopPhase phase,
+	SystemBase& system,
+	const std::string& systemName,
+	u8 flags,
+	const AccessBitset& reads,
+	const AccessBitset& writes)
+{
+	auto& graph = m_phases[phase];
+	SystemNode node;
+	node.m_system = &system;
+	node.m_zoneName = systemName + " " + PhaseName(phase);
+	// Structural changes can't overlap anything, and keep the single threaded behaviour they were written for
+	node.m_flags = (flags & SystemAccessFlags::STRUCTURAL) ? (flags | SystemAccessFlags::MAIN_THREAD) : flags;
+	node.m_reads = reads;
+	node.m_writes = writes;
+
+	auto nodeIndex = graph.m_nodes.size();
+	for (auto&& earlier : graph.m_nodes)
+	{
+		if (Conflicts(earlier, node))
+		{
+			earlier.m_dependents.push_back(nodeIndex);
+			++node.m_dependencyCount;
+		}
+	}
+	graph.m_nodes.push_back(std::move(node));
+	graph.m_remainingDependencies = std::make_unique<std::atomic<u32>[]>(graph.m_nodes.size());
+}
+
+void SystemScheduler::RunPhase(GameLoopPhase phase, const timeuS& frameDuration)
+{
+	auto graphIter = m_phases.find(phase);
+	if (graphIter == m_phases.end())
+	{
+		return;
+	}
+	auto& graph = graphIter->second;
+
+	// Systems may query the same signatures at the same time,
+	// which is only safe once the manager's lists are compact
+	m_managerRef.prepareConcurrentQueries();
+
+	m_completedCount = 0;
+	for (size_t i = 0; i < graph.m_nodes.size(); ++i)
+	{
+		graph.m_remainingDependencies[i] = graph.m_nodes[i].m_dependencyCount;
+	}
+	for (size_t i = 0; i < graph.m_nodes.size(); ++i)
+	{
+		if (graph.m_nodes[i].m_dependencyCount == 0)
+		{
+			Schedule(graph, i, phase, frameDuration);
+		}
+	}
+
+	while (m_completedCount < graph.m_nodes.size())
+	{
+		// Help with the pool's work until something needs the main thread
+		m_pool.waitUntil([this, &graph]() {
+			return m_mainThreadReady || m_completedCount == graph.m_nodes.size();
+		});
+		RunMainThreadNodes(graph, phase, frameDuration);
+	}
+}
+
+void SystemScheduler::Schedule(PhaseGraph& graph, size_t nodeIndex, GameLoopPhase phase, timeuS frameDuration)
+{
+	if (graph.m_nodes[nodeIndex].m_flags & SystemAccessFlags::MAIN_THREAD)
+	{
+		std::lock_guard mainThreadLock(m_mainThreadMutex);
+		m_mainThreadNodes.push_back(nodeIndex);
+		m_mainThreadReady = true;
+		return;
+	}
+	m_pool.submit([this, &graph, nodeIndex, phase, frameDuration]() {
+		RunNode(graph, nodeIndex, phase, frameDuration);
+	});
+}
+
+void SystemScheduler::RunNode(PhaseGraph& graph, size_t nodeIndex, GameLoopPhase phase, timeuS frameDuration)
+{
+	auto& node = graph.m_nodes[nodeIndex];
+	{
+		// Nodes are only added during registration, so the name stays put for the profiler
+		Profiler::ScopedZone zone(node.m_zoneName.c_str(), "system");
+		node.m_system->Operate(phase, frameDuration);
+	}
+	if (node.m_flags & SystemAccessFlags::STRUCTURAL)
+	{
+		// Nothing else is running during a structural system,
+		// so tidy up the lists it changed before the systems waiting on it start
+		m_managerRef.prepareConcurrentQueries();
+	}
+	for (auto&& dependent : node.m_dependents)
+	{
+		if (--graph.m_remainingDependencies[dependent] == 0)
+		{
+			Schedule(graph, dependent, phase, frameDuration);
+		}
+	}
+	++m_completedCount;
+}
+
+void SystemScheduler::RunMainThreadNodes(PhaseGraph& graph, GameLoopPhase phase, timeuS frameDuration)
+{
+	std::vector<size_t> readyNodes;
+	{
+		std::lock_guard mainThreadLock(m_mainThreadMutex);
+		readyNodes.swap(m_mainThreadNodes);
+		m_mainThreadReady = false;
+	}
+	for (auto&& nodeIndex : readyNodes)
+	{
+		RunNode(graph, nodeIndex, phase, frameDuration);
+	}
+}
@@ -0,0 +1,130 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// ECS/SystemScheduler.h
+// Runs the systems of each game loop phase on the thread pool
+// Systems whose declared accesses conflict keep their registration order,
+// the others run side by side
+
+#pragma once
+
+#include "../Core/typedef.h"
+#include "ECS.h"
+#include "System.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+template <typename SystemType, typename = void>
+struct SystemAccessOf
+{
+	using type = UndeclaredSystemAccess;
+};
+
+template <typename SystemType>
+struct SystemAccessOf<SystemType, std::void_t<typename SystemType::Access>>
+{
+	using type = typename SystemType::Access;
+};
+
+class SystemScheduler
+{
+public:
+	using AccessBitset = ECS_Core::MasterSettings::Bitset;
+
+	SystemScheduler(ECS_Core::Manager& manager, ecs::ThreadPool& pool = ecs::ThreadPool::global());
+
+	// Adds the system after every system registered so far
+	template <typename SystemType>
+	void Register(SystemBase& system)
+	{
+		auto systemName = SystemName(typeid(SystemType).name());
+		ecs::MPL::forTypes<typename SystemAccessOf<SystemType>::type>([this, &system, &systemName](auto t) {
+			using Phase = typename decltype(t)::type;
+			AddNode(
+				Phase::c_phase,
+				system,
+				systemName,
+				Phase::c_flags,
+				ToBitset<typename Phase::ReadList>(),
+				ToBitset<typename Phase::WriteList>());
+		});
+	}
+
+	// Runs every system registered for the phase, and returns once all of them are done
+	void RunPhase(GameLoopPhase phase, const timeuS& frameDuration);
+
+protected:
+	struct SystemNode
+	{
+		SystemBase* m_system{ nullptr };
+		// "System PHASE", the profiler zone around the system's Operate
+		std::string m_zoneName;
+		u8 m_flags{ SystemAccessFlags::NONE };
+		AccessBitset m_reads;
+		AccessBitset m_writes;
+
+		// Later systems which have to wait for this one
+		std::vector<size_t> m_dependents;
+		u32 m_dependencyCount{ 0 };
+	};
+
+	struct PhaseGraph
+	{
+		std::vector<SystemNode> m_nodes;
+		std::unique_ptr<std::atomic<u32>[]> m_remainingDependencies;
+	};
+
+	template <typename TypeList>
+	static AccessBitset ToBitset()
+	{
+		AccessBitset bits;
+		ecs::MPL::forTypes<TypeList>([&bits](auto t) {
+			using T = typename decltype(t)::type;
+			if constexpr (ECS_Core::MasterSettings::isComponent<T>())
+			{
+				bits[ECS_Core::MasterSettings::componentBit<T>()] = true;
+			}
+			else
+			{
+				static_assert(ECS_Core::MasterSettings::isTag<T>(), "System accesses must be components or tags");
+				bits[ECS_Core::MasterSettings::tagBit<T>()] = true;
+			}
+		});
+		return bits;
+	}
+
+	static bool Conflicts(const SystemNode& earlier, const SystemNode& later);
+	static std::string SystemName(const char* typeName);
+
+	void AddNode(
+		GameLoopPhase phase,
+		SystemBase& system,
+		const std::string& systemName,
+		u8 flags,
+		const AccessBitset& reads,
+		const AccessBitset& writes);
+	void Schedule(PhaseGraph& graph, size_t nodeIndex, GameLoopPhase phase, timeuS frameDuration);
+	void RunNode(PhaseGraph& graph, size_t nodeIndex, GameLoopPhase phase, timeuS frameDuration);
+	void RunMainThreadNodes(PhaseGraph& graph, GameLoopPhase phase, timeuS frameDuration);
+
+	ECS_Core::Manager& m_managerRef;
+	ecs::ThreadPool& m_pool;
+	std::map<GameLoopPhase, PhaseGraph> m_phases;
+
+	std::atomic<size_t> m_completedCount{ 0 };
+
+	// Systems which became ready to run, but have to run on the main thread
+	std::mutex m_mainThreadMutex;
+	std::vector<size_t> m_mainThreadNodes;
+	std::atomic<bool> m_mainThreadReady{ false };
+};
@@ -0,0 +1,205 @@
+//
+// Persistent work-stealing thread pool used for parallel iteration over entities
+//
+// Every worker owns a deque of tasks. Workers pop their own newest task first,
+// and steal the oldest task of another worker when they run dry.
+// Threads that wait on work they submitted (parallelFor) execute queued tasks
+// while waiting, so nested parallel calls can't deadlock the pool.
+//
+
+#ifndef ecs_threadpool_hpp
+#define ecs_threadpool_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+    class ThreadPool {
+
+        public:
+            explicit ThreadPool(std::size_t mWorkerCount = defaultWorkerCount()) {
+                mWorkerCount = std::max<std::size_t>(1, mWorkerCount);
+                for (auto i(0u); i < mWorkerCount; ++i) {
+                    queues.emplace_back(std::make_unique<Queue>());
+                }
+                for (auto i(0u); i < mWorkerCount; ++i) {
+                    workers.emplace_back([this, i]() { workerLoop(i); });
+                }
+            }
+
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            // Shared pool for the whole program, one worker per hardware thread besides the caller
+            static ThreadPool& global() {
+                static ThreadPool pool;
+                return pool;
+            }
+
+            static std::size_t defaultWorkerCount() noexcept {
+                auto hardwareThreads(std::thread::hardware_concurrency());
+                return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+            }
+
+            auto getWorkerCount() const noexcept { return workers.size(); }
+
+            // True on this pool's own workers, which should wait with waitUntil rather than block
+            bool isWorkerThread() const noexcept { return workerPool() == this; }
+
+            // Queues mFunction and returns a future for its result
+            template <typename TF>
+            auto submit(TF&& mFunction) {
+                using Result = std::invoke_result_t<std::decay_t<TF>>;
+                auto task(std::make_shared<std::packaged_task<Result()>>(std::forward<TF>(mFunction)));
+                auto future(task->get_future());
+                push([task]() { (*task)(); });
+                return future;
+            }
+
+            // Splits [0, mCount) into ranges of at most mGrain elements and calls mFunction(begin, end) for each.
+            // Returns once every range has been processed; the calling thread works on ranges too.
+            template <typename TF>
+            void parallelFor(std::size_t mCount, std::size_t mGrain, TF&& mFunction) {
+                if (mCount == 0) return;
+                mGrain = std::max<std::size_t>(1, mGrain);
+                if (mCount <= mGrain) {
+                    mFunction(std::size_t(0), mCount);
+                    return;
+                }
+
+                const auto rangeCount((mCount + mGrain - 1) / mGrain);
+                std::atomic<std::size_t> remaining(rangeCount);
+                // The first range is kept for the calling thread
+                for (auto range(1u); range < rangeCount; ++range) {
+                    const auto begin(range * mGrain);
+                    const auto end(std::min(mCount, begin + mGrain));
+                    push([&mFunction, &remaining, begin, end]() {
+                        mFunction(begin, end);
+                        remaining.fetch_sub(1, std::memory_order_release);
+                    });
+                }
+
+                mFunction(std::size_t(0), std::min(mCount, mGrain));
+                remaining.fetch_sub(1, std::memory_order_release);
+
+                waitUntil([&remaining]() { return remaining.load(std::memory_order_acquire) == 0; });
+            }
+
+            // Runs queued tasks on the calling thread until mDone returns true
+            template <typename TF>
+            void waitUntil(TF&& mDone) {
+                while (!mDone()) {
+                    if (!runOne(currentQueue())) std::this_thread::yield();
+                }
+            }
+
+        private:
+            using Task = std::function<void()>;
+
+            struct Queue {
+                std::mutex mutex;
+                std::deque<Task> tasks;
+            };
+
+            std::vector<std::unique_ptr<Queue>> queues;
+            std::vector<std::thread> workers;
+
+            std::mutex sleepMutex;
+            std::condition_variable wake;
+            std::atomic<std::size_t> pending{0};
+            std::atomic<std::size_t> nextQueue{0};
+            bool stopping{false};
+
+            // Queue index of the current thread if it is one of this pool's workers
+            static std::size_t& workerIndex() noexcept {
+                static thread_local std::size_t index{static_cast<std::size_t>(-1)};
+                return index;
+            }
+
+            static ThreadPool*& workerPool() noexcept {
+                static thread_local ThreadPool* pool{nullptr};
+                return pool;
+            }
+
+            std::size_t currentQueue() noexcept {
+                if (workerPool() == this) return workerIndex();
+                return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            }
+
+            void push(Task&& mTask) {
+                auto& queue(*queues[currentQueue()]);
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back(std::move(mTask));
+                }
+                {
+                    // Taking the lock orders this against a worker checking pending before it sleeps
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    ++pending;
+                }
+                wake.notify_one();
+            }
+
+            bool tryPop(std::size_t mQueue, bool mSteal, Task& mTask) {
+                auto& queue(*queues[mQueue]);
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) return false;
+                if (mSteal) {
+                    mTask = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                else {
+                    mTask = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                --pending;
+                return true;
+            }
+
+            bool runOne(std::size_t mHome) {
+                Task task;
+                bool found(tryPop(mHome, false, task));
+                for (auto offset(1u); !found && offset < queues.size(); ++offset) {
+                    found = tryPop((mHome + offset) % queues.size(), true, task);
+                }
+                if (!found) return false;
+                task();
+                return true;
+            }
+
+            void workerLoop(std::size_t mIndex) {
+                workerIndex() = mIndex;
+                workerPool() = this;
+                while (true) {
+                    if (runOne(mIndex)) continue;
+
+                    std::unique_lock<std::mutex> lock(sleepMutex);
+                    wake.wait(lock, [this]() { return stopping || pending > 0; });
+                    if (stopping) return;
+                }
+            }
+    };
+}
+
+#endif /* ecs_threadpool_hpp */
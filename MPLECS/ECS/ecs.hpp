@@ -15,12 +15,21 @@
 #ifndef ecs_ecs_hpp
 #define ecs_ecs_hpp
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <bitset>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "./MPL/MPL.hpp"
+#include "./ThreadPool.hpp"
 
 // In this segment we'll implement the simple shoot'em'up game using
 // our new component-based entity system.
@@ -61,6 +70,8 @@ namespace ecs {
             HandleDataIndex handleDataIndex;
             Bitset bitset;
             bool alive;
+            // Whether this entity is recorded in the per-signature member lists
+            bool listed;
         };
 
         struct HandleData {
@@ -95,6 +106,8 @@ namespace ecs {
         class ComponentStorage {
 
             public:
+                static constexpr bool chunked = false;
+
                 void grow(std::size_t mNewCapacity) {
                     Utils::forTuple(
                         [this, mNewCapacity](auto& v) {
@@ -109,6 +122,34 @@ namespace ecs {
                     return std::get<std::vector<T>>(vectors)[mI];
                 }
 
+                template <typename T, typename... TArgs>
+                auto& addComponent(EntityIndex, DataIndex mI, TArgs&&... mXs) noexcept {
+                    auto& c(getComponent<T>(mI));
+                    new(&c) T(MPL_FWD(mXs)...);
+                    //new(&c) T(::std::forward<decltype(mXs)...>(mXs)...);
+
+                    return c;
+                }
+
+                template <typename T>
+                void delComponent(DataIndex mI) noexcept {
+                    getComponent<T>(mI).~T();
+                }
+
+                template <typename TBitset>
+                void destroyComponents(DataIndex mI, const TBitset& mBitset) noexcept {
+                    MPL::forTypes<ComponentList>([this, mI, &mBitset](auto t) {
+                        using T = typename decltype(t)::type;
+                        if (mBitset[Settings::template componentBit<T>()])
+                        {
+                            this->getComponent<T>(mI).~T();
+                        }
+                    });
+                }
+
+                void relocate(DataIndex, EntityIndex) noexcept {}
+                void clear() noexcept {}
+
             private:
                 using Settings = TSettings;
                 using ComponentList = typename Settings::ComponentList;
@@ -119,6 +160,292 @@ namespace ecs {
                 MPL::Rename<TupleOfVectors, ComponentList> vectors;
         };
 
+        // Groups entities by their exact component set ("archetype").
+        // Each archetype owns fixed-size chunks holding one dense array per component,
+        // so entities only pay for the components they actually have
+        // and iteration over a signature only touches archetypes that contain it.
+        // Adding or removing a component moves the entity to another archetype,
+        // which invalidates references to that entity's components
+        // (and to the entity that is swapped into its old row).
+        template <typename TSettings>
+        class ArchetypeComponentStorage {
+
+            public:
+                using Settings = TSettings;
+                using Bitset = typename Settings::Bitset;
+
+                static constexpr bool chunked = true;
+                static constexpr std::size_t chunkBytes = 16 * 1024;
+
+                ArchetypeComponentStorage() noexcept {
+                    for (auto i(0u); i < Settings::componentCount(); ++i) {
+                        componentBits[i] = true;
+                    }
+                }
+
+                ~ArchetypeComponentStorage() { clear(); }
+
+                void grow(std::size_t mNewCapacity) {
+                    locations.resize(mNewCapacity);
+                }
+
+                template <typename T>
+                auto& getComponent(DataIndex mI) noexcept {
+                    const auto& l(locations[mI]);
+                    assert(l.archetype != npos);
+                    return *componentPtr<T>(archetypes[l.archetype], l.row);
+                }
+
+                template <typename T, typename... TArgs>
+                auto& addComponent(EntityIndex mE, DataIndex mI, TArgs&&... mXs) {
+                    constexpr auto bit(Settings::template componentBit<T>());
+                    auto& l(locations[mI]);
+
+                    if (l.archetype != npos && archetypes[l.archetype].mask[bit]) {
+                        auto c(componentPtr<T>(archetypes[l.archetype], l.row));
+                        c->~T();
+                        new(c) T(MPL_FWD(mXs)...);
+                        return *c;
+                    }
+
+                    // Built before the move, as the arguments may refer to the entity's current components
+                    T value(MPL_FWD(mXs)...);
+                    auto mask(l.archetype == npos ? Bitset{} : archetypes[l.archetype].mask);
+                    mask[bit] = true;
+                    migrate(mE, mI, mask);
+
+                    auto c(componentPtr<T>(archetypes[l.archetype], l.row));
+                    new(c) T(std::move(value));
+                    return *c;
+                }
+
+                template <typename T>
+                void delComponent(DataIndex mI) {
+                    constexpr auto bit(Settings::template componentBit<T>());
+                    const auto& l(locations[mI]);
+                    if (l.archetype == npos || !archetypes[l.archetype].mask[bit]) return;
+
+                    auto mask(archetypes[l.archetype].mask);
+                    mask[bit] = false;
+                    migrate(rowHeader(archetypes[l.archetype], l.row).entityIndex, mI, mask);
+                }
+
+                template <typename TBitset>
+                void destroyComponents(DataIndex mI, const TBitset&) noexcept {
+                    auto& l(locations[mI]);
+                    if (l.archetype == npos) return;
+
+                    auto& a(archetypes[l.archetype]);
+                    forComponentsIn(a.mask, [this, &a, &l](auto t) {
+                        using T = typename decltype(t)::type;
+                        componentPtr<T>(a, l.row)->~T();
+                    });
+                    removeRow(l.archetype, l.row);
+                    l = Location{};
+                }
+
+                // Called when the entity owning mI has been moved to a new EntityIndex
+                void relocate(DataIndex mI, EntityIndex mE) noexcept {
+                    const auto& l(locations[mI]);
+                    if (l.archetype == npos) return;
+                    rowHeader(archetypes[l.archetype], l.row).entityIndex = mE;
+                }
+
+                void clear() noexcept {
+                    for (auto a(0u); a < archetypes.size(); ++a) {
+                        auto& arch(archetypes[a]);
+                        for (auto row(0u); row < arch.count; ++row) {
+                            forComponentsIn(arch.mask, [this, &arch, row](auto t) {
+                                using T = typename decltype(t)::type;
+                                componentPtr<T>(arch, row)->~T();
+                            });
+                        }
+                    }
+                    archetypes.clear();
+                    archetypeLookup.clear();
+                    for (auto& l : locations) l = Location{};
+                }
+
+                // Visits every row whose archetype contains all of the components in mRequired.
+                // Rows are walked back to front within each archetype, so the visited entity
+                // may freely change its own component set; rows created during the walk are skipped.
+                template <typename... Ts, typename TF>
+                IterationBehavior forRowsMatching(const Bitset& mRequired, TF&& mFunction) {
+                    const auto required(mRequired & componentBits);
+                    const auto stamp(rowStamp);
+
+                    for (std::size_t a(0), aEnd(archetypes.size()); a < aEnd; ++a) {
+                        if ((archetypes[a].mask & required) != required) continue;
+
+                        for (auto row(archetypes[a].count); row-- > 0;) {
+                            auto& arch(archetypes[a]);
+                            if (row >= arch.count) continue;
+
+                            const auto& header(rowHeader(arch, row));
+                            if (header.stamp > stamp) continue;
+
+                            if (mFunction(header.entityIndex, *componentPtr<Ts>(arch, row)...) == IterationBehavior::BREAK) {
+                                return IterationBehavior::BREAK;
+                            }
+                        }
+                    }
+                    return IterationBehavior::CONTINUE;
+                }
+
+                auto getArchetypeCount() const noexcept { return archetypes.size(); }
+
+            private:
+                using ComponentList = typename Settings::ComponentList;
+
+                static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
+                struct RowHeader {
+                    DataIndex dataIndex;
+                    EntityIndex entityIndex;
+                    std::uint64_t stamp;
+                };
+
+                struct Archetype {
+                    Bitset mask;
+                    std::size_t chunkShift{ 0 };
+                    std::size_t chunkBytesUsed{ 0 };
+                    std::array<std::size_t, Settings::componentCount()> offsets;
+                    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+                    std::size_t count{ 0 };
+                };
+
+                struct Location {
+                    std::size_t archetype{ npos };
+                    std::size_t row{ 0 };
+                };
+
+                Bitset componentBits;
+                std::vector<Archetype> archetypes;
+                std::unordered_map<Bitset, std::size_t> archetypeLookup;
+                std::vector<Location> locations;
+                std::uint64_t rowStamp{ 0 };
+
+                template <typename TF>
+                static void forComponentsIn(const Bitset& mMask, TF&& mFunction) {
+                    MPL::forTypes<ComponentList>([&mMask, &mFunction](auto t) {
+                        if (mMask[Settings::template componentBit<typename decltype(t)::type>()])
+                        {
+                            mFunction(t);
+                        }
+                    });
+                }
+
+                static unsigned char* chunkFor(Archetype& mA, std::size_t mRow) noexcept {
+                    return mA.chunks[mRow >> mA.chunkShift].get();
+                }
+
+                static std::size_t slotFor(const Archetype& mA, std::size_t mRow) noexcept {
+                    return mRow & ((std::size_t(1) << mA.chunkShift) - 1);
+                }
+
+                static RowHeader& rowHeader(Archetype& mA, std::size_t mRow) noexcept {
+                    return reinterpret_cast<RowHeader*>(chunkFor(mA, mRow))[slotFor(mA, mRow)];
+                }
+
+                template <typename T>
+                static T* componentPtr(Archetype& mA, std::size_t mRow) noexcept {
+                    const auto offset(mA.offsets[Settings::template componentID<T>()]);
+                    assert(offset != npos);
+                    return reinterpret_cast<T*>(chunkFor(mA, mRow) + offset) + slotFor(mA, mRow);
+                }
+
+                static std::size_t alignUp(std::size_t mOffset, std::size_t mAlignment) noexcept {
+                    return (mOffset + mAlignment - 1) / mAlignment * mAlignment;
+                }
+
+                // Lays out one chunk: the row headers, then one array per component.
+                // Rows per chunk is the largest power of two that fits in chunkBytes (at least 1).
+                static std::size_t layoutChunk(Archetype& mA, std::size_t mRows) {
+                    auto offset(mRows * sizeof(RowHeader));
+                    mA.offsets.fill(npos);
+                    forComponentsIn(mA.mask, [&mA, &offset, mRows](auto t) {
+                        using T = typename decltype(t)::type;
+                        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned components are not supported");
+                        offset = alignUp(offset, alignof(T));
+                        mA.offsets[Settings::template componentID<T>()] = offset;
+                        offset += mRows * sizeof(T);
+                    });
+                    return offset;
+                }
+
+                std::size_t findOrCreateArchetype(const Bitset& mMask) {
+                    auto iter(archetypeLookup.find(mMask));
+                    if (iter != archetypeLookup.end()) return iter->second;
+
+                    Archetype a;
+                    a.mask = mMask;
+                    while (a.chunkShift < 16 && layoutChunk(a, std::size_t(2) << a.chunkShift) <= chunkBytes) {
+                        ++a.chunkShift;
+                    }
+                    a.chunkBytesUsed = layoutChunk(a, std::size_t(1) << a.chunkShift);
+
+                    archetypes.push_back(std::move(a));
+                    archetypeLookup[mMask] = archetypes.size() - 1;
+                    return archetypes.size() - 1;
+                }
+
+                std::size_t allocateRow(std::size_t mArchetype, EntityIndex mE, DataIndex mI) {
+                    auto& a(archetypes[mArchetype]);
+                    if (a.count == (a.chunks.size() << a.chunkShift)) {
+                        a.chunks.emplace_back(new unsigned char[a.chunkBytesUsed]);
+                    }
+                    auto row(a.count++);
+                    auto& header(rowHeader(a, row));
+                    header.dataIndex = mI;
+                    header.entityIndex = mE;
+                    header.stamp = ++rowStamp;
+                    return row;
+                }
+
+                // Fills the hole at mRow with the archetype's last row. Components at mRow must already be destroyed.
+                void removeRow(std::size_t mArchetype, std::size_t mRow) noexcept {
+                    auto& a(archetypes[mArchetype]);
+                    auto last(--a.count);
+                    if (mRow != last) {
+                        forComponentsIn(a.mask, [&a, mRow, last](auto t) {
+                            using T = typename decltype(t)::type;
+                            auto from(componentPtr<T>(a, last));
+                            new(componentPtr<T>(a, mRow)) T(std::move(*from));
+                            from->~T();
+                        });
+                        rowHeader(a, mRow) = rowHeader(a, last);
+                        locations[rowHeader(a, mRow).dataIndex].row = mRow;
+                    }
+                    // Keep at most one empty chunk around to avoid churn at chunk boundaries
+                    if (a.chunks.size() >= 2 && a.count + (std::size_t(2) << a.chunkShift) <= (a.chunks.size() << a.chunkShift)) {
+                        a.chunks.pop_back();
+                    }
+                }
+
+                void migrate(EntityIndex mE, DataIndex mI, const Bitset& mMask) {
+                    auto& l(locations[mI]);
+                    auto target(mMask.none() ? npos : findOrCreateArchetype(mMask));
+                    auto newRow(target == npos ? 0 : allocateRow(target, mE, mI));
+
+                    if (l.archetype != npos) {
+                        auto& from(archetypes[l.archetype]);
+                        forComponentsIn(from.mask, [this, &from, &l, &mMask, target, newRow](auto t) {
+                            using T = typename decltype(t)::type;
+                            auto src(componentPtr<T>(from, l.row));
+                            if (mMask[Settings::template componentBit<T>()])
+                            {
+                                new(componentPtr<T>(archetypes[target], newRow)) T(std::move(*src));
+                            }
+                            src->~T();
+                        });
+                        removeRow(l.archetype, l.row);
+                    }
+
+                    l.archetype = target;
+                    l.row = newRow;
+                }
+        };
+
         template <typename TSettings>
         struct SignatureBitsets {
 
@@ -193,16 +520,31 @@ namespace ecs {
         };
     }
 
-    template <typename TComponentList, typename TTagList, typename TSignatureList>
+    // Storage policies for Settings.
+    // ContiguousStorage keeps one vector per component type, sized to the entity capacity.
+    // ArchetypeStorage keeps entities with the same component set together in dense chunks.
+    struct ContiguousStorage {
+        template <typename TSettings>
+        using Storage = Impl::ComponentStorage<TSettings>;
+    };
+
+    struct ArchetypeStorage {
+        template <typename TSettings>
+        using Storage = Impl::ArchetypeComponentStorage<TSettings>;
+    };
+
+    template <typename TComponentList, typename TTagList, typename TSignatureList, typename TStoragePolicy = ContiguousStorage>
     struct Settings {
 
         using ComponentList = typename TComponentList::TypeList;
         using TagList = typename TTagList::TypeList;
         using SignatureList = typename TSignatureList::TypeList;
-        using ThisType = Settings<ComponentList, TagList, SignatureList>;
+        using StoragePolicy = TStoragePolicy;
+        using ThisType = Settings<ComponentList, TagList, SignatureList, StoragePolicy>;
 
         using SignatureBitsets = Impl::SignatureBitsets<ThisType>;
         using SignatureBitsetsStorage = Impl::SignatureBitsetsStorage<ThisType>;
+        using ComponentStorage = typename StoragePolicy::template Storage<ThisType>;
 
         template <typename T>
         static constexpr bool isComponent() noexcept {
@@ -262,6 +604,9 @@ namespace ecs {
         }
     };
 
+    template <typename TSettings>
+    class CommandBuffer;
+
     template <typename TSettings>
     class Manager {
 		using HandleData = Impl::HandleData;
@@ -305,7 +650,10 @@ namespace ecs {
             template <typename T>
             void addTag(EntityIndex mI) noexcept {
                 static_assert(Settings::template isTag<T>(), "");
-                getEntity(mI).bitset[Settings::template tagBit<T>()] = true;
+                auto& e(getEntity(mI));
+                const auto previous(e.bitset);
+                e.bitset[Settings::template tagBit<T>()] = true;
+                updateMembers(mI, previous);
             }
 
             template <typename T>
@@ -316,7 +664,10 @@ namespace ecs {
             template <typename T>
             void delTag(EntityIndex mI) noexcept {
                 static_assert(Settings::template isTag<T>(), "");
-                getEntity(mI).bitset[Settings::template tagBit<T>()] = false;
+                auto& e(getEntity(mI));
+                const auto previous(e.bitset);
+                e.bitset[Settings::template tagBit<T>()] = false;
+                updateMembers(mI, previous);
             }
 
             template <typename T>
@@ -340,13 +691,11 @@ namespace ecs {
                 static_assert(Settings::template isComponent<T>(), "Component not recognized: ");
 
                 auto& e(getEntity(mI));
+                const auto previous(e.bitset);
                 e.bitset[Settings::template componentBit<T>()] = true;
+                updateMembers(mI, previous);
 
-                auto& c(components.template getComponent<T>(e.dataIndex));
-                new(&c) T(MPL_FWD(mXs)...);
-                //new(&c) T(::std::forward<decltype(mXs)...>(mXs)...);
-
-                return c;
+                return components.template addComponent<T>(mI, e.dataIndex, MPL_FWD(mXs)...);
             }
 
             template <typename T, typename... TArgs>
@@ -370,8 +719,11 @@ namespace ecs {
 			template <typename T>
 			void delComponent(EntityIndex mI) noexcept {
 				static_assert(Settings::template isComponent<T>(), "");
-				getEntity(mI).bitset[Settings::template componentBit<T>()] = false;
-				components.template getComponent<T>(getEntity(mI).dataIndex).~T();
+				auto& e(getEntity(mI));
+				const auto previous(e.bitset);
+				e.bitset[Settings::template componentBit<T>()] = false;
+				updateMembers(mI, previous);
+				components.template delComponent<T>(e.dataIndex);
 			}
 
             template <typename T>
@@ -418,23 +770,53 @@ namespace ecs {
                     e.dataIndex = i;
                     e.bitset.reset();
                     e.alive = false;
+                    e.listed = false;
                     e.handleDataIndex = i;
 
                     hd.counter = 0;
                     hd.entityIndex = i;
                 }
 
+                for(auto& m : members) {
+                    m.entities.clear();
+                    m.holes = 0;
+                    m.sorted = true;
+                }
+                std::fill(memberSlots.begin(), memberSlots.end(), unlistedSlots());
+
+                components.clear();
                 size = sizeNext = 0;
+
+                std::lock_guard<std::mutex> lock(commandMutex);
+                submittedCommands.clear();
+            }
+
+            // Hands a recorded command buffer to the manager. Safe to call from any thread;
+            // the commands are played back, in submission order, at the start of the next refresh().
+            void submit(CommandBuffer<TSettings>&& mCommands) {
+                if(mCommands.empty()) return;
+                std::lock_guard<std::mutex> lock(commandMutex);
+                submittedCommands.emplace_back(std::move(mCommands));
             }
 
-            void refresh() noexcept {
+            // Not noexcept, replaying the submitted commands allocates and runs component constructors
+            void refresh() {
+
+                playbackCommands();
 
                 if(sizeNext == 0) {
                     size = 0;
                     return;
                 }
 
+                const auto previousSize(size);
                 size = sizeNext = refreshImpl();
+
+                // Entities created since the last refresh become visible to queries now.
+                // Those swapped into dead slots were already listed by refreshImpl.
+                for(EntityIndex i{previousSize}; i < size; ++i) {
+                    if(!entities[i].listed) listMembers(i);
+                }
             }
 
             template <typename T>
@@ -458,25 +840,88 @@ namespace ecs {
             void forEntitiesMatching(TF&& mFunction) {
                 static_assert(Settings::template isSignature<T>(), "");
 
-                forEntities([this, &mFunction](auto i) -> IterationBehavior{
-                    if(matchesSignature<T>(i)) return expandSignatureCall<T>(i, mFunction);
-					return IterationBehavior::CONTINUE;
+                using RequiredComponents = typename Settings::SignatureBitsets::template SignatureComponents<T>;
+                if constexpr (ComponentStorage::chunked && MPL::size<RequiredComponents>() > 0) {
+                    // Walk the chunks of matching archetypes instead of every entity
+                    using Helper = MPL::Rename<ExpandCallHelper, RequiredComponents>;
+                    Helper::template callChunked<T>(*this, mFunction);
+                }
+                else {
+                    // Only visit the signature's members.
+                    // Entities that stop matching mid-iteration leave a hole and are skipped,
+                    // entities that start matching are appended past the end and wait for the next query.
+                    constexpr auto signatureID(Settings::template signatureID<T>());
+                    auto& m(members[signatureID]);
+                    compactMembers(signatureID);
+
+                    ++m.iterating;
+                    for(std::size_t i(0), count(m.entities.size()); i < count; ++i) {
+                        EntityIndex mI(m.entities[i]);
+                        if(mI == unlistedEntity) continue;
+                        if(expandSignatureCall<T>(mI, mFunction) == IterationBehavior::BREAK) break;
+                    }
+                    --m.iterating;
+                }
+            }
+
+            // Runs mFunction for every entity matching the signature, spread over the thread pool in ranges of mGrain entities.
+            // mFunction is called concurrently, so it must be const-callable and may only modify the components it is handed;
+            // structural changes (components, tags, creating entities) are not allowed from inside it.
+            // Returning BREAK stops ranges that haven't started yet.
+            template <typename T, typename TF>
+            void parallelForEntitiesMatching(TF&& mFunction, std::size_t mGrain = 64, ThreadPool& mPool = ThreadPool::global()) {
+                static_assert(Settings::template isSignature<T>(), "");
+
+                using RequiredComponents = typename Settings::SignatureBitsets::template SignatureComponents<T>;
+                using Helper = MPL::Rename<ExpandCallHelper, RequiredComponents>;
+                static_assert(Helper::template isParallelCallable<TF>(),
+                    "parallelForEntitiesMatching needs a const-callable function taking (EntityIndex, the signature's components...)");
+
+                constexpr auto signatureID(Settings::template signatureID<T>());
+                auto& m(members[signatureID]);
+                compactMembers(signatureID);
+
+                ++m.iterating;
+                std::atomic<bool> stop(false);
+                const auto& function(mFunction);
+                mPool.parallelFor(m.entities.size(), mGrain, [this, &m, &stop, &function](std::size_t mBegin, std::size_t mEnd) {
+                    for(auto i(mBegin); i < mEnd; ++i) {
+                        if(stop.load(std::memory_order_relaxed)) return;
+                        EntityIndex mI(m.entities[i]);
+                        if(mI == unlistedEntity) continue;
+                        if(expandSignatureCall<T>(mI, function) == IterationBehavior::BREAK) {
+                            stop.store(true, std::memory_order_relaxed);
+                        }
+                    }
                 });
+                --m.iterating;
             }
-        
+
+            // Entities matching the signature, in index order.
+            // The list is owned by the manager and stays valid until the next structural change.
             template <typename T>
-            std::vector<EntityIndex> entitiesMatching() {
+            const std::vector<EntityIndex>& entitiesMatching() {
                 static_assert(Settings::template isSignature<T>(), "");
-                
-                std::vector<EntityIndex> res{};
 
-                for(EntityIndex i{0}; i < size; ++i) {
-                    if(matchesSignature<T>(i)) {
-                        res.emplace_back(i);
-                    }
+                constexpr auto signatureID(Settings::template signatureID<T>());
+                auto& m(members[signatureID]);
+                compactMembers(signatureID);
+                if(m.holes == 0) return m.entities;
+
+                // Called from inside an iteration over the same signature, so the list can't be compacted
+                m.snapshot.clear();
+                for(auto& mI : m.entities) {
+                    if(mI != unlistedEntity) m.snapshot.push_back(mI);
+                }
+                return m.snapshot;
+            }
+
+            // Compacts every signature's member list. Queries on compact lists only read them,
+            // so this has to run before querying from several threads at once.
+            void prepareConcurrentQueries() {
+                for(std::size_t i(0); i < Settings::signatureCount(); ++i) {
+                    compactMembers(i);
                 }
-                
-                return std::forward<std::vector<EntityIndex>>(res);
             }
 
             auto getEntityCount() const noexcept { return size; }
@@ -516,7 +961,7 @@ namespace ecs {
             using Entity = Impl::Entity<Settings>;
 
             using SignatureBitsetsStorage = Impl::SignatureBitsetsStorage<Settings>;
-            using ComponentStorage = Impl::ComponentStorage<Settings>;
+            using ComponentStorage = typename Settings::ComponentStorage;
 
             std::size_t capacity{0}, size{0}, sizeNext{0};
             std::vector<Entity> entities;
@@ -524,6 +969,29 @@ namespace ecs {
             ComponentStorage components;
             std::vector<HandleData> handleData;
 
+            // Per-signature lists of the visible entities matching each signature,
+            // kept up to date on every bitset change so queries don't scan every entity.
+            struct SignatureMembers {
+                std::vector<EntityIndex> entities;
+                std::vector<EntityIndex> snapshot;
+                std::size_t holes{0};
+                bool sorted{true};
+                // Atomic since systems scheduled side by side may iterate the same signature
+                std::atomic<int> iterating{0};
+            };
+            using MemberSlots = std::array<std::uint32_t, Settings::signatureCount()>;
+
+            static constexpr std::uint32_t unlistedSlot{static_cast<std::uint32_t>(-1)};
+            static constexpr std::size_t unlistedEntity{static_cast<std::size_t>(-1)};
+
+            std::mutex commandMutex;
+            std::vector<CommandBuffer<TSettings>> submittedCommands;
+            std::vector<CommandBuffer<TSettings>> playingCommands;
+
+            std::array<SignatureMembers, Settings::signatureCount()> members;
+            // Position of each entity in each member list, indexed by DataIndex
+            std::vector<MemberSlots> memberSlots;
+
             void growTo(std::size_t mNewCapacity) {
 
                 assert(mNewCapacity > capacity);
@@ -531,6 +999,7 @@ namespace ecs {
                 entities.resize(mNewCapacity);
                 components.grow(mNewCapacity);
                 handleData.resize(mNewCapacity);
+                memberSlots.resize(mNewCapacity, unlistedSlots());
 
                 for(auto i(capacity); i < mNewCapacity; ++i) {
                     auto& e(entities[i]);
@@ -539,6 +1008,7 @@ namespace ecs {
                     e.dataIndex = i;
                     e.bitset.reset();
                     e.alive = false;
+                    e.listed = false;
                     e.handleDataIndex = i;
 
                     h.counter = 0;
@@ -583,11 +1053,30 @@ namespace ecs {
 
             template <typename... Ts>
             struct ExpandCallHelper {
+                // Each component handed out belongs to the iterated entity and appears once,
+                // and the function itself can't mutate shared state through a mutable call operator
+                template <typename TF>
+                static constexpr bool isParallelCallable() noexcept {
+                    return MPL::Unique<Ts...>()
+                        && std::is_invocable_r_v<IterationBehavior, const std::decay_t<TF>&, EntityIndex, Ts&...>;
+                }
+
                 template <typename TF>
                 static IterationBehavior call(EntityIndex mI, ThisType& mMgr, TF&& mFunction) {
                     auto di(mMgr.getEntity(mI).dataIndex);
                     return mFunction(mI, mMgr.components.template getComponent<Ts>(di)...);
                 }
+
+                template <typename TSignature, typename TF>
+                static void callChunked(ThisType& mMgr, TF&& mFunction) {
+                    const auto& signatureBitset(mMgr.signatureBitsets.template getSignatureBitset<TSignature>());
+                    mMgr.components.template forRowsMatching<Ts...>(signatureBitset,
+                        [&mMgr, &mFunction](EntityIndex mI, Ts&... mXs) -> IterationBehavior {
+                        // Entities created since the last refresh aren't iterated yet, and tags aren't part of the archetype
+                        if (mI >= mMgr.size || !mMgr.template matchesSignature<TSignature>(mI)) return IterationBehavior::CONTINUE;
+                        return mFunction(mI, mXs...);
+                    });
+                }
             };
 
             template <typename T, typename TF>
@@ -603,6 +1092,120 @@ namespace ecs {
 
 
 
+            void playbackCommands() {
+                {
+                    std::lock_guard<std::mutex> lock(commandMutex);
+                    if(submittedCommands.empty()) return;
+                    std::swap(submittedCommands, playingCommands);
+                }
+                for(auto& commands : playingCommands) {
+                    commands.playback(*this);
+                }
+                playingCommands.clear();
+            }
+
+            static MemberSlots unlistedSlots() noexcept {
+                MemberSlots slots;
+                slots.fill(unlistedSlot);
+                return slots;
+            }
+
+            void addMember(std::size_t mSignature, EntityIndex mI) {
+                auto& m(members[mSignature]);
+                if(!m.entities.empty() && static_cast<std::size_t>(m.entities.back()) > mI) m.sorted = false;
+                memberSlots[getEntity(mI).dataIndex][mSignature] = static_cast<std::uint32_t>(m.entities.size());
+                m.entities.emplace_back(mI);
+            }
+
+            void removeMember(std::size_t mSignature, EntityIndex mI) noexcept {
+                auto& m(members[mSignature]);
+                auto& slot(memberSlots[getEntity(mI).dataIndex][mSignature]);
+                m.entities[slot] = unlistedEntity;
+                ++m.holes;
+                slot = unlistedSlot;
+            }
+
+            // Drops holes and restores index order, unless the list is being iterated
+            void compactMembers(std::size_t mSignature) {
+                auto& m(members[mSignature]);
+                if(m.iterating > 0 || (m.holes == 0 && m.sorted)) return;
+
+                if(m.holes > 0) {
+                    m.entities.erase(
+                        std::remove_if(m.entities.begin(), m.entities.end(),
+                            [](const EntityIndex& mI) { return static_cast<std::size_t>(mI) == unlistedEntity; }),
+                        m.entities.end());
+                    m.holes = 0;
+                }
+                if(!m.sorted) {
+                    std::sort(m.entities.begin(), m.entities.end(),
+                        [](const EntityIndex& mA, const EntityIndex& mB) {
+                            return static_cast<std::size_t>(mA) < static_cast<std::size_t>(mB);
+                        });
+                    m.sorted = true;
+                }
+                for(std::size_t i(0); i < m.entities.size(); ++i) {
+                    memberSlots[entities[m.entities[i]].dataIndex][mSignature] = static_cast<std::uint32_t>(i);
+                }
+            }
+
+            template <typename TF>
+            static void forSignatures(TF&& mFunction) {
+                MPL::forTypes<typename Settings::SignatureList>([&mFunction](auto t) {
+                    mFunction(t, Settings::template signatureID<typename decltype(t)::type>());
+                });
+            }
+
+            void updateMembers(EntityIndex mI, const Bitset& mPrevious) {
+                const auto& e(getEntity(mI));
+                if(!e.listed) return;
+
+                forSignatures([this, mI, &e, &mPrevious](auto t, std::size_t mSignature) {
+                    const auto& signatureBitset(signatureBitsets.template getSignatureBitset<typename decltype(t)::type>());
+                    const bool matched((signatureBitset & mPrevious) == signatureBitset);
+                    const bool matches((signatureBitset & e.bitset) == signatureBitset);
+                    if(matched == matches) return;
+                    if(matches) addMember(mSignature, mI);
+                    else removeMember(mSignature, mI);
+                });
+            }
+
+            void listMembers(EntityIndex mI) {
+                auto& e(getEntity(mI));
+                e.listed = true;
+                forSignatures([this, mI, &e](auto t, std::size_t mSignature) {
+                    const auto& signatureBitset(signatureBitsets.template getSignatureBitset<typename decltype(t)::type>());
+                    if((signatureBitset & e.bitset) == signatureBitset) addMember(mSignature, mI);
+                });
+            }
+
+            void unlistMembers(EntityIndex mI) noexcept {
+                auto& e(entities[mI]);
+                if(!e.listed) return;
+                e.listed = false;
+                for(std::size_t signature(0); signature < Settings::signatureCount(); ++signature) {
+                    if(memberSlots[e.dataIndex][signature] != unlistedSlot) removeMember(signature, mI);
+                }
+            }
+
+            // The listed entity now lives at mI
+            void relistMembers(EntityIndex mI) noexcept {
+                const auto& slots(memberSlots[entities[mI].dataIndex]);
+                for(std::size_t signature(0); signature < Settings::signatureCount(); ++signature) {
+                    if(slots[signature] == unlistedSlot) continue;
+                    members[signature].entities[slots[signature]] = mI;
+                    members[signature].sorted = false;
+                }
+            }
+
+            void destroyComponents(EntityIndex mI) noexcept {
+                auto& e(entities[mI]);
+                components.destroyComponents(e.dataIndex, e.bitset);
+                MPL::Impl::forTypes<typename Settings::ComponentList>([&e](auto t) {
+                    e.bitset[Settings::template componentBit<typename decltype(t)::type>()] = false;
+                });
+            }
+
             void invalidateHandle(EntityIndex mX) noexcept {
                 auto& hd(handleData[entities[mX].handleDataIndex]);
                 ++hd.counter;
@@ -623,15 +1226,16 @@ namespace ecs {
                         if(!entities[iD].alive) break;
                     }
 
-					MPL::Impl::forTypes<Settings::ComponentList>([this, iD](auto t) {
-						if (this->hasComponent<typename decltype(t)::type>(iD))
-						{
-							this->delComponent<typename decltype(t)::type>(iD);
-						}
-					});
+					unlistMembers(iD);
+					destroyComponents(iD);
 
                     for(; true; --iA) {
                         if(entities[iA].alive) break;
+                        unlistMembers(iA);
+                        if constexpr (ComponentStorage::chunked) {
+                            // Archetype rows must not outlive the entity slot, or it would be reused with stale components
+                            destroyComponents(iA);
+                        }
                         invalidateHandle(iA);
                         if(iA <= iD) return iD;
                     }
@@ -641,6 +1245,9 @@ namespace ecs {
 
                     std::swap(entities[iA], entities[iD]);
 
+                    components.relocate(entities[iD].dataIndex, iD);
+                    if(entities[iD].listed) relistMembers(iD);
+                    else listMembers(iD);
                     refreshHandle(iD);
 
                     invalidateHandle(iA);
@@ -653,6 +1260,121 @@ namespace ecs {
                 return iD;
             }
     };
+
+    // Records structural changes (create, add/remove component or tag, kill) to apply later.
+    // A buffer belongs to the thread filling it, so recording takes no locks; once filled it is
+    // handed over with Manager::submit and replayed on the main thread during Manager::refresh.
+    // Components are constructed when recorded and moved into the entity on playback.
+    template <typename TSettings>
+    class CommandBuffer {
+
+        public:
+            using Manager = ecs::Manager<TSettings>;
+            using Handle = Impl::Handle;
+
+            // An entity created by this buffer, which only gets a real handle on playback
+            struct Deferred {
+                std::size_t index;
+            };
+
+            auto create() {
+                Deferred entity{createdCount++};
+                record([](Manager& mMgr, std::vector<Handle>& mCreated) {
+                    mCreated.push_back(mMgr.createHandle());
+                });
+                return entity;
+            }
+
+            template <typename T, typename TEntity, typename... TArgs>
+            void addComponent(const TEntity& mEntity, TArgs&&... mXs) {
+                static_assert(TSettings::template isComponent<T>(), "");
+                record([mEntity, component = T(MPL_FWD(mXs)...)](Manager& mMgr, std::vector<Handle>& mCreated) mutable {
+                    if(auto handle = resolve(mMgr, mCreated, mEntity)) mMgr.template addComponent<T>(*handle, std::move(component));
+                });
+            }
+
+            template <typename T, typename TEntity>
+            void delComponent(const TEntity& mEntity) {
+                static_assert(TSettings::template isComponent<T>(), "");
+                record([mEntity](Manager& mMgr, std::vector<Handle>& mCreated) {
+                    auto handle(resolve(mMgr, mCreated, mEntity));
+                    if(handle && mMgr.template hasComponent<T>(*handle)) mMgr.template delComponent<T>(*handle);
+                });
+            }
+
+            template <typename T, typename TEntity>
+            void addTag(const TEntity& mEntity) {
+                static_assert(TSettings::template isTag<T>(), "");
+                record([mEntity](Manager& mMgr, std::vector<Handle>& mCreated) {
+                    if(auto handle = resolve(mMgr, mCreated, mEntity)) mMgr.template addTag<T>(*handle);
+                });
+            }
+
+            template <typename T, typename TEntity>
+            void delTag(const TEntity& mEntity) {
+                static_assert(TSettings::template isTag<T>(), "");
+                record([mEntity](Manager& mMgr, std::vector<Handle>& mCreated) {
+                    if(auto handle = resolve(mMgr, mCreated, mEntity)) mMgr.template delTag<T>(*handle);
+                });
+            }
+
+            template <typename TEntity>
+            void kill(const TEntity& mEntity) {
+                record([mEntity](Manager& mMgr, std::vector<Handle>& mCreated) {
+                    if(auto handle = resolve(mMgr, mCreated, mEntity)) mMgr.kill(*handle);
+                });
+            }
+
+            // Runs mFunction(Manager&, Handle) once the deferred entity exists, for wiring that needs the real handle
+            template <typename TF>
+            void onCreated(const Deferred& mEntity, TF&& mFunction) {
+                record([mEntity, function = std::forward<TF>(mFunction)](Manager& mMgr, std::vector<Handle>& mCreated) mutable {
+                    function(mMgr, mCreated[mEntity.index]);
+                });
+            }
+
+            bool empty() const noexcept { return commands.empty(); }
+
+            void playback(Manager& mMgr) {
+                std::vector<Handle> created;
+                created.reserve(createdCount);
+                for(auto& command : commands) {
+                    command->apply(mMgr, created);
+                }
+                commands.clear();
+                createdCount = 0;
+            }
+
+        private:
+            struct Command {
+                virtual ~Command() = default;
+                virtual void apply(Manager& mMgr, std::vector<Handle>& mCreated) = 0;
+            };
+
+            template <typename TF>
+            struct FunctionCommand : Command {
+                explicit FunctionCommand(TF&& mFunction) : function(std::move(mFunction)) {}
+                void apply(Manager& mMgr, std::vector<Handle>& mCreated) override { function(mMgr, mCreated); }
+                TF function;
+            };
+
+            std::vector<std::unique_ptr<Command>> commands;
+            std::size_t createdCount{0};
+
+            template <typename TF>
+            void record(TF&& mFunction) {
+                commands.emplace_back(std::make_unique<FunctionCommand<std::decay_t<TF>>>(std::forward<TF>(mFunction)));
+            }
+
+            static const Handle* resolve(Manager&, std::vector<Handle>& mCreated, const Deferred& mEntity) noexcept {
+                return &mCreated[mEntity.index];
+            }
+
+            // Entities that died before playback are skipped
+            static const Handle* resolve(Manager& mMgr, std::vector<Handle>&, const Handle& mEntity) noexcept {
+                return mMgr.isHandleValid(mEntity) ? &mEntity : nullptr;
+            }
+    };
 }
 
 #endif /* ecs_ecs_hpp */
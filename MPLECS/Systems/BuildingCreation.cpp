@@ -22,7 +22,7 @@ void BuildingCreation::AdvanceBuildingConstruction()
 {
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
@@ -58,10 +58,10 @@ void BuildingCreation::AdvanceBuildingConstruction()
 			if (!manager.hasComponent<ECS_Core::Components::C_Population>(mI))
 			{
 				auto& population = manager.addComponent<ECS_Core::Components::C_Population>(mI);
-				auto& foundingPopulation = population.m_populations[-12 * (time.m_year - 15) - time.m_month];
-				foundingPopulation.m_numMen = 25;
-				foundingPopulation.m_numWomen = 25;
-				foundingPopulation.m_class = ECS_Core::Components::PopulationClass::WORKERS;
+				auto foundingCohort = population.FindOrInsert(-12 * (time.m_year - 15) - time.m_month);
+				population.m_numMen[foundingCohort] = 25;
+				population.m_numWomen[foundingCohort] = 25;
+				population.m_class[foundingCohort] = ECS_Core::Components::PopulationClass::WORKERS;
 			}
 			auto& creatorRealm = manager.getComponent<ECS_Core::Components::C_Realm>(construction.m_placingGovernor);
 			creatorRealm.m_territories.insert(manager.getHandle(mI));
@@ -18,6 +18,10 @@
 class BuildingCreation : public SystemBase
 {
 public:
+	// Finishes buildings by adding and removing their components, so ACTION runs alone
+	using Access = SystemAccess<
+		StructuralPhase<GameLoopPhase::ACTION>>;
+
 	BuildingCreation() : SystemBase() { }
 	virtual ~BuildingCreation() {}
 	virtual void ProgramInit() override;
@@ -100,7 +100,7 @@ void CaravanTrade::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 			const Components::C_Population&,
 			Components::C_CaravanPath& path)
 		{
-			if (position.m_position == path.m_basePath.m_path.front().m_tile
+			if (position.m_position == path.m_basePath.m_path.Front()
 				&& path.m_isReturning)
 			{
 				// Trade with home base and turn around
@@ -116,13 +116,12 @@ void CaravanTrade::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				PerformTrade(inventory, baseInventory, TradeType::HIGHEST_AVAILABLE);
 
 				auto& moveToPoint = *mover.m_currentMovement;
-				std::reverse(moveToPoint.m_path.begin(), moveToPoint.m_path.end());
-				moveToPoint.m_currentPathIndex = 0;
+				moveToPoint.m_path.Reverse();
 				moveToPoint.m_currentMovementProgress = 0;
-				moveToPoint.m_targetPosition = moveToPoint.m_path.back().m_tile;
+				moveToPoint.m_targetPosition = moveToPoint.m_path.Back();
 				path.m_isReturning = false;
 			}
-			else if (position.m_position == path.m_basePath.m_path.back().m_tile
+			else if (position.m_position == path.m_basePath.m_path.Back()
 				&& !path.m_isReturning)
 			{
 				// Trade with target and turn around
@@ -139,10 +138,9 @@ void CaravanTrade::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					TradeType::PREFER_EXCHANGE);
 				
 				auto& moveToPoint = *mover.m_currentMovement;
-				std::reverse(moveToPoint.m_path.begin(), moveToPoint.m_path.end());
-				moveToPoint.m_currentPathIndex = 0;
+				moveToPoint.m_path.Reverse();
 				moveToPoint.m_currentMovementProgress = 0;
-				moveToPoint.m_targetPosition = moveToPoint.m_path.back().m_tile;
+				moveToPoint.m_targetPosition = moveToPoint.m_path.Back();
 				path.m_isReturning = true;
 			}
 			return ecs::IterationBehavior::CONTINUE;
@@ -19,6 +19,12 @@ enum class TradeType
 class CaravanTrade : public SystemBase
 {
 public:
+	// Trades a caravan's cargo and turns it around at either end of its route
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::ACTION_RESPONSE,
+			Reads<ECS_Core::Components::C_TilePosition, ECS_Core::Components::C_Population>,
+			Writes<ECS_Core::Components::C_MovingUnit, ECS_Core::Components::C_ResourceInventory, ECS_Core::Components::C_CaravanPath>>>;
+
 	CaravanTrade() : SystemBase() { }
 	virtual ~CaravanTrade() {}
 	virtual void ProgramInit() override;
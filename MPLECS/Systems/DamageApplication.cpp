@@ -43,7 +43,7 @@ void DamageApplication::TakeDamage()
 {
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
@@ -12,6 +12,15 @@
 class DamageApplication : public SystemBase
 {
 public:
+	// Applies pending damage and healing, then clears what was pending in CLEANUP
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::ACTION_RESPONSE,
+			Reads<ECS_Core::Components::C_TimeTracker>,
+			Writes<ECS_Core::Components::C_Health, ECS_Core::Components::C_Healable, ECS_Core::Components::C_Damageable>>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<>,
+			Writes<ECS_Core::Components::C_Health, ECS_Core::Components::C_Healable, ECS_Core::Components::C_Damageable>>>;
+
 	DamageApplication() : SystemBase() { }
 	virtual ~DamageApplication() {}
 	virtual void ProgramInit() override;
@@ -17,7 +17,7 @@ void Education::TeachChildren()
 {
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
@@ -35,11 +35,12 @@ void Education::TeachChildren()
 		using namespace ECS_Core::Components;
 		struct ElderReference
 		{
-			ElderReference(s64 birthMonth, PopulationSegment* segment)
-				: m_birthMonth(birthMonth)
-				, m_pop(segment)
+			ElderReference(const C_Population& population, size_t cohort)
+				: m_birthMonth(population.m_keys[cohort].m_birthMonthIndex)
+				, m_cohort(cohort)
+				, m_count(population.m_numMen[cohort] + population.m_numWomen[cohort])
 			{
-				for (auto&&[skill, experience] : m_pop->m_specialties)
+				population.ForEachSpecialty(cohort, [this](SpecialtyId, const SpecialtyProgress& experience)
 				{
 					// TODO: Read total XP thresholds instead of calculating
 					// Sum(i^2) from 1 to n = 
@@ -48,21 +49,22 @@ void Education::TeachChildren()
 						* (2 * experience.m_level + 1) * 10000 / 6;
 					totalSkillXP += experience.m_experience;
 					m_totalXp += totalSkillXP;
-				}
+				});
 			}
 			s64 m_birthMonth;
-			PopulationSegment* m_pop;
+			size_t m_cohort;
+			s32 m_count;
 			f64 m_totalXp{ 0 };
 		};
 
 		std::vector<ElderReference> elders;
-		for (auto&&[birthMonth, elderPop] : population.m_populations)
+		for (size_t cohort = 0; cohort < population.Size(); ++cohort)
 		{
-			if (elderPop.m_class != PopulationClass::ELDERS)
+			if (population.m_class[cohort] != PopulationClass::ELDERS)
 			{
 				continue;
 			}
-			elders.emplace_back(birthMonth.m_birthMonthIndex, &elderPop);
+			elders.emplace_back(population, cohort);
 		}
 
 		std::sort(elders.begin(), elders.end(),
@@ -83,18 +85,19 @@ void Education::TeachChildren()
 			return ecs::IterationBehavior::CONTINUE;
 		}
 		auto elderIter = elders.begin();
-		auto remainingTeachCount = 5 * (elderIter->m_pop->m_numMen + elderIter->m_pop->m_numWomen);
-		for (auto&&[birthMonth, childPop] : reverse(population.m_populations))
+		auto remainingTeachCount = 5 * elderIter->m_count;
+		// Eldest children first
+		for (size_t childCohort = population.Size(); childCohort-- > 0;)
 		{
 			if (elderIter == elders.end())
 			{
 				break;
 			}
-			if (childPop.m_class != PopulationClass::CHILDREN)
+			if (population.m_class[childCohort] != PopulationClass::CHILDREN)
 			{
 				continue;
 			}
-			auto childrenRemaining = childPop.m_numMen + childPop.m_numWomen;
+			auto childrenRemaining = population.m_numMen[childCohort] + population.m_numWomen[childCohort];
 			while (childrenRemaining > 0 && elderIter != elders.end())
 			{
 				auto usedTeachCount = min(remainingTeachCount,
@@ -103,14 +106,16 @@ void Education::TeachChildren()
 				childrenRemaining -= usedTeachCount;
 				remainingTeachCount -= usedTeachCount;
 
-				for (auto&&[skill, experience] : elderIter->m_pop->m_specialties)
+				population.ForEachSpecialty(elderIter->m_cohort, [&population, childCohort, &time](
+					SpecialtyId skill,
+					const SpecialtyProgress& experience)
 				{
 					if (experience.m_level == 1
 						&& experience.m_experience == 0)
 					{
-						continue;
+						return;
 					}
-					auto& childExperience = childPop.m_specialties[skill];
+					auto& childExperience = population.Specialty(childCohort, skill);
 					if (childExperience.m_level < experience.m_level)
 					{
 						// Learning normally
@@ -124,7 +129,7 @@ void Education::TeachChildren()
 						childExperience.m_experience += time.m_frameDuration /
 							(2 + childExperience.m_level - experience.m_level);
 					}
-				}
+				});
 
 				if ((remainingTeachCount) <= 0)
 				{
@@ -134,8 +139,7 @@ void Education::TeachChildren()
 					}
 					else
 					{
-						remainingTeachCount = 5 * (elderIter->m_pop->m_numMen
-							+ elderIter->m_pop->m_numWomen);
+						remainingTeachCount = 5 * elderIter->m_count;
 					}
 				}
 			}
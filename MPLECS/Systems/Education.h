@@ -12,6 +12,12 @@
 class Education : public SystemBase
 {
 public:
+	// Elders teach their specialties to the children of the same population
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::ACTION,
+			Reads<ECS_Core::Components::C_TimeTracker, ECS_Core::Components::C_ResourceInventory>,
+			Writes<ECS_Core::Components::C_Population>>>;
+
 	Education() : SystemBase() { }
 	virtual ~Education() {}
 	virtual void ProgramInit() override;
@@ -50,134 +50,155 @@ void Government::GainIncomes()
 {
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
 	}
 	const auto& time = m_managerRef.getComponent<ECS_Core::Components::C_TimeTracker>(timeEntities.front());
+	// Territories are worked according to the agenda of the realm that owns them
+	m_territoryAgendas.assign(m_managerRef.getEntityCount(), nullptr);
 	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_Governor>(
-		[&manager = m_managerRef, &time, this](
+		[&manager = m_managerRef, this](
 			ecs::EntityIndex mI,
-			ECS_Core::Components::C_Realm& realm,
+			const ECS_Core::Components::C_Realm& realm,
 			const ECS_Core::Components::C_Agenda& agenda)
 	{
 		for (auto&& territoryHandle : realm.m_territories)
 		{
-			if (!manager.isHandleValid(territoryHandle)
-				|| !manager.hasComponent<ECS_Core::Components::C_TileProductionPotential>(territoryHandle)
-				|| !manager.hasComponent<ECS_Core::Components::C_Territory>(territoryHandle)
-				|| !manager.hasComponent<ECS_Core::Components::C_Population>(territoryHandle)
-				|| !manager.hasComponent<ECS_Core::Components::C_ResourceInventory>(territoryHandle))
+			if (!manager.isHandleValid(territoryHandle))
 			{
 				continue;
 			}
-			WorkerAssignmentMap assignments;
-
-			SkillMap skillMap;
-
-			auto& territoryYield = manager.getComponent<ECS_Core::Components::C_TileProductionPotential>(territoryHandle);
-			auto& territory = manager.getComponent<ECS_Core::Components::C_Territory>(territoryHandle);
-			auto& population = manager.getComponent<ECS_Core::Components::C_Population>(territoryHandle);
-			auto& inventory = manager.getComponent<ECS_Core::Components::C_ResourceInventory>(territoryHandle);
-
-			// Choose which yields will be worked based on government priorities
-			// If production is the focus, highest skill works first
-			// If training is the focus, lowest skill works first
-			// After yields are determined, increase experience for the workers
-			// Experience advances more slowly for higher skill
-			f64 totalWorkerCount{ 0 };
-			f64 totalSubsistenceCount{ 0 };
-			for (auto&&[birthMonth, pop] : population.m_populations)
+			auto territoryIndex = manager.getEntityIndex(territoryHandle);
+			if (territoryIndex < m_territoryAgendas.size())
 			{
-				if (pop.m_class == ECS_Core::Components::PopulationClass::WORKERS)
-				{
-					auto totalProductiveEffort = (pop.m_womensHealth * pop.m_numWomen)
-						+ (pop.m_mensHealth * pop.m_numMen);
-					auto subsistenceEffort = ((1 - pop.m_womensHealth) * pop.m_numWomen)
-						+ ((1 - pop.m_mensHealth) * pop.m_numMen);
-					totalWorkerCount += totalProductiveEffort;
-					totalSubsistenceCount += subsistenceEffort;
-					assignments[birthMonth].m_assignments.insert({ -1, { birthMonth, totalProductiveEffort } });
-					for (auto&& yieldType : agenda.m_yieldPriority)
-					{
-						// Make sure there are entries in the specialties for every skill needed to work the region
-						pop.m_specialties[yieldType];
-					}
-					for (auto&&[skillType, experience] : pop.m_specialties)
-					{
-						skillMap[skillType][{experience.m_level, experience.m_experience}].push_back({ birthMonth, totalProductiveEffort });
-					}
-				}
+				m_territoryAgendas[territoryIndex] = &agenda;
 			}
-			inventory.m_collectedYields[ECS_Core::Components::Yields::FOOD] += time.m_frameDuration * totalSubsistenceCount / 80;
+		}
+		return ecs::IterationBehavior::CONTINUE;
+	});
 
-			// We know who we want to work first
-			// Decide where they're working
-			// Figure out the actual amount yielded by this work
-			for (auto&& yield : agenda.m_yieldPriority)
+	// Each territory only touches its own components, so they can all be worked at once
+	m_managerRef.parallelForEntitiesMatching<ECS_Core::Signatures::S_ProducingTerritory>(
+		[&time, this](
+			const ecs::EntityIndex& mI,
+			const ECS_Core::Components::C_Territory&,
+			ECS_Core::Components::C_Population& population,
+			ECS_Core::Components::C_TileProductionPotential& territoryYield,
+			ECS_Core::Components::C_ResourceInventory& inventory)
+	{
+		if (!m_territoryAgendas[mI])
+		{
+			return ecs::IterationBehavior::CONTINUE;
+		}
+		const auto& agenda = *m_territoryAgendas[mI];
+		WorkerAssignmentMap assignments;
+
+		SkillMap skillMap;
+
+		// Choose which yields will be worked based on government priorities
+		// If production is the focus, highest skill works first
+		// If training is the focus, lowest skill works first
+		// After yields are determined, increase experience for the workers
+		// Experience advances more slowly for higher skill
+		f64 totalWorkerCount{ 0 };
+		f64 totalSubsistenceCount{ 0 };
+		for (size_t cohort = 0; cohort < population.Size(); ++cohort)
+		{
+			if (population.m_class[cohort] == ECS_Core::Components::PopulationClass::WORKERS)
 			{
-				auto availableYield = territoryYield.m_availableYields.find(yield);
-				if (availableYield == territoryYield.m_availableYields.end())
+				auto numWomen = population.m_numWomen[cohort];
+				auto numMen = population.m_numMen[cohort];
+				auto womensHealth = population.m_womensHealth[cohort];
+				auto mensHealth = population.m_mensHealth[cohort];
+				auto totalProductiveEffort = (womensHealth * numWomen)
+					+ (mensHealth * numMen);
+				auto subsistenceEffort = ((1 - womensHealth) * numWomen)
+					+ ((1 - mensHealth) * numMen);
+				totalWorkerCount += totalProductiveEffort;
+				totalSubsistenceCount += subsistenceEffort;
+				assignments[cohort].m_assignments.insert({ -1, { cohort, totalProductiveEffort } });
+				for (auto&& yieldType : agenda.m_yieldPriority)
 				{
-					continue;
+					// Make sure there are entries in the specialties for every skill needed to work the region
+					population.Specialty(cohort, yieldType);
 				}
+				population.ForEachSpecialty(cohort, [&skillMap, cohort, totalProductiveEffort](
+					ECS_Core::Components::SpecialtyId skillType,
+					const ECS_Core::Components::SpecialtyProgress& experience)
+				{
+					skillMap[skillType][{experience.m_level, experience.m_experience}].push_back({ cohort, totalProductiveEffort });
+				});
+			}
+		}
+		inventory.m_collectedYields[ECS_Core::Components::Yields::FOOD] += time.m_frameDuration * totalSubsistenceCount / 80;
+
+		// We know who we want to work first
+		// Decide where they're working
+		// Figure out the actual amount yielded by this work
+		for (auto&& yield : agenda.m_yieldPriority)
+		{
+			auto availableYield = territoryYield.m_availableYields.find(yield);
+			if (availableYield == territoryYield.m_availableYields.end())
+			{
+				continue;
+			}
 
-				f64 amountToWork = availableYield->second.m_workableTiles;
+			f64 amountToWork = availableYield->second.m_workableTiles;
 
-				switch (agenda.m_popAgenda)
+			switch (agenda.m_popAgenda)
+			{
+			case ECS_Core::Components::PopulationAgenda::TRAINING:
+				// Iterate from lowest skill to highest
+				for (auto&& skillLevel : skillMap[yield])
 				{
-				case ECS_Core::Components::PopulationAgenda::TRAINING:
-					// Iterate from lowest skill to highest
-					for (auto&& skillLevel : skillMap[yield])
+					if (amountToWork == 0)
 					{
-						if (amountToWork == 0)
-						{
-							break;
-						}
-
-						availableYield->second.m_productionProgress +=
-							AssignYieldWorkers(skillLevel, assignments, amountToWork, yield)
-							* time.m_frameDuration;
+						break;
 					}
-					break;
 
-				case ECS_Core::Components::PopulationAgenda::PRODUCTION:
-					// Iterate from highest skill to lowest
-					for (auto&& skillLevel : reverse(skillMap[yield]))
-					{
-						if (amountToWork == 0)
-						{
-							break;
-						}
+					availableYield->second.m_productionProgress +=
+						AssignYieldWorkers(skillLevel, assignments, amountToWork, yield)
+						* time.m_frameDuration;
+				}
+				break;
 
-						availableYield->second.m_productionProgress +=
-							AssignYieldWorkers(skillLevel, assignments, amountToWork, yield)
-							* time.m_frameDuration;
+			case ECS_Core::Components::PopulationAgenda::PRODUCTION:
+				// Iterate from highest skill to lowest
+				for (auto&& skillLevel : reverse(skillMap[yield]))
+				{
+					if (amountToWork == 0)
+					{
+						break;
 					}
-					break;
+
+					availableYield->second.m_productionProgress +=
+						AssignYieldWorkers(skillLevel, assignments, amountToWork, yield)
+						* time.m_frameDuration;
 				}
+				break;
 			}
+		}
 
-			for (auto&&[tileType, production] : territoryYield.m_availableYields)
+		for (auto&&[tileType, production] : territoryYield.m_availableYields)
+		{
+			s32 gainAmount = static_cast<s32>(production.m_productionProgress / production.m_productionInterval);
+			for (auto&&[resource, yield] : production.m_productionYield)
 			{
-				s32 gainAmount = static_cast<s32>(production.m_productionProgress / production.m_productionInterval);
-				for (auto&&[resource, yield] : production.m_productionYield)
-				{
-					inventory.m_collectedYields[resource] += gainAmount * yield;
-				}
-				production.m_productionProgress -= production.m_productionInterval * gainAmount;
+				inventory.m_collectedYields[resource] += gainAmount * yield;
 			}
+			production.m_productionProgress -= production.m_productionInterval * gainAmount;
+		}
 
-			// And assign experience to workers
-			for (auto&&[birthMonth, workers] : assignments)
+		// And assign experience to workers
+		for (auto&&[cohort, workers] : assignments)
+		{
+			for (auto&[skillType, assignment] : workers.m_assignments)
 			{
-				for (auto&[skillType, assignment] : workers.m_assignments)
-				{
-					if (skillType < 0) continue;
-					population.m_populations[birthMonth].m_specialties[skillType]
-						.m_experience += assignment.m_productiveValue;
-				}
+				if (skillType < 0) continue;
+				population.Specialty(cohort, skillType)
+					.m_experience += assignment.m_productiveValue;
 			}
 		}
 		return ecs::IterationBehavior::CONTINUE;
@@ -193,7 +214,7 @@ f64 Government::AssignYieldWorkers(
 	f64 totalYieldAmount = 0;
 	for (auto&& worker : skillLevel.second)
 	{
-		auto assignment = assignments.find(worker.m_workerKey);
+		auto assignment = assignments.find(worker.m_workerCohort);
 		if (assignment == assignments.end())
 		{
 			continue;
@@ -230,26 +251,26 @@ void Government::MovePopulations(
 {
 	int menMoved = 0;
 	int womenMoved = 0;
-	for (auto&&[birthMonth, pop] : populationSource.m_populations)
+	for (size_t cohort = 0; cohort < populationSource.Size(); ++cohort)
 	{
 		if (menMoved == totalMenToMove && totalWomenToMove == 5)
 		{
 			break;
 		}
-		if (pop.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+		if (populationSource.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 		{
 			continue;
 		}
-		auto menToMove = min<int>(totalMenToMove - menMoved, pop.m_numMen);
-		auto womenToMove = min<int>(totalWomenToMove - womenMoved, pop.m_numWomen);
+		auto menToMove = min<int>(totalMenToMove - menMoved, populationSource.m_numMen[cohort]);
+		auto womenToMove = min<int>(totalWomenToMove - womenMoved, populationSource.m_numWomen[cohort]);
 
-		auto& popCopy = populationTarget.m_populations[birthMonth];
-		popCopy = pop;
-		popCopy.m_numMen = menToMove;
-		popCopy.m_numWomen = womenToMove;
+		auto copyCohort = populationTarget.FindOrInsert(populationSource.m_keys[cohort]);
+		populationTarget.CopyCohort(copyCohort, populationSource, cohort);
+		populationTarget.m_numMen[copyCohort] = menToMove;
+		populationTarget.m_numWomen[copyCohort] = womenToMove;
 
-		pop.m_numMen -= menToMove;
-		pop.m_numWomen -= womenToMove;
+		populationSource.m_numMen[cohort] -= menToMove;
+		populationSource.m_numWomen[cohort] -= womenToMove;
 
 
 		menMoved += menToMove;
@@ -261,20 +282,16 @@ void Government::MoveFullPopulation(
 	ECS_Core::Components::C_Population& populationSource,
 	ECS_Core::Components::C_Population& populationTarget)
 {
-	for (auto&&[popKey, pop] : populationSource.m_populations)
+	for (size_t cohort = 0; cohort < populationSource.Size(); ++cohort)
 	{
-		if (pop.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+		if (populationSource.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 		{
 			continue;
 		}
-		auto popKeyCopy = popKey;
-		while (populationTarget.m_populations.find(popKeyCopy) != populationTarget.m_populations.end())
-		{
-			++popKeyCopy.m_segmentIndex;
-		}
-		populationTarget.m_populations[popKeyCopy] = pop;
+		auto mergedCohort = populationTarget.InsertUnique(populationSource.m_keys[cohort]);
+		populationTarget.CopyCohort(mergedCohort, populationSource, cohort);
 	}
-	populationSource.m_populations.clear();
+	populationSource.Clear();
 }
 
 void Government::Operate(GameLoopPhase phase, const timeuS& frameDuration)
@@ -437,14 +454,14 @@ void Government::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 							ECS_Core::Components::C_Population& populationSource = manager.getComponent<ECS_Core::Components::C_Population>(*builder.m_popSource);
 							int sourceTotalMen{ 0 };
 							int sourceTotalWomen{ 0 };
-							for (auto&&[birthMonth, pop] : populationSource.m_populations)
+							for (size_t cohort = 0; cohort < populationSource.Size(); ++cohort)
 							{
-								if (pop.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+								if (populationSource.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 								{
 									continue;
 								}
-								sourceTotalMen += pop.m_numMen;
-								sourceTotalWomen += pop.m_numWomen;
+								sourceTotalMen += populationSource.m_numMen[cohort];
+								sourceTotalWomen += populationSource.m_numWomen[cohort];
 							}
 							int totalMenToMove = 10;
 							int totalWomenToMove = 5;
@@ -477,10 +494,10 @@ void Government::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 							moverInventory.m_collectedYields[ECS_Core::Components::Yields::FOOD] = 50;
 							auto timeFront = manager.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>().front();
 							auto& time = manager.getComponent<ECS_Core::Components::C_TimeTracker>(timeFront);
-							auto& foundingPopulation = population.m_populations[-12 * (time.m_year - 15) - time.m_month];
-							foundingPopulation.m_numMen = 25;
-							foundingPopulation.m_numWomen = 25;
-							foundingPopulation.m_class = ECS_Core::Components::PopulationClass::WORKERS;
+							auto foundingCohort = population.FindOrInsert(-12 * (time.m_year - 15) - time.m_month);
+							population.m_numMen[foundingCohort] = 25;
+							population.m_numWomen[foundingCohort] = 25;
+							population.m_class[foundingCohort] = ECS_Core::Components::PopulationClass::WORKERS;
 							return newEntity;
 						}
 					}();
@@ -515,7 +532,7 @@ void Government::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				}
 				else if (std::holds_alternative<Action::CreateExplorationUnit>(action.m_command))
 				{
-					auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+					const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 					if (timeEntities.size() == 0)
 					{
 						continue;
@@ -535,13 +552,13 @@ void Government::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					auto& inventorySource = m_managerRef.getComponent<ECS_Core::Components::C_ResourceInventory>(*createAction.m_popSource);
 
 					int numMen = 0;
-					for (auto&&[age, popSegment] : popSource.m_populations)
+					for (size_t cohort = 0; cohort < popSource.Size(); ++cohort)
 					{
-						if (popSegment.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+						if (popSource.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 						{
 							continue;
 						}
-						if ((numMen += popSegment.m_numMen) > 8)
+						if ((numMen += popSource.m_numMen[cohort]) > 8)
 						{
 							break;
 						}
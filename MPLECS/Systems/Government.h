@@ -15,6 +15,14 @@
 class Government : public SystemBase
 {
 public:
+	// Creates units and buildings for each realm's plans, so ACTION and ACTION_RESPONSE run alone
+	using Access = SystemAccess<
+		StructuralPhase<GameLoopPhase::ACTION>,
+		StructuralPhase<GameLoopPhase::ACTION_RESPONSE>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<ECS_Core::Components::C_Agenda>,
+			Writes<ECS_Core::Components::C_Realm>>>;
+
 	Government() : SystemBase() {
 		m_buildingCosts[0] =
 		{
@@ -46,5 +54,7 @@ protected:
 		const int& yield);
 
 	std::map<int, ECS_Core::Components::YieldBuckets> m_buildingCosts;
+	// Agenda of the realm owning each territory, indexed by entity
+	std::vector<const ECS_Core::Components::C_Agenda*> m_territoryAgendas;
 };
 template <> std::unique_ptr<Government> InstantiateSystem();
\ No newline at end of file
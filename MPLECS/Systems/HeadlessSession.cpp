@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Systems/HeadlessSession.cpp
+// Replaces the window, input and rendering for soak tests, benchmarks and batch simulation.
+// Nobody gives input, so the session unpauses time itself and counts down the game days to run.
+
+#include "../Core/typedef.h"
+
+#include "HeadlessSession.h"
+
+#include <iostream>
+
+namespace
+{
+	constexpr int c_daysPerReport = 30;
+
+	f64 AbsoluteDay(const ECS_Core::Components::C_TimeTracker& time)
+	{
+		return ((time.m_year * 12. + time.m_month) * 30.) + time.m_day + time.m_dayProgress;
+	}
+}
+
+void HeadlessSession::ProgramInit()
+{
+	// Other systems expect the window info entity SFMLManager would create
+	auto windowInfoIndex = m_managerRef.createHandle();
+	auto& windowInfo = m_managerRef.addComponent<ECS_Core::Components::C_WindowInfo>(windowInfoIndex);
+	windowInfo.m_windowSize = { 1600, 900 };
+	windowInfo.m_headless = true;
+}
+
+void HeadlessSession::SetupGameplay()
+{
+	m_startTime = std::chrono::high_resolution_clock::now();
+}
+
+void HeadlessSession::Operate(GameLoopPhase phase, const timeuS& frameDuration)
+{
+	if (phase == GameLoopPhase::PREPARATION)
+	{
+		// Cleanup also runs between the simulation steps of a frame, so count frames here
+		++m_frameCount;
+		return;
+	}
+	if (phase != GameLoopPhase::CLEANUP)
+	{
+		return;
+	}
+
+	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_Input>([](
+		const ecs::EntityIndex&,
+		ECS_Core::Components::C_UserInputs& input)
+	{
+		input.Reset();
+		return ecs::IterationBehavior::CONTINUE;
+	});
+
+	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_TimeTracker>([this](
+		const ecs::EntityIndex&,
+		ECS_Core::Components::C_TimeTracker& time)
+	{
+		if (!m_started)
+		{
+			// The time entity only becomes visible after setup, so start the clock on the first frame
+			time.m_paused = false;
+			time.m_gameSpeed = m_gameSpeed;
+			m_startDay = AbsoluteDay(time);
+			m_started = true;
+		}
+
+		auto simulatedDays = static_cast<int>(AbsoluteDay(time) - m_startDay);
+		m_droppedDays = time.m_droppedDays;
+		if (simulatedDays >= m_lastReportedDay + c_daysPerReport)
+		{
+			m_lastReportedDay = simulatedDays - (simulatedDays % c_daysPerReport);
+			ReportProgress(simulatedDays);
+		}
+		if (simulatedDays >= m_daysToSimulate)
+		{
+			ReportProgress(simulatedDays);
+			m_finished = true;
+		}
+		return ecs::IterationBehavior::CONTINUE;
+	});
+}
+
+void HeadlessSession::ReportProgress(int simulatedDays) const
+{
+	auto elapsedSeconds = std::chrono::duration<f64>(std::chrono::high_resolution_clock::now() - m_startTime).count();
+	std::cout << "Day " << simulatedDays << "/" << m_daysToSimulate
+		<< ": " << m_frameCount << " frames in " << elapsedSeconds << " s ("
+		<< (elapsedSeconds > 0 ? simulatedDays / elapsedSeconds : 0.) << " days/s, "
+		<< (elapsedSeconds > 0 ? m_frameCount / elapsedSeconds : 0.) << " frames/s)";
+	if (m_droppedDays > 0)
+	{
+		// Frames owed more game time than the simulation could catch up on
+		std::cout << ", " << m_droppedDays << " days dropped";
+	}
+	std::cout << std::endl;
+}
+
+bool HeadlessSession::ShouldExit()
+{
+	return m_finished;
+}
+
+DEFINE_SYSTEM_INSTANTIATION(HeadlessSession);
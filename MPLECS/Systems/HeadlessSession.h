@@ -0,0 +1,50 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Systems/HeadlessSession.h
+// Stands in for SFMLManager when running without a window
+// Runs time unpaused, and ends the program after a set number of game days
+
+#include "../ECS/System.h"
+
+#include <chrono>
+
+class HeadlessSession : public SystemBase
+{
+public:
+	// Scripts the inputs and clock of a session without a window
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::PREPARATION,
+			Reads<>,
+			Writes<>>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_TimeTracker>>>;
+
+	HeadlessSession() : SystemBase() { }
+	virtual ~HeadlessSession() {}
+	virtual void ProgramInit() override;
+	virtual void SetupGameplay() override;
+	virtual void Operate(GameLoopPhase phase, const timeuS& frameDuration) override;
+	virtual bool ShouldExit() override;
+
+	void SetDaysToSimulate(int days) { m_daysToSimulate = days; }
+	void SetGameSpeed(int gameSpeed) { m_gameSpeed = gameSpeed; }
+protected:
+	void ReportProgress(int simulatedDays) const;
+
+	int m_daysToSimulate{ 360 };
+	int m_gameSpeed{ 1 };
+
+	bool m_started{ false };
+	bool m_finished{ false };
+	f64 m_startDay{ 0 };
+	int m_lastReportedDay{ 0 };
+	f64 m_droppedDays{ 0 };
+	u64 m_frameCount{ 0 };
+	std::chrono::high_resolution_clock::time_point m_startTime;
+};
+template <> std::unique_ptr<HeadlessSession> InstantiateSystem();
@@ -16,6 +16,15 @@
 class InputTranslation : public SystemBase
 {
 public:
+	// Turns user inputs into action plans
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::INPUT,
+			Reads<ECS_Core::Components::C_MovementTarget, ECS_Core::Components::C_CaravanPlan>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_ActionPlan, ECS_Core::Components::C_TilePosition>>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<ECS_Core::Components::C_UserInputs>,
+			Writes<ECS_Core::Components::C_ActionPlan>>>;
+
 	InputTranslation();
 	virtual ~InputTranslation() {}
 	virtual void ProgramInit() override;
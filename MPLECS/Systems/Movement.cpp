@@ -23,13 +23,14 @@ void Movement::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 	}
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
 	}
 	const auto& time = m_managerRef.getComponent<ECS_Core::Components::C_TimeTracker>(timeEntities.front());
-	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_ApplyConstantMotion>(
+	// Every mover only updates its own components, so each pass is spread over the thread pool
+	m_managerRef.parallelForEntitiesMatching<ECS_Core::Signatures::S_ApplyConstantMotion>(
 		[&time](
 			ecs::EntityIndex mI,
 			ECS_Core::Components::C_PositionCartesian& position,
@@ -38,7 +39,7 @@ void Movement::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 		return ecs::IterationBehavior::CONTINUE;
 	});
 
-	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_ApplyNewtonianMotion>(
+	m_managerRef.parallelForEntitiesMatching<ECS_Core::Signatures::S_ApplyNewtonianMotion>(
 		[&time](
 			ecs::EntityIndex mI,
 			ECS_Core::Components::C_PositionCartesian& position,
@@ -48,8 +49,8 @@ void Movement::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 		return ecs::IterationBehavior::CONTINUE;
 	});
 
-	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_MovingUnit>(
-		[&manager = m_managerRef, &time](
+	m_managerRef.parallelForEntitiesMatching<ECS_Core::Signatures::S_MovingUnit>(
+		[&time](
 			ecs::EntityIndex mI,
 			ECS_Core::Components::C_TilePosition& tilePosition,
 			ECS_Core::Components::C_MovingUnit& mover,
@@ -59,14 +60,15 @@ void Movement::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 		if (mover.m_currentMovement)
 		{
 			auto& pointMovement = *mover.m_currentMovement;
+			auto& path = pointMovement.m_path;
 			pointMovement.m_currentMovementProgress += time.m_frameDuration * mover.m_movementPerDay;
-			while (pointMovement.m_currentMovementProgress >= pointMovement.m_path[pointMovement.m_currentPathIndex].m_movementCost)
+			while (pointMovement.m_currentMovementProgress >= path.CurrentMovementCost())
 			{
-				pointMovement.m_currentMovementProgress -= pointMovement.m_path[pointMovement.m_currentPathIndex].m_movementCost;
-				pointMovement.m_currentPathIndex = min<int>(++pointMovement.m_currentPathIndex, static_cast<int>(pointMovement.m_path.size()) - 1);
+				pointMovement.m_currentMovementProgress -= path.CurrentMovementCost();
+				path.Advance();
 			}
-			tilePosition.m_position = pointMovement.m_path[pointMovement.m_currentPathIndex].m_tile;
-			if (mover.m_explorationPlan && pointMovement.m_currentPathIndex == pointMovement.m_path.size() - 1)
+			tilePosition.m_position = path.CurrentTile();
+			if (mover.m_explorationPlan && path.AtBack())
 			{
 				mover.m_currentMovement.reset();
 			}
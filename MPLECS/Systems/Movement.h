@@ -12,6 +12,12 @@
 class Movement : public SystemBase
 {
 public:
+	// Moves units along their paths
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::ACTION,
+			Reads<ECS_Core::Components::C_TimeTracker, ECS_Core::Components::C_AccelerationCartesian, ECS_Core::Components::C_Population, ECS_Core::Components::C_Vision>,
+			Writes<ECS_Core::Components::C_PositionCartesian, ECS_Core::Components::C_VelocityCartesian, ECS_Core::Components::C_TilePosition, ECS_Core::Components::C_MovingUnit>>>;
+
 	Movement() : SystemBase() { }
 	virtual ~Movement() {}
 	virtual void ProgramInit() override;
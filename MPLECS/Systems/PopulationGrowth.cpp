@@ -12,97 +12,78 @@
 
 #include "PopulationGrowth.h"
 
-void PopulationGrowth::ProgramInit() {}
-void PopulationGrowth::SetupGameplay() {}
+#include "../Util/CounterRandom.h"
 
-void PopulationGrowth::GainLevels()
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace
 {
-	using namespace ECS_Core;
-	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_Population>([](
-		const ecs::EntityIndex&,
-		Components::C_Population& population,
-		const Components::C_ResourceInventory&)
+	using ECS_Core::Components::C_Population;
+	using ECS_Core::Components::PopulationClass;
+
+	// Separate streams for each use, so adding draws to one doesn't shift the other
+	enum RandomStream : u32
+	{
+		BIRTHS,
+		DEATHS
+	};
+
+	// Each kernel runs over one territory's cohort arrays in straight loops without early exits,
+	// so the compiler can vectorize them
+
+	void GainLevels(C_Population& population)
 	{
-		for (auto&& [birthMonth,popSegment] : population.m_populations)
+		// Specialties nobody has started are level 1 with no experience, so they never level up
+		for (auto&& experience : population.m_specialties)
 		{
-			for (auto&& [skillType,experience]: popSegment.m_specialties)
+			// TODO: Manually configured XP thresholds
+			s32 xpThreshold = experience.m_level * experience.m_level * 10000;
+			if (experience.m_experience >= xpThreshold)
 			{
-				// TODO: Manually configured XP thresholds
-				s32 xpThreshold = experience.m_level * experience.m_level * 10000;
-				if (experience.m_experience >= xpThreshold)
-				{
-					++experience.m_level;
-					experience.m_experience -= xpThreshold;
-				}
+				++experience.m_level;
+				experience.m_experience -= xpThreshold;
 			}
 		}
-		return ecs::IterationBehavior::CONTINUE;
-	});
-}
+	}
 
-void PopulationGrowth::AgePopulations()
-{
-	using namespace ECS_Core;
-	auto& timeEntity = m_managerRef.entitiesMatching<Signatures::S_TimeTracker>();
-	if (timeEntity.size() == 0) return;
-	auto& time = m_managerRef.getComponent<Components::C_TimeTracker>(timeEntity.front());
-	m_managerRef.forEntitiesMatching<Signatures::S_Population>([&time](
-		const ecs::EntityIndex&,
-		Components::C_Population& population,
-		const Components::C_ResourceInventory&)
+	void AgeCohorts(C_Population& population, s32 currentMonth)
 	{
-		for (auto&& [birthMonth,popSegment] : population.m_populations)
+		const auto cohortCount = population.Size();
+		const auto* keys = population.m_keys.data();
+		auto* classes = population.m_class.data();
+		for (size_t i = 0; i < cohortCount; ++i)
 		{
-			auto yearsOld = ((12 * time.m_year + time.m_month) + birthMonth.m_birthMonthIndex) / 12;
-			if (popSegment.m_class == ECS_Core::Components::PopulationClass::CHILDREN
-				&& yearsOld >= 15)
-			{
-				popSegment.m_class = ECS_Core::Components::PopulationClass::WORKERS;
-			}
-			if (popSegment.m_class == ECS_Core::Components::PopulationClass::WORKERS
-				&& yearsOld >= 65)
-			{
-				popSegment.m_class = ECS_Core::Components::PopulationClass::ELDERS;
-			}
+			auto yearsOld = (currentMonth + keys[i].m_birthMonthIndex) / 12;
+			auto ageClass = yearsOld >= 65 ? PopulationClass::ELDERS
+				: yearsOld >= 15 ? PopulationClass::WORKERS
+				: PopulationClass::CHILDREN;
+			// Nobody goes back to a younger class
+			classes[i] = max(classes[i], ageClass);
 		}
-		return ecs::IterationBehavior::CONTINUE;
-	});
-}
+	}
 
-void PopulationGrowth::BirthChildren()
-{
-	using namespace ECS_Core;
-	auto& timeEntity = m_managerRef.entitiesMatching<Signatures::S_TimeTracker>();
-	if (timeEntity.size() == 0) return;
-	auto& time = m_managerRef.getComponent<Components::C_TimeTracker>(timeEntity.front());
-	m_managerRef.forEntitiesMatching<Signatures::S_Population>([&time](
-		const ecs::EntityIndex&,
-		Components::C_Population& population,
-		const Components::C_ResourceInventory&) -> ecs::IterationBehavior
+	void BirthChildren(C_Population& population, s32 currentMonth, u32 randomStream)
 	{
+		const auto cohortCount = population.Size();
+		const auto* keys = population.m_keys.data();
+		const auto* numWomen = population.m_numWomen.data();
+		const auto* numMen = population.m_numMen.data();
 		s32 potentialMotherCount{ 0 };
 		s32 potentialFatherCount{ 0 };
 		s32 boyCount{ 0 };
 		s32 girlCount{ 0 };
-		for (auto&& [birthMonth,popSegment] : population.m_populations)
+		for (size_t i = 0; i < cohortCount; ++i)
 		{
 			// Age keys are in months
-			auto popAge = ((12 * time.m_year + time.m_month) + birthMonth.m_birthMonthIndex) / 12;
-			if (popAge >= 15 && popAge <= 45)
-			{
-				// Women are of birthing age
-				potentialMotherCount += popSegment.m_numWomen;
-			}
-			if (popAge >= 15 && popAge <= 60)
-			{
-				// Fathers are still potent
-				potentialFatherCount += popSegment.m_numMen;
-			}
-			if (popAge < 15)
-			{
-				boyCount += popSegment.m_numMen;
-				girlCount += popSegment.m_numWomen;
-			}
+			auto popAge = (currentMonth + keys[i].m_birthMonthIndex) / 12;
+			// Women are of birthing age
+			potentialMotherCount += (popAge >= 15 && popAge <= 45) ? numWomen[i] : 0;
+			// Fathers are still potent
+			potentialFatherCount += (popAge >= 15 && popAge <= 60) ? numMen[i] : 0;
+			boyCount += popAge < 15 ? numMen[i] : 0;
+			girlCount += popAge < 15 ? numWomen[i] : 0;
 		}
 		// Approximately 1 child every 4 years
 		f64 childFloat = 1. * min(potentialMotherCount, potentialFatherCount * 2) / 36;
@@ -110,14 +91,13 @@ void PopulationGrowth::BirthChildren()
 		if (childCount == 0)
 		{
 			// Take the value of childFloat as a probability of a child, rather than a quantity
-			if (RandDouble() < childFloat)
-			{
-				childCount = 1;
-			}
-			else
+			auto randomDouble = CounterRandom::ToUnitDouble(
+				CounterRandom::Draw(CounterRandom::StreamKey(randomStream, RandomStream::BIRTHS), 0));
+			if (randomDouble >= childFloat)
 			{
-				return ecs::IterationBehavior::CONTINUE;
+				return;
 			}
+			childCount = 1;
 		}
 		s32 maleChildCount{ 0 };
 		s32 femaleChildCount{ 0 };
@@ -131,158 +111,190 @@ void PopulationGrowth::BirthChildren()
 			femaleChildCount = childCount / 2;
 			maleChildCount = childCount - femaleChildCount;
 		}
-		auto& newPopulation = population.m_populations[-12 * time.m_year - time.m_month];
-		newPopulation.m_numMen = maleChildCount;
-		newPopulation.m_numWomen = femaleChildCount;
-		return ecs::IterationBehavior::CONTINUE;
-	});
-}
-
-void PopulationGrowth::FeedWomen(
-	const ECS_Core::Components::C_TimeTracker& time,
-	f64& foodAmount,
-	ECS_Core::Components::PopulationSegment& pop)
-{
-	auto womensFoodRequired = time.m_frameDuration * pop.m_numWomen / (12 * 30);
-	if (foodAmount > womensFoodRequired)
-	{
-		pop.m_womensHealth = min<f64>(1, time.m_frameDuration / 30. + pop.m_womensHealth);
-		foodAmount -= womensFoodRequired;
-	}
-	else
-	{
-		pop.m_womensHealth = max<f64>(0, pop.m_womensHealth -
-			time.m_frameDuration * (womensFoodRequired - foodAmount) / (30 * womensFoodRequired));
-		foodAmount = 0;
+		auto newCohort = population.FindOrInsert(-currentMonth);
+		population.m_numMen[newCohort] = maleChildCount;
+		population.m_numWomen[newCohort] = femaleChildCount;
 	}
-}
 
-void PopulationGrowth::FeedMen(
-	const ECS_Core::Components::C_TimeTracker& time,
-	f64& foodAmount,
-	ECS_Core::Components::PopulationSegment& pop)
-{
-	auto mensFoodRequired = time.m_frameDuration * pop.m_numMen / (12 * 30);
-	if (foodAmount > mensFoodRequired)
+	// Workers eat first
+	// Then children
+	// Then elders
+	// Younger before older, women before men
+	void FeedCohorts(C_Population& population, f64 stepDuration, f64& foodAmount)
 	{
-		pop.m_mensHealth = min<f64>(1, time.m_frameDuration / 30. + pop.m_mensHealth);
-		foodAmount -= mensFoodRequired;
-	}
-	else
-	{
-		pop.m_mensHealth = max<f64>(0, pop.m_mensHealth -
-			time.m_frameDuration * (mensFoodRequired - foodAmount) / (30 * mensFoodRequired));
-		foodAmount = 0;
-	}
-}
+		const auto cohortCount = population.Size();
+		const auto* numWomen = population.m_numWomen.data();
+		const auto* numMen = population.m_numMen.data();
+		const auto* classes = population.m_class.data();
 
-void PopulationGrowth::ConsumeResources()
-{
-	using namespace ECS_Core;
-	auto& timeEntity = m_managerRef.entitiesMatching<Signatures::S_TimeTracker>();
-	if (timeEntity.size() == 0) return;
-	auto& time = m_managerRef.getComponent<Components::C_TimeTracker>(timeEntity.front());
-	m_managerRef.forEntitiesMatching<Signatures::S_Population>([&time, this](
-		const ecs::EntityIndex&,
-		Components::C_Population& population,
-		Components::C_ResourceInventory& resources) -> ecs::IterationBehavior
-	{
-		auto& foodAmount = resources.m_collectedYields[Components::Yields::FOOD];
+		// Food each cohort needs this step, and how much of it they went without.
+		// A negative shortfall means they got all of it, and a little to spare
+		thread_local std::vector<f64> womensFood, mensFood, womensShortfall, mensShortfall;
+		womensFood.resize(cohortCount);
+		mensFood.resize(cohortCount);
+		womensShortfall.resize(cohortCount);
+		mensShortfall.resize(cohortCount);
 
-		// Workers eat first
-		// Then children
-		// Then elders
-		// Younger before older
-		for (auto&& [birthMonth,pop] : population.m_populations)
+		f64 workersFood{ 0 };
+		f64 childrensFood{ 0 };
+		f64 eldersFood{ 0 };
+		for (size_t i = 0; i < cohortCount; ++i)
 		{
-			if (pop.m_class != Components::PopulationClass::WORKERS)
-			{
-				continue;
-			}
-
-			// women eat before men
-			FeedWomen(time, foodAmount, pop);
-			FeedMen(time, foodAmount, pop);
+			womensFood[i] = stepDuration * numWomen[i] / (12 * 30);
+			mensFood[i] = stepDuration * numMen[i] / (12 * 30);
+			auto cohortFood = womensFood[i] + mensFood[i];
+			workersFood += classes[i] == PopulationClass::WORKERS ? cohortFood : 0.;
+			childrensFood += classes[i] == PopulationClass::CHILDREN ? cohortFood : 0.;
+			eldersFood += classes[i] == PopulationClass::ELDERS ? cohortFood : 0.;
 		}
-		for (auto&& [birthMonth,pop] : population.m_populations)
+
+		// Classes before the food runs out are all fed, the ones after all go hungry,
+		// and only the class where it runs out has to be handed out cohort by cohort
+		enum class Feeding { FED, RATIONED, HUNGRY };
+		Feeding feeding[3]{ Feeding::HUNGRY, Feeding::HUNGRY, Feeding::HUNGRY };
+		std::optional<PopulationClass> rationedClass;
+		for (auto&& [popClass, classFood] : {
+			std::pair{ PopulationClass::WORKERS, workersFood },
+			std::pair{ PopulationClass::CHILDREN, childrensFood },
+			std::pair{ PopulationClass::ELDERS, eldersFood } })
 		{
-			if (pop.m_class != Components::PopulationClass::CHILDREN)
+			if (foodAmount > classFood)
 			{
+				feeding[popClass] = Feeding::FED;
+				foodAmount -= classFood;
 				continue;
 			}
-			FeedWomen(time, foodAmount, pop);
-			FeedMen(time, foodAmount, pop);
+			if (foodAmount > 0)
+			{
+				feeding[popClass] = Feeding::RATIONED;
+				rationedClass = popClass;
+			}
+			break;
+		}
+
+		for (size_t i = 0; i < cohortCount; ++i)
+		{
+			auto fed = feeding[classes[i]] == Feeding::FED;
+			womensShortfall[i] = fed ? -1. : womensFood[i];
+			mensShortfall[i] = fed ? -1. : mensFood[i];
 		}
-		for (auto&& [birthMonth,pop] : population.m_populations)
+		if (rationedClass)
 		{
-			if (pop.m_class != Components::PopulationClass::ELDERS)
+			auto ration = [&foodAmount](f64 food, f64& shortfall)
 			{
-				continue;
+				if (foodAmount > food)
+				{
+					shortfall = -1;
+					foodAmount -= food;
+				}
+				else
+				{
+					shortfall = food - foodAmount;
+					foodAmount = 0;
+				}
+			};
+			for (size_t i = 0; i < cohortCount; ++i)
+			{
+				if (classes[i] == *rationedClass)
+				{
+					ration(womensFood[i], womensShortfall[i]);
+					ration(mensFood[i], mensShortfall[i]);
+				}
 			}
-			FeedWomen(time, foodAmount, pop);
-			FeedMen(time, foodAmount, pop);
 		}
 
-		return ecs::IterationBehavior::CONTINUE;
-	});
-}
+		auto* womensHealth = population.m_womensHealth.data();
+		auto* mensHealth = population.m_mensHealth.data();
+		for (size_t i = 0; i < cohortCount; ++i)
+		{
+			auto womensLoss = womensFood[i] > 0 ? stepDuration * womensShortfall[i] / (30 * womensFood[i]) : 0.;
+			womensHealth[i] = womensShortfall[i] < 0
+				? min<f64>(1, stepDuration / 30. + womensHealth[i])
+				: max<f64>(0, womensHealth[i] - womensLoss);
+			auto mensLoss = mensFood[i] > 0 ? stepDuration * mensShortfall[i] / (30 * mensFood[i]) : 0.;
+			mensHealth[i] = mensShortfall[i] < 0
+				? min<f64>(1, stepDuration / 30. + mensHealth[i])
+				: max<f64>(0, mensHealth[i] - mensLoss);
+		}
+	}
 
-void PopulationGrowth::CauseNaturalDeaths()
-{
-	using namespace ECS_Core;
-	auto& timeEntity = m_managerRef.entitiesMatching<Signatures::S_TimeTracker>();
-	if (timeEntity.size() == 0) return;
-	auto& time = m_managerRef.getComponent<Components::C_TimeTracker>(timeEntity.front());
-	m_managerRef.forEntitiesMatching<Signatures::S_Population>([&time](
-		const ecs::EntityIndex&,
-		Components::C_Population& population,
-		const Components::C_ResourceInventory&) -> ecs::IterationBehavior
+	void CauseNaturalDeaths(C_Population& population, s32 currentMonth, f64 stepDuration, u32 randomStream)
 	{
-		// Chance of dying = % of a year since previous frame
+		const auto cohortCount = population.Size();
+		const auto* keys = population.m_keys.data();
+		const auto* womensHealth = population.m_womensHealth.data();
+		const auto* mensHealth = population.m_mensHealth.data();
+		auto* numWomen = population.m_numWomen.data();
+		auto* numMen = population.m_numMen.data();
+		const auto deathStream = CounterRandom::StreamKey(randomStream, RandomStream::DEATHS);
+
+		// Chance of dying = % of a year since previous step
 		// Multiplied by population age
-		f64 frameYearPercent = time.m_frameDuration / (12 * 30);
-		std::vector<ECS_Core::Components::PopulationKey> deadSegments;
-		for (auto&& [birthMonth,popSegment] : population.m_populations)
+		f64 frameYearPercent = stepDuration / (12 * 30);
+		bool anyDeadCohorts = false;
+		for (size_t i = 0; i < cohortCount; ++i)
 		{
 			// Age keys are in months
-			auto popAge = ((12 * time.m_year + time.m_month) + birthMonth.m_birthMonthIndex) / 12;
+			auto popAge = (currentMonth + keys[i].m_birthMonthIndex) / 12;
 
 			// Healthiest people are ~25
 			auto distanceFromHealth = max<int>(1, abs(popAge - 25));
 			auto womensDeathChance = frameYearPercent
-				* (1 - (popSegment.m_womensHealth / 2))
-				* popSegment.m_numWomen
+				* (1 - (womensHealth[i] / 2))
+				* numWomen[i]
 				* distanceFromHealth / 150;
-			auto randDouble = RandDouble();
-			auto femaleDeathCount = min<int>(popSegment.m_numWomen, static_cast<int>(womensDeathChance / randDouble));
+			auto randDouble = CounterRandom::ToUnitDouble(CounterRandom::Draw(deathStream, static_cast<u32>(2 * i)));
+			// Clamp before converting, the ratio is huge when the draw is tiny
+			auto femaleDeathCount = static_cast<s32>(max<f64>(0, min<f64>(numWomen[i], womensDeathChance / randDouble)));
 			auto mensDeathChance = frameYearPercent
-				* (1 - (popSegment.m_mensHealth / 2))
-				* popSegment.m_numMen
+				* (1 - (mensHealth[i] / 2))
+				* numMen[i]
 				* distanceFromHealth / 150;
-			randDouble = RandDouble();
-			auto maleDeathCount = min<int>(popSegment.m_numMen, static_cast<int>(mensDeathChance / randDouble));
-
-			if (maleDeathCount < 0)
-			{
-				maleDeathCount = 0;
-			}
-			if (femaleDeathCount < 0)
-			{
-				femaleDeathCount = 0;
-			}
-			popSegment.m_numMen -= maleDeathCount;
-			popSegment.m_numWomen -= femaleDeathCount;
+			randDouble = CounterRandom::ToUnitDouble(CounterRandom::Draw(deathStream, static_cast<u32>(2 * i + 1)));
+			auto maleDeathCount = static_cast<s32>(max<f64>(0, min<f64>(numMen[i], mensDeathChance / randDouble)));
 
-			if (popSegment.m_numMen <= 0
-				&& popSegment.m_numWomen <= 0)
-			{
-				deadSegments.emplace_back(birthMonth);
-			}
+			numMen[i] -= maleDeathCount;
+			numWomen[i] -= femaleDeathCount;
+			anyDeadCohorts |= (numMen[i] <= 0 && numWomen[i] <= 0);
+		}
+		if (anyDeadCohorts)
+		{
+			population.EraseEmpty();
 		}
-		for (auto&& deadKey : deadSegments)
+	}
+}
+
+void PopulationGrowth::ProgramInit() {}
+void PopulationGrowth::SetupGameplay() {}
+
+void PopulationGrowth::UpdatePopulations()
+{
+	using namespace ECS_Core;
+	auto& timeEntity = m_managerRef.entitiesMatching<Signatures::S_TimeTracker>();
+	if (timeEntity.size() == 0) return;
+	auto& time = m_managerRef.getComponent<Components::C_TimeTracker>(timeEntity.front());
+	const auto currentMonth = 12 * time.m_year + time.m_month;
+	const auto newMonth = time.IsNewMonth();
+
+	// Each population only touches its own components, and draws from its own random stream
+	m_managerRef.parallelForEntitiesMatching<Signatures::S_Population>([&manager = m_managerRef, &time, currentMonth, newMonth](
+		const ecs::EntityIndex& mI,
+		Components::C_Population& population,
+		Components::C_ResourceInventory& resources)
+	{
+		// Keyed by the handle rather than the index, a population born into a dead one's index doesn't repeat its draws
+		auto handle = manager.getHandle(mI);
+		auto randomStream = CounterRandom::StreamKey(
+			CounterRandom::StreamKey(static_cast<u32>(handle.handleDataIndex), static_cast<u32>(handle.counter)),
+			time.m_stepCount);
+		GainLevels(population);
+		if (newMonth)
 		{
-			population.m_populations.erase(deadKey);
+			AgeCohorts(population, currentMonth);
+			BirthChildren(population, currentMonth, randomStream);
 		}
+		FeedCohorts(population, time.m_frameDuration, resources.m_collectedYields[Components::Yields::FOOD]);
+		CauseNaturalDeaths(population, currentMonth, time.m_frameDuration, randomStream);
 		return ecs::IterationBehavior::CONTINUE;
 	});
 }
@@ -298,18 +310,7 @@ void PopulationGrowth::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 	case GameLoopPhase::CLEANUP:
 		return;
 	case GameLoopPhase::ACTION:
-		GainLevels();
-		{
-			auto&& timeEntity = m_managerRef.getComponent<ECS_Core::Components::C_TimeTracker>(
-				m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>().front());
-			if (timeEntity.IsNewMonth())
-			{
-				AgePopulations();
-				BirthChildren();
-			}
-			ConsumeResources();
-			CauseNaturalDeaths();
-		}
+		UpdatePopulations();
 		return;
 	}
 }
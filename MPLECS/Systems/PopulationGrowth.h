@@ -12,6 +12,12 @@
 class PopulationGrowth : public SystemBase
 {
 public:
+	// Each population is grown on its own, so ACTION only writes populations and their inventories
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::ACTION,
+			Reads<ECS_Core::Components::C_TimeTracker>,
+			Writes<ECS_Core::Components::C_Population, ECS_Core::Components::C_ResourceInventory>>>;
+
 	PopulationGrowth() : SystemBase() { }
 	virtual ~PopulationGrowth() {}
 	virtual void ProgramInit() override;
@@ -19,19 +25,7 @@ public:
 	virtual void Operate(GameLoopPhase phase, const timeuS& frameDuration) override;
 	virtual bool ShouldExit() override;
 protected:
-	void GainLevels();
-	void AgePopulations();
-	void BirthChildren();
-	void FeedWomen(
-		const ECS_Core::Components::C_TimeTracker& time,
-		f64& foodAmount,
-		ECS_Core::Components::PopulationSegment& pop);
-	void FeedMen(
-		const ECS_Core::Components::C_TimeTracker& time,
-		f64& foodAmount,
-		ECS_Core::Components::PopulationSegment& pop);
-
-	void ConsumeResources();
-	void CauseNaturalDeaths();
+	// Levels, aging and births (at the start of a month), feeding and deaths, one territory at a time
+	void UpdatePopulations();
 };
 template <> std::unique_ptr<PopulationGrowth> InstantiateSystem();
\ No newline at end of file
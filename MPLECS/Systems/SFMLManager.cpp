@@ -12,6 +12,8 @@
 
 #include "SFMLManager.h"
 
+#include "../Util/Profiler.h"
+
 #include <optional>
 
 sf::Font s_font;
@@ -645,7 +647,8 @@ void SFMLManager::DisplayCurrentInputs(
 		windowPositionText,
 		worldPositionText,
 		worldCoordinatesText,
-		frameDurationText;
+		frameDurationText,
+		slowestZoneText;
 	std::vector<sf::Text*> texts{
 		&modifierText,
 		&newDownText,
@@ -654,7 +657,8 @@ void SFMLManager::DisplayCurrentInputs(
 		&windowPositionText,
 		&worldPositionText,
 		&worldCoordinatesText,
-		&frameDurationText
+		&frameDurationText,
+		&slowestZoneText
 	};
 	std::string modifierString = "";
 	if (inputComponent.m_activeModifiers & (u8)ECS_Core::Components::Modifiers::CTRL)
@@ -719,6 +723,22 @@ void SFMLManager::DisplayCurrentInputs(
 	std::string frameDurationStr = "FrameDuration: " + std::to_string(frameDuration) + " uS. FPS = " + std::to_string(1000000. / frameDuration);
 	frameDurationText.setString(frameDurationStr);
 
+	std::optional<Profiler::ZoneStats> slowestZone;
+	for (auto&& zone : Profiler::GetZoneStats())
+	{
+		if (zone.m_name == "Frame") continue;
+		if (!slowestZone || zone.m_percentile95 > slowestZone->m_percentile95)
+		{
+			slowestZone = zone;
+		}
+	}
+	if (slowestZone)
+	{
+		slowestZoneText.setString("Slowest: " + slowestZone->m_name
+			+ " p95 = " + std::to_string(slowestZone->m_percentile95)
+			+ " uS, max = " + std::to_string(slowestZone->m_max) + " uS");
+	}
+
 	int row = 0;
 	for (auto* text : texts)
 	{
@@ -761,7 +781,7 @@ void SFMLManager::RenderWorld(const timeuS& frameDuration)
 
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
@@ -21,6 +21,33 @@ namespace std
 class SFMLManager : public SystemBase
 {
 public:
+	// Owns the window, so every phase stays on the main thread
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::PREPARATION,
+			Reads<ECS_Core::Components::C_ActionPlan>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_WindowInfo>,
+			SystemAccessFlags::MAIN_THREAD>,
+		PhaseAccess<GameLoopPhase::INPUT,
+			Reads<ECS_Core::Components::C_ActionPlan>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_WindowInfo>,
+			SystemAccessFlags::MAIN_THREAD>,
+		PhaseAccess<GameLoopPhase::ACTION,
+			Reads<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_ActionPlan>,
+			Writes<>,
+			SystemAccessFlags::MAIN_THREAD>,
+		PhaseAccess<GameLoopPhase::ACTION_RESPONSE,
+			Reads<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_ActionPlan>,
+			Writes<>,
+			SystemAccessFlags::MAIN_THREAD>,
+		PhaseAccess<GameLoopPhase::RENDER,
+			Reads<ECS_Core::Components::C_TimeTracker, ECS_Core::Components::C_PositionCartesian, ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_ActionPlan>,
+			Writes<ECS_Core::Components::C_SFMLDrawable, ECS_Core::Components::C_UIFrame, ECS_Core::Components::C_WindowInfo>,
+			SystemAccessFlags::MAIN_THREAD>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<>,
+			Writes<ECS_Core::Components::C_UserInputs>,
+			SystemAccessFlags::MAIN_THREAD>>;
+
 	SFMLManager()
 		: SystemBase()
 		, m_window(sf::VideoMode(1600, 900), "Loesby is good at this.")
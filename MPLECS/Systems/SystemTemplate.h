@@ -12,6 +12,10 @@
 class SystemTemplate : public SystemBase
 {
 public:
+	// List the components read and written in every phase the system does work in, see ECS/System.h
+	// Systems without an Access declaration run alone in every phase
+	// using Access = SystemAccess<PhaseAccess<GameLoopPhase::ACTION, Reads<>, Writes<>>>;
+
 	SystemTemplate() : SystemBase() { }
 	virtual ~SystemTemplate() {}
 	virtual void ProgramInit() override;
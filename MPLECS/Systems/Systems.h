@@ -18,6 +18,7 @@
 #include  "DamageApplication.h"
 #include "Education.h"
 #include "Government.h"
+#include "HeadlessSession.h"
 #include "InputTranslation.h"
 #include "Movement.h"
 #include "PopulationGrowth.h"
@@ -56,15 +56,43 @@ void Time::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 			ecs::EntityIndex mI,
 			ECS_Core::Components::C_TimeTracker& time)
 		{
-			if (time.m_paused)
+			using ECS_Core::Components::C_TimeTracker;
+			// Steps the last frame ran out of budget for are still owed
+			time.m_pendingDays += time.m_stepsRemaining * C_TimeTracker::c_stepDays;
+			if (!time.m_paused)
 			{
-				time.m_frameDuration = 0;
+				time.m_pendingDays += 0.000001 * frameDuration * time.m_gameSpeed;
+			}
+			if (time.m_pendingDays > C_TimeTracker::c_maxPendingDays)
+			{
+				time.m_droppedDays += time.m_pendingDays - C_TimeTracker::c_maxPendingDays;
+				time.m_pendingDays = C_TimeTracker::c_maxPendingDays;
 			}
-			else
+			auto steps = static_cast<int>(time.m_pendingDays / C_TimeTracker::c_stepDays);
+			time.m_pendingDays -= steps * C_TimeTracker::c_stepDays;
+			time.m_stepsRemaining = steps;
+			time.m_stepsThisFrame = max(1, steps);
+			time.m_frameDuration = 0;
+			return ecs::IterationBehavior::CONTINUE;
+		});
+		break;
+	case GameLoopPhase::ACTION:
+		// Advance by one simulation step, then adjust timescale, pause/unpause
+	{
+		m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_TimeTracker>([](
+			ecs::EntityIndex mI,
+			ECS_Core::Components::C_TimeTracker& time)
+		{
+			if (time.m_stepsRemaining == 0)
 			{
-				time.m_frameDuration = min(1., 0.000001 * frameDuration * time.m_gameSpeed);
-				time.m_dayProgress += time.m_frameDuration;
+				// Nothing owed this frame, the step only processes commands
+				time.m_frameDuration = 0;
+				return ecs::IterationBehavior::CONTINUE;
 			}
+			--time.m_stepsRemaining;
+			++time.m_stepCount;
+			time.m_frameDuration = ECS_Core::Components::C_TimeTracker::c_stepDays;
+			time.m_dayProgress += time.m_frameDuration;
 			if (time.m_dayProgress >= 1)
 			{
 				time.m_dayProgress -= 1;
@@ -80,10 +108,7 @@ void Time::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 			}
 			return ecs::IterationBehavior::CONTINUE;
 		});
-		break;
-	case GameLoopPhase::ACTION:
-		// Adjust timescale, pause/unpause
-	{
+
 		m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_Planner>([&manager = m_managerRef](
 			const ecs::EntityIndex&,
 			ECS_Core::Components::C_ActionPlan& plan)
@@ -12,6 +12,15 @@
 class Time : public SystemBase
 {
 public:
+	// Advances the clock, and reads the plans that pause or change its speed
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::PREPARATION,
+			Reads<>,
+			Writes<ECS_Core::Components::C_TimeTracker>>,
+		PhaseAccess<GameLoopPhase::ACTION,
+			Reads<ECS_Core::Components::C_ActionPlan>,
+			Writes<ECS_Core::Components::C_TimeTracker>>>;
+
 	Time() : SystemBase() { }
 	virtual ~Time() {}
 	virtual void ProgramInit() override;
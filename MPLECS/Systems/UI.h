@@ -12,6 +12,13 @@
 class UI : public SystemBase
 {
 public:
+	// Reads clicks on the frames, and closes frames in ACTION_RESPONSE
+	using Access = SystemAccess<
+		PhaseAccess<GameLoopPhase::INPUT,
+			Reads<>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_ActionPlan, ECS_Core::Components::C_UIFrame>>,
+		StructuralPhase<GameLoopPhase::ACTION_RESPONSE>>;
+
 	UI() : SystemBase() { }
 	virtual ~UI() {}
 	virtual void ProgramInit() override;
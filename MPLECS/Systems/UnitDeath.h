@@ -12,6 +12,10 @@
 class UnitDeath : public SystemBase
 {
 public:
+	// Kills whatever is out of health or tagged dead, so CLEANUP runs alone
+	using Access = SystemAccess<
+		StructuralPhase<GameLoopPhase::CLEANUP>>;
+
 	UnitDeath() : SystemBase() { }
 	virtual ~UnitDeath() {}
 	virtual void ProgramInit() override;
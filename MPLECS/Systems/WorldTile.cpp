@@ -12,10 +12,13 @@
 
 #include "WorldTile.h"
 
+#include "../Util/CounterRandom.h"
 #include "../Util/Pathing.h"
+#include "../Util/Profiler.h"
 
 #include "../Components/UIComponents.h"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <mutex>
@@ -47,75 +50,13 @@ bool WorldTile::SortByOriginDist::operator()(
 	return false;
 }
 
-TilePosition& TilePosition::operator+=(const TilePosition& other)
-{
-	m_quadrantCoords += other.m_quadrantCoords;
-	m_sectorCoords += other.m_sectorCoords;
-	m_coords += other.m_coords;
-	for (; m_coords.m_x < 0; m_coords.m_x += TileConstants::SECTOR_SIDE_LENGTH, --m_sectorCoords.m_x);
-	for (; m_coords.m_y < 0; m_coords.m_y += TileConstants::SECTOR_SIDE_LENGTH, --m_sectorCoords.m_y);
-	for (; m_sectorCoords.m_x < 0; m_sectorCoords.m_x += TileConstants::QUADRANT_SIDE_LENGTH, --m_quadrantCoords.m_x);
-	for (; m_sectorCoords.m_y < 0; m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH, --m_quadrantCoords.m_y);
-
-	m_sectorCoords.m_x += m_coords.m_x / TileConstants::SECTOR_SIDE_LENGTH;
-	m_sectorCoords.m_y += m_coords.m_y / TileConstants::SECTOR_SIDE_LENGTH;
-	m_coords.m_x %= TileConstants::SECTOR_SIDE_LENGTH;
-	m_coords.m_y %= TileConstants::SECTOR_SIDE_LENGTH;
-
-	m_quadrantCoords.m_x += m_sectorCoords.m_x / TileConstants::QUADRANT_SIDE_LENGTH;
-	m_quadrantCoords.m_y += m_sectorCoords.m_y / TileConstants::QUADRANT_SIDE_LENGTH;
-	m_sectorCoords.m_x %= TileConstants::QUADRANT_SIDE_LENGTH;
-	m_sectorCoords.m_y %= TileConstants::QUADRANT_SIDE_LENGTH;
-	return *this;
-}
-
-TilePosition& TilePosition::operator-=(const TilePosition& other)
-{
-	m_quadrantCoords -= other.m_quadrantCoords;
-	m_sectorCoords -= other.m_sectorCoords;
-	m_coords -= other.m_coords;
-
-	while (m_coords.m_x < 0)
-	{
-		--m_sectorCoords.m_x;
-		m_coords.m_x += TileConstants::SECTOR_SIDE_LENGTH;
-	}
-	while (m_coords.m_y < 0)
-	{
-		--m_sectorCoords.m_y;
-		m_coords.m_y += TileConstants::SECTOR_SIDE_LENGTH;
-	}
-
-	while (m_sectorCoords.m_x < 0)
-	{
-		--m_quadrantCoords.m_x;
-		m_sectorCoords.m_x += TileConstants::QUADRANT_SIDE_LENGTH;
-	}
-	while (m_sectorCoords.m_y < 0)
-	{
-		--m_quadrantCoords.m_y;
-		m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH;
-	}
-	return *this;
-}
-
-void WorldTile::SeedForQuadrant(const CoordinateVector2& coordinates)
-{
-	for (int x = -1; x < 2; ++x)
-	{
-		for (int y = -1; y < 2; ++y)
-		{
-			m_quadrantSeeds[{x + coordinates.m_x, y + coordinates.m_y}];
-		}
-	}
-}
-
-std::vector<WorldTile::SectorSeedPosition> WorldTile::GetRelevantSeeds(
+WorldTile::RelevantSeeds WorldTile::GetRelevantSeeds(
 	const CoordinateVector2 & coordinates,
 	int secX,
 	int secY) const
 {
-	std::vector<SectorSeedPosition> relevantSeeds;
+	RelevantSeeds relevantSeeds;
+	size_t seedCount = 0;
 	CoordinateVector2 quadPosition;
 	CoordinateVector2 secPosition;
 	for (int x = -1; x < 2; ++x)
@@ -157,24 +98,18 @@ std::vector<WorldTile::SectorSeedPosition> WorldTile::GetRelevantSeeds(
 				quadPosition.m_y = coordinates.m_y;
 			}
 
-			auto quad = m_quadrantSeeds.at(quadPosition);
-			auto& seedingSector = quad.m_sectors[secPosition.m_x][secPosition.m_y];
+			auto seedingSector = SeedForSector(quadPosition, secPosition.m_x, secPosition.m_y);
 
-			relevantSeeds.push_back({
+			relevantSeeds[seedCount++] = {
 				seedingSector.m_seedTileType,
 				{ seedingSector.m_seedPosition.m_x + ((x + 1) * TileConstants::SECTOR_SIDE_LENGTH),
 				seedingSector.m_seedPosition.m_y + ((y + 1) * TileConstants::SECTOR_SIDE_LENGTH) }
-				});
+				};
 		}
 	}
 	return relevantSeeds;
 }
 
-f64 RandDouble()
-{
-	return static_cast<f64>(rand()) / static_cast<f64>(RAND_MAX + 1);
-}
-
 template<int SQUARE_SIDE_LENGTH>
 bool WithinSquare(const CoordinateVector2& coords)
 {
@@ -184,24 +119,181 @@ bool WithinSquare(const CoordinateVector2& coords)
 		&& coords.m_y < SQUARE_SIDE_LENGTH;
 }
 
-std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
+namespace
+{
+	constexpr int c_quadrantTiles = TileConstants::QUADRANT_SIDE_LENGTH * TileConstants::SECTOR_SIDE_LENGTH;
+
+	// Separate streams for each use, so adding draws to one doesn't shift the others
+	enum GenerationStream : u32
+	{
+		SECTOR_SEEDS,
+		TILE_TERRAIN,
+		TILE_MOVEMENT_COSTS,
+		STARTING_TILE,
+	};
+
+	// Keyed by where the quadrant is, so it generates the same in any order and on any thread
+	u32 GenerationStreamKey(u32 worldSeed, const CoordinateVector2& quadrantCoords, GenerationStream stream)
+	{
+		auto quadrantKey = CounterRandom::StreamKey(
+			CounterRandom::StreamKey(worldSeed, static_cast<u32>(quadrantCoords.m_x)),
+			static_cast<u32>(quadrantCoords.m_y));
+		return CounterRandom::StreamKey(quadrantKey, stream);
+	}
+
+	u32 SectorStreamKey(u32 worldSeed, const CoordinateVector2& quadrantCoords, GenerationStream stream, s64 secX, s64 secY)
+	{
+		return CounterRandom::StreamKey(
+			GenerationStreamKey(worldSeed, quadrantCoords, stream),
+			static_cast<u32>((secX * TileConstants::QUADRANT_SIDE_LENGTH) + secY));
+	}
+
+	u32 TileIndex(s64 tileX, s64 tileY)
+	{
+		return static_cast<u32>((tileX * TileConstants::SECTOR_SIDE_LENGTH) + tileY);
+	}
+
+	// Drawn from the sector's TILE_MOVEMENT_COSTS stream
+	std::optional<int> GeneratedMovementCost(u32 movementCostStream, u32 tileIndex, u8 tileType)
+	{
+		if (!tileType) // Make type 0 unpathable for testing
+		{
+			return std::nullopt;
+		}
+		return static_cast<int>(
+			CounterRandom::ToRange(CounterRandom::Draw(movementCostStream, tileIndex), 6)) + 1;
+	}
+
+	// RGBA of each tile type, bit 0 of the type turns on red, bit 1 green, bit 2 blue
+	constexpr std::array<sf::Uint32, TileConstants::TILE_TYPE_COUNT> MakeTileTypePalette()
+	{
+		std::array<sf::Uint32, TileConstants::TILE_TYPE_COUNT> palette{};
+		for (int tileType = 0; tileType < TileConstants::TILE_TYPE_COUNT; ++tileType)
+		{
+			palette[tileType] =
+				(((tileType & 1) ? 255u : 0u) << 0) + // R
+				(((tileType & 2) ? 255u : 0u) << 8) + // G
+				(((tileType & 4) ? 255u : 0u) << 16) + // B
+				(0xFFu << 24); // A
+		}
+		return palette;
+	}
+	constexpr auto c_tileTypePalette = MakeTileTypePalette();
+
+	// value^Exponent by repeated squaring, pow() doesn't know its exponent is a small integer
+	template <unsigned Exponent>
+	constexpr f64 IntegerPower(f64 value)
+	{
+		if constexpr (Exponent == 0)
+		{
+			return 1.;
+		}
+		else
+		{
+			auto half = IntegerPower<Exponent / 2>(value);
+			return (Exponent % 2) ? half * half * value : half * half;
+		}
+	}
+
+	// Rounds toward negative infinity, so tiles left of or above the world origin land in the right quadrant
+	s64 FloorDivide(s64 value, s64 divisor)
+	{
+		return value / divisor - ((value % divisor) < 0 ? 1 : 0);
+	}
+
+	// Tiles counted from the world origin, so positions in different quadrants can be compared
+	CoordinateVector2 GlobalTileCoordinates(const TilePosition& position)
+	{
+		return position.m_quadrantCoords * c_quadrantTiles
+			+ position.m_sectorCoords * TileConstants::SECTOR_SIDE_LENGTH
+			+ position.m_coords;
+	}
+
+	TilePosition TilePositionAt(const CoordinateVector2& globalCoordinates)
+	{
+		CoordinateVector2 quadrantCoords(
+			FloorDivide(globalCoordinates.m_x, c_quadrantTiles),
+			FloorDivide(globalCoordinates.m_y, c_quadrantTiles));
+		auto withinQuadrant = globalCoordinates - quadrantCoords * c_quadrantTiles;
+		return {
+			quadrantCoords,
+			{ withinQuadrant.m_x / TileConstants::SECTOR_SIDE_LENGTH, withinQuadrant.m_y / TileConstants::SECTOR_SIDE_LENGTH },
+			{ withinQuadrant.m_x % TileConstants::SECTOR_SIDE_LENGTH, withinQuadrant.m_y % TileConstants::SECTOR_SIDE_LENGTH } };
+	}
+}
+
+void WorldTile::WaitForGeneration(std::future<void>& task)
+{
+	if (m_generationPool.isWorkerThread())
+	{
+		// Picks up queued generation work meanwhile, so a pool full of waiting tasks still gets through
+		m_generationPool.waitUntil([&task]() {
+			return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		});
+	}
+	task.get();
+}
+
+void WorldTile::WaitForGeneration(const std::shared_future<void>& task)
+{
+	if (m_generationPool.isWorkerThread())
+	{
+		m_generationPool.waitUntil([&task]() {
+			return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		});
+	}
+	task.get();
+}
+
+void WorldTile::WaitForGeneration(std::vector<std::future<void>>& tasks)
+{
+	for (auto&& task : tasks)
+	{
+		WaitForGeneration(task);
+	}
+	tasks.clear();
+}
+
+WorldTile::SectorSeed WorldTile::SeedForSector(
+	const CoordinateVector2& quadrantCoords,
+	s64 secX,
+	s64 secY) const
+{
+	using namespace TileConstants;
+	// Neighbouring sectors read each other's seeds, this gives them the same one without storing it
+	auto stream = SectorStreamKey(m_worldSeed, quadrantCoords, SECTOR_SEEDS, secX, secY);
+	return {
+		static_cast<int>(CounterRandom::ToRange(CounterRandom::Draw(stream, 0), TILE_TYPE_COUNT)),
+		{
+			static_cast<s64>(CounterRandom::ToRange(CounterRandom::Draw(stream, 1), SECTOR_SIDE_LENGTH)),
+			static_cast<s64>(CounterRandom::ToRange(CounterRandom::Draw(stream, 2), SECTOR_SIDE_LENGTH))
+		} };
+}
+
+std::shared_future<void> WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 {
-	srand(static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
 	using namespace TileConstants;
-	if (m_spawnedQuadrants.find(coordinates)
-		!= m_spawnedQuadrants.end())
+	// The placeholder goes in with its task under one lock, so a second spawn of the same quadrant waits on the first
+	std::lock_guard<std::mutex> mapLock(m_quadrantMapMutex);
+	auto [quadrantIter, inserted] = m_spawnedQuadrants.try_emplace(coordinates);
+	auto& quadrant = quadrantIter->second;
+	if (!inserted)
 	{
-		// Quadrant is already here
-		return std::thread([]() {});
+		// Quadrant is already here, or on its way
+		return quadrant.m_spawned;
 	}
 
-	return std::thread([&manager = m_managerRef, coordinates, this]() {
-		auto index = manager.createHandle();
+	quadrant.m_spawned = m_generationPool.submit([&manager = m_managerRef, &quadrant, coordinates, this]() {
+		PROFILE_ZONE("WorldTile::SpawnQuadrant");
+		// This runs off the main thread, so the quadrant entity is recorded
+		// and only created when the manager plays the commands back on refresh
+		ECS_Core::CommandBuffer commands;
+		auto index = commands.create();
 		auto quadrantSideLength = QUADRANT_SIDE_LENGTH * SECTOR_SIDE_LENGTH * TILE_SIDE_LENGTH;
-		manager.addComponent<ECS_Core::Components::C_QuadrantPosition>(
+		commands.addComponent<ECS_Core::Components::C_QuadrantPosition>(
 			index,
 			coordinates);
-		manager.addComponent<ECS_Core::Components::C_PositionCartesian>(
+		commands.addComponent<ECS_Core::Components::C_PositionCartesian>(
 			index,
 			static_cast<f64>(BASE_QUADRANT_ORIGIN_COORDINATE +
 			(quadrantSideLength * coordinates.m_x)),
@@ -212,249 +304,233 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 		auto rect = std::make_shared<sf::RectangleShape>(sf::Vector2f(
 			static_cast<float>(quadrantSideLength),
 			static_cast<float>(quadrantSideLength)));
-		auto& quadrant = m_spawnedQuadrants[coordinates];
-		SeedForQuadrant(coordinates);
-		quadrant.m_texture.create(quadrantSideLength, quadrantSideLength);
-		std::mutex textureUpdateMutex, randomMutex;
-		std::vector<std::thread> tileCreationThreads;
-		for (auto secX = 0; secX < TileConstants::QUADRANT_SIDE_LENGTH; ++secX)
+		// The whole quadrant's pixels, uploaded in one go once every sector has filled in its part
+		// Sectors write disjoint regions, so they don't need to lock it
+		std::vector<sf::Uint32> quadrantPixels;
+		if (!m_headless)
 		{
-			for (auto secY = 0; secY < TileConstants::QUADRANT_SIDE_LENGTH; ++secY)
-			{
-				tileCreationThreads.emplace_back(
-					[secY, secX, &coordinates, &textureUpdateMutex, &randomMutex, &quadrant, this]() {
-				auto& sector = quadrant.m_sectors[secX][secY];
+			quadrant.m_texture.create(quadrantSideLength, quadrantSideLength);
+			quadrantPixels.resize(static_cast<size_t>(quadrantSideLength) * quadrantSideLength);
+		}
+		auto createTiles = [&coordinates, &quadrantPixels, quadrantSideLength, &quadrant, this](int secX, int secY) {
+			auto& sector = quadrant.m_sectors[secX][secY];
+
+			auto relevantSeeds = GetRelevantSeeds(coordinates, secX, secY);
+			// Each tile draws from its own counter, so no tile waits on another for random numbers
+			auto terrainStream = SectorStreamKey(m_worldSeed, coordinates, TILE_TERRAIN, secX, secY);
+			auto movementCostStream = SectorStreamKey(m_worldSeed, coordinates, TILE_MOVEMENT_COSTS, secX, secY);
+			for (auto tileX = 0; tileX < TileConstants::SECTOR_SIDE_LENGTH; ++tileX)
+			{
+				// Pick a seed
+				// Will be chosen by weighted random, based on distance from nearest 9 seeds
+				// Seeds are from local sector, and the 8 adjacent and corner-adj sectors
+				// Every tile in the column weighs the same seeds, so one seed at a time is weighed for the whole column
+				// Those inner loops have no branches and no calls, so they vectorize
+				f64 weightBorders[c_relevantSeedCount][SECTOR_SIDE_LENGTH];
+				f64 totalWeights[SECTOR_SIDE_LENGTH] = {};
+				for (int seedIndex = 0; seedIndex < c_relevantSeedCount; ++seedIndex)
+				{
+					auto& seedPosition = relevantSeeds[seedIndex].m_position;
+					auto xOffset = static_cast<f64>(tileX + SECTOR_SIDE_LENGTH - seedPosition.m_x);
+					auto yOffsetBase = static_cast<f64>(SECTOR_SIDE_LENGTH - seedPosition.m_y);
+					for (auto tileY = 0; tileY < SECTOR_SIDE_LENGTH; ++tileY)
+					{
+						auto yOffset = yOffsetBase + tileY;
+						auto distance = (xOffset * xOffset) + (yOffset * yOffset);
+						weightBorders[seedIndex][tileY] = totalWeights[tileY] += 100. / IntegerPower<10>(distance);
+					}
+				}
 
-				auto relevantSeeds = GetRelevantSeeds(coordinates, secX, secY);
-				assert(relevantSeeds.size() > 0);
-				std::optional<int> movementCosts[SECTOR_SIDE_LENGTH][SECTOR_SIDE_LENGTH];
-				for (auto tileX = 0; tileX < TileConstants::SECTOR_SIDE_LENGTH; ++tileX)
+				for (auto tileY = 0; tileY < TileConstants::SECTOR_SIDE_LENGTH; ++tileY)
 				{
-					for (auto tileY = 0; tileY < TileConstants::SECTOR_SIDE_LENGTH; ++tileY)
+					auto& tile = sector.m_tiles[tileX][tileY];
+					auto tileIndex = TileIndex(tileX, tileY);
+					auto weightedValue = CounterRandom::ToUnitDouble(CounterRandom::Draw(terrainStream, tileIndex)) * totalWeights[tileY];
+					size_t weightedPosition = 0;
+					for (; weightedPosition < relevantSeeds.size(); ++weightedPosition)
 					{
-							auto& tile = sector.m_tiles[tileX][tileY];
-							// Pick a seed
-							// Will be chosen by weighted random, based on distance from nearest 9 seeds
-							// Seeds are from local sector, and the 8 adjacent and corner-adj sectors
-							auto locationForSeeding = CoordinateVector2(
-								tileX + TileConstants::SECTOR_SIDE_LENGTH,
-								tileY + TileConstants::SECTOR_SIDE_LENGTH);
-
-							std::vector<f64> weightBorders;
-							f64 totalWeight = 0;
-							for (auto&& seed : relevantSeeds)
-							{
-								f64 distance = static_cast<f64>(
-									(locationForSeeding - seed.m_position).MagnitudeSq());
-								weightBorders.push_back(totalWeight += 100. / pow(distance, 10));
-							}
-
-							auto weightedValue = RandDouble() * totalWeight;
-							size_t weightedPosition = 0;
-							for (; weightedPosition < weightBorders.size(); ++weightedPosition)
-							{
-								if (weightedValue < weightBorders[weightedPosition])
-								{
-									break;
-								}
-							}
-							// If we get 1.0, it won't be less (probably) so just use that edge
-							// No huge effect
-							if (weightedPosition >= relevantSeeds.size()) weightedPosition = relevantSeeds.size() - 1;
-							tile.m_tileType = relevantSeeds[weightedPosition].m_type;
-							if (tile.m_tileType) // Make type 0 unpathable for testing
-							{
-								std::lock_guard randomLock(randomMutex);
-								tile.m_movementCost = (rand() % 6) + 1;
-								movementCosts[tileX][tileY] = tile.m_movementCost;
-							}
-							for (auto& pixel : tile.m_tilePixels)
-							{
-								pixel =
-									(((tile.m_tileType & 1) ? 255 : 0) << 0) + // R
-									(((tile.m_tileType & 2) ? 255 : 0) << 8) + // G
-									(((tile.m_tileType & 4) ? 255 : 0) << 16) + // B
-									+(0xFF << 24); // A
-							}
-							{
-								std::lock_guard textureLock(textureUpdateMutex);
-								quadrant.m_texture.update(
-									reinterpret_cast<const sf::Uint8*>(tile.m_tilePixels._Elems),
-									TILE_SIDE_LENGTH,
-									TILE_SIDE_LENGTH,
-									((secX * SECTOR_SIDE_LENGTH) + tileX) * TILE_SIDE_LENGTH,
-									((secY * SECTOR_SIDE_LENGTH) + tileY) * TILE_SIDE_LENGTH);
-							}
+						if (weightedValue < weightBorders[weightedPosition][tileY])
+						{
+							break;
 						}
 					}
-				});
-			}
-		}
-		for (auto&& thread : tileCreationThreads)
-		{
-			thread.join();
-		}
-		rect->setTexture(&quadrant.m_texture);
-		auto& drawable = manager.addComponent<ECS_Core::Components::C_SFMLDrawable>(index);
-		drawable.m_drawables[ECS_Core::Components::DrawLayer::TERRAIN][static_cast<u64>(DrawPriority::LANDSCAPE)].push_back({ rect,{ 0,0 } });
-
-		// Threads to fill in movement costs in the sector data
-		std::vector<std::thread> movementFillThreads;
-		for (int sectorI = 0; sectorI < QUADRANT_SIDE_LENGTH; ++sectorI)
-		{
-			for (int sectorJ = 0; sectorJ < QUADRANT_SIDE_LENGTH; ++sectorJ)
-			{
-				auto& sector = quadrant.m_sectors[sectorI][sectorJ];
-				movementFillThreads.emplace_back([&sector]() {
-					for (int i = 0; i < SECTOR_SIDE_LENGTH; ++i)
+					// If we get 1.0, it won't be less (probably) so just use that edge
+					// No huge effect
+					if (weightedPosition >= relevantSeeds.size()) weightedPosition = relevantSeeds.size() - 1;
+					tile.m_tileType = static_cast<u8>(relevantSeeds[weightedPosition].m_type);
+					tile.m_movementCost = GeneratedMovementCost(movementCostStream, tileIndex, tile.m_tileType);
+					sector.m_tileMovementCosts[tileX][tileY] = tile.m_movementCost;
+					if (!m_headless)
 					{
-						for (int j = 0; j < SECTOR_SIDE_LENGTH; ++j)
+						auto pixelX = ((secX * SECTOR_SIDE_LENGTH) + tileX) * TILE_SIDE_LENGTH;
+						auto pixelY = ((secY * SECTOR_SIDE_LENGTH) + tileY) * TILE_SIDE_LENGTH;
+						for (int row = 0; row < TILE_SIDE_LENGTH; ++row)
 						{
-							sector.m_tileMovementCosts[i][j] = sector.m_tiles[i][j].m_movementCost;
+							std::fill_n(
+								quadrantPixels.begin() + ((static_cast<size_t>(pixelY) + row) * quadrantSideLength) + pixelX,
+								TILE_SIDE_LENGTH,
+								c_tileTypePalette[tile.m_tileType]);
 						}
 					}
-				});
+				}
 			}
-		}
-		for (auto&& thread : movementFillThreads)
-		{
-			thread.join();
-		}
+		};
 
 		// Starting in the middle of each sector, find the nearest (by movement cost)
 		// edge tile on each edge
-		std::vector<std::thread> borderThreads;
+		auto findBorderCandidates = [&quadrant](int sectorI, int sectorJ) {
+			auto& sector = quadrant.m_sectors[sectorI][sectorJ];
 
-		for (int sectorI = 0; sectorI < QUADRANT_SIDE_LENGTH; ++sectorI)
-		{
-			for (int sectorJ = 0; sectorJ < QUADRANT_SIDE_LENGTH; ++sectorJ)
+			// Select a tile in the middle of the sector
+			auto midpoint = []() constexpr -> s64 {
+				if constexpr(SECTOR_SIDE_LENGTH % 2 == 0)
+				{
+					return SECTOR_SIDE_LENGTH / 2 - 1;
+				}
+				else
+				{
+					return SECTOR_SIDE_LENGTH / 2;
+				}
+			}();
+			// Spiral out, until a moveable tile is found
+			int xOffset = 0;
+			int yOffset = 0;
+			int nextXChange = 0;
+			int nextYChange = -1;
+			for (int i = 0; i < SECTOR_SIDE_LENGTH * SECTOR_SIDE_LENGTH; ++i, xOffset += nextXChange, yOffset += nextYChange)
 			{
-				borderThreads.emplace_back([sectorI, sectorJ, &quadrant]() {
-					auto& sector = quadrant.m_sectors[sectorI][sectorJ];
+				if (sector.m_tileMovementCosts[midpoint + xOffset][midpoint + yOffset])
+				{
+					auto centerTileCoords = CoordinateVector2{ midpoint + xOffset, midpoint + yOffset };
 
-					// Select a tile in the middle of the sector
-					auto midpoint = []() constexpr -> s64 {
-						if constexpr(SECTOR_SIDE_LENGTH % 2 == 0)
-						{
-							return SECTOR_SIDE_LENGTH / 2 - 1;
-						}
-						else
+					// Expand out from selected center tile, ordered by movement cost to point
+					bool visited[SECTOR_SIDE_LENGTH][SECTOR_SIDE_LENGTH];
+					for (int i = 0; i < SECTOR_SIDE_LENGTH; ++i)
+					{
+						for (int j = 0; j < SECTOR_SIDE_LENGTH; ++j)
 						{
-							return SECTOR_SIDE_LENGTH / 2;
+							visited[i][j] = false;
 						}
-					}();
-					// Spiral out, until a moveable tile is found
-					int xOffset = 0;
-					int yOffset = 0;
-					int nextXChange = 0;
-					int nextYChange = -1;
-					for (int i = 0; i < SECTOR_SIDE_LENGTH * SECTOR_SIDE_LENGTH; ++i, xOffset += nextXChange, yOffset += nextYChange)
+					}
+					std::map<s64, std::vector<CoordinateVector2>> openTiles;
+					openTiles[0].push_back(centerTileCoords);
+
+					while (openTiles.size())
 					{
-						if (sector.m_tileMovementCosts[midpoint + xOffset][midpoint + yOffset])
+						auto iter = openTiles.begin();
+						auto& tile = iter->second.front();
+						if (visited[tile.m_x][tile.m_y])
 						{
-							auto centerTileCoords = CoordinateVector2{ midpoint + xOffset, midpoint + yOffset };
-
-							// Expand out from selected center tile, ordered by movement cost to point
-							bool visited[SECTOR_SIDE_LENGTH][SECTOR_SIDE_LENGTH];
-							for (int i = 0; i < SECTOR_SIDE_LENGTH; ++i)
+							iter->second.erase(iter->second.begin());
+							if (iter->second.size() == 0)
 							{
-								for (int j = 0; j < SECTOR_SIDE_LENGTH; ++j)
-								{
-									visited[i][j] = false;
-								}
+								openTiles.erase(iter->first);
 							}
-							std::map<s64, std::vector<CoordinateVector2>> openTiles;
-							openTiles[0].push_back(centerTileCoords);
-
-							while (openTiles.size())
-							{
-								auto iter = openTiles.begin();
-								auto& tile = iter->second.front();
-								if (visited[tile.m_x][tile.m_y])
-								{
-									iter->second.erase(iter->second.begin());
-									if (iter->second.size() == 0)
-									{
-										openTiles.erase(iter->first);
-									}
-									continue;
-								}
-								visited[tile.m_x][tile.m_y] = true;
-								if (tile.m_y == 0)
-								{
-									sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::NORTH)][iter->first].push_back(tile.m_x);
-								}
-								if (tile.m_y == SECTOR_SIDE_LENGTH - 1)
-								{
-									sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::SOUTH)][iter->first].push_back(tile.m_x);
-								}
-								if (tile.m_x == SECTOR_SIDE_LENGTH - 1)
-								{
-									sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::EAST)][iter->first].push_back(tile.m_y);
-								}
-								if (tile.m_x == 0)
-								{
-									sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::WEST)][iter->first].push_back(tile.m_y);
-								}
+							continue;
+						}
+						visited[tile.m_x][tile.m_y] = true;
+						if (tile.m_y == 0)
+						{
+							sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::NORTH)][iter->first].push_back(tile.m_x);
+						}
+						if (tile.m_y == SECTOR_SIDE_LENGTH - 1)
+						{
+							sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::SOUTH)][iter->first].push_back(tile.m_x);
+						}
+						if (tile.m_x == SECTOR_SIDE_LENGTH - 1)
+						{
+							sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::EAST)][iter->first].push_back(tile.m_y);
+						}
+						if (tile.m_x == 0)
+						{
+							sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::WEST)][iter->first].push_back(tile.m_y);
+						}
 
-								auto northNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::NORTH)];
-								if (WithinSquare<SECTOR_SIDE_LENGTH>(northNext) && sector.m_tileMovementCosts[northNext.m_x][northNext.m_y]
-									&& !visited[northNext.m_x][northNext.m_y])
-								{
-									openTiles[*sector.m_tileMovementCosts[northNext.m_x][northNext.m_y] + iter->first].push_back(northNext);
-								}
+						auto northNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::NORTH)];
+						if (WithinSquare<SECTOR_SIDE_LENGTH>(northNext) && sector.m_tileMovementCosts[northNext.m_x][northNext.m_y]
+							&& !visited[northNext.m_x][northNext.m_y])
+						{
+							openTiles[*sector.m_tileMovementCosts[northNext.m_x][northNext.m_y] + iter->first].push_back(northNext);
+						}
 
-								auto southNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::SOUTH)];
-								if (WithinSquare<SECTOR_SIDE_LENGTH>(southNext) && sector.m_tileMovementCosts[southNext.m_x][southNext.m_y]
-									&& !visited[southNext.m_x][southNext.m_y])
-								{
-									openTiles[*sector.m_tileMovementCosts[southNext.m_x][southNext.m_y] + iter->first].push_back(southNext);
-								}
+						auto southNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::SOUTH)];
+						if (WithinSquare<SECTOR_SIDE_LENGTH>(southNext) && sector.m_tileMovementCosts[southNext.m_x][southNext.m_y]
+							&& !visited[southNext.m_x][southNext.m_y])
+						{
+							openTiles[*sector.m_tileMovementCosts[southNext.m_x][southNext.m_y] + iter->first].push_back(southNext);
+						}
 
-								auto eastNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::EAST)];
-								if (WithinSquare<SECTOR_SIDE_LENGTH>(eastNext) && sector.m_tileMovementCosts[eastNext.m_x][eastNext.m_y]
-									&& !visited[eastNext.m_x][eastNext.m_y])
-								{
-									openTiles[*sector.m_tileMovementCosts[eastNext.m_x][eastNext.m_y] + iter->first].push_back(eastNext);
-								}
+						auto eastNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::EAST)];
+						if (WithinSquare<SECTOR_SIDE_LENGTH>(eastNext) && sector.m_tileMovementCosts[eastNext.m_x][eastNext.m_y]
+							&& !visited[eastNext.m_x][eastNext.m_y])
+						{
+							openTiles[*sector.m_tileMovementCosts[eastNext.m_x][eastNext.m_y] + iter->first].push_back(eastNext);
+						}
 
-								auto westNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::WEST)];
-								if (WithinSquare<SECTOR_SIDE_LENGTH>(westNext) && sector.m_tileMovementCosts[westNext.m_x][westNext.m_y]
-									&& !visited[westNext.m_x][westNext.m_y])
-								{
-									openTiles[*sector.m_tileMovementCosts[westNext.m_x][westNext.m_y] + iter->first].push_back(westNext);
-								}
-								iter->second.erase(iter->second.begin());
-								if (iter->second.size() == 0)
-								{
-									openTiles.erase(iter->first);
-								}
-							}
-							if (sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::NORTH)].size()
-								|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::SOUTH)].size()
-								|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::EAST)].size()
-								|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::WEST)].size())
-							{
-								// First time we find a way to the edge, keep it
-								return;
-							}
+						auto westNext = tile + Pathing::neighborOffsets[static_cast<u8>(PathingDirection::WEST)];
+						if (WithinSquare<SECTOR_SIDE_LENGTH>(westNext) && sector.m_tileMovementCosts[westNext.m_x][westNext.m_y]
+							&& !visited[westNext.m_x][westNext.m_y])
+						{
+							openTiles[*sector.m_tileMovementCosts[westNext.m_x][westNext.m_y] + iter->first].push_back(westNext);
 						}
-						if (xOffset == yOffset || (xOffset < 0 && (xOffset == -yOffset)) || (xOffset > 0 && xOffset == 1 - yOffset))
+						iter->second.erase(iter->second.begin());
+						if (iter->second.size() == 0)
 						{
-							std::swap(nextXChange, nextYChange);
-							nextXChange = -nextXChange;
+							openTiles.erase(iter->first);
 						}
 					}
-				});
+					if (sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::NORTH)].size()
+						|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::SOUTH)].size()
+						|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::EAST)].size()
+						|| sector.m_pathingBorderTileCandidates[static_cast<u8>(PathingDirection::WEST)].size())
+					{
+						// First time we find a way to the edge, keep it
+						return;
+					}
+				}
+				if (xOffset == yOffset || (xOffset < 0 && (xOffset == -yOffset)) || (xOffset > 0 && xOffset == 1 - yOffset))
+				{
+					std::swap(nextXChange, nextYChange);
+					nextXChange = -nextXChange;
+				}
 			}
-		}
-		for (auto&& thread : borderThreads)
+		};
+
+		// A sector's tiles, movement costs and edge candidates only depend on that sector,
+		// so each sector runs through all three without waiting on the others
+		m_generationPool.parallelFor(QUADRANT_SIDE_LENGTH * QUADRANT_SIDE_LENGTH, 1,
+			[&createTiles, &findBorderCandidates](size_t begin, size_t end) {
+			for (auto sectorIndex = begin; sectorIndex < end; ++sectorIndex)
+			{
+				auto sectorI = static_cast<int>(sectorIndex / QUADRANT_SIDE_LENGTH);
+				auto sectorJ = static_cast<int>(sectorIndex % QUADRANT_SIDE_LENGTH);
+				createTiles(sectorI, sectorJ);
+				findBorderCandidates(sectorI, sectorJ);
+			}
+		});
+		if (!m_headless)
 		{
-			// Make sure all finish before we start finding paths
-			thread.join();
+			quadrant.m_texture.update(reinterpret_cast<const sf::Uint8*>(quadrantPixels.data()));
+			quadrantPixels = {};
+			rect->setTexture(&quadrant.m_texture);
 		}
+		ECS_Core::Components::C_SFMLDrawable drawable;
+		drawable.m_drawables[ECS_Core::Components::DrawLayer::TERRAIN][static_cast<u64>(DrawPriority::LANDSCAPE)].push_back({ rect,{ 0,0 } });
+		commands.addComponent<ECS_Core::Components::C_SFMLDrawable>(index, std::move(drawable));
+		manager.submit(std::move(commands));
+
+		// Shared borders need the candidates of both sectors
+		// The path searches read the neighbors' border tiles, so they're only changed under the lock
+		std::unique_lock<std::shared_mutex> borderLock(m_pathingDataMutex);
+		auto findNeighbor = [&coordinates, this](PathingDirection direction) {
+			std::lock_guard<std::mutex> mapLock(m_quadrantMapMutex);
+			return m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(direction)]);
+		};
+		auto northQuadrantIter = findNeighbor(PathingDirection::NORTH);
+		auto southQuadrantIter = findNeighbor(PathingDirection::SOUTH);
+		auto eastQuadrantIter = findNeighbor(PathingDirection::EAST);
+		auto westQuadrantIter = findNeighbor(PathingDirection::WEST);
 
-		std::vector<std::thread> borderSelectionThreads;
 		for (int sectorI = 0; sectorI < QUADRANT_SIDE_LENGTH; ++sectorI)
 		{
 			for (int sectorJ = 0; sectorJ < QUADRANT_SIDE_LENGTH - 1; ++sectorJ)
@@ -483,7 +559,6 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 				}
 			}
 
-			auto westQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::WEST)]);
 			if (westQuadrantIter == m_spawnedQuadrants.end())
 			{
 				auto& sector = quadrant.m_sectors[0][sectorI];
@@ -506,7 +581,6 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 				}
 			}
 
-			auto eastQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::EAST)]);
 			if (eastQuadrantIter == m_spawnedQuadrants.end())
 			{
 				auto& eastSector = quadrant.m_sectors[QUADRANT_SIDE_LENGTH - 1][sectorI];
@@ -529,7 +603,6 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 				}
 			}
 
-			auto northQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::NORTH)]);
 			if (northQuadrantIter == m_spawnedQuadrants.end())
 			{
 				auto& northSector = quadrant.m_sectors[sectorI][0];
@@ -552,7 +625,6 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 				}
 			}
 
-			auto southQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::SOUTH)]);
 			if (southQuadrantIter == m_spawnedQuadrants.end())
 			{
 				auto& southSector = quadrant.m_sectors[sectorI][QUADRANT_SIDE_LENGTH - 1];
@@ -575,19 +647,16 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 				}
 			}
 		}
+		borderLock.unlock();
 
-		std::vector<std::thread> sectorPathFindingThreads;
-		auto northQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::NORTH)]);
-		auto southQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::SOUTH)]);
-		auto eastQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::EAST)]);
-		auto westQuadrantIter = m_spawnedQuadrants.find(coordinates + Pathing::neighborOffsets[static_cast<int>(PathingDirection::WEST)]);
+		std::vector<std::future<void>> sectorPathFindingTasks;
 		for (int sectorI = 0; sectorI < QUADRANT_SIDE_LENGTH; ++sectorI)
 		{
 			for (int sectorJ = 0; sectorJ < QUADRANT_SIDE_LENGTH; ++sectorJ)
 			{
 				FillSectorPathing(
 					quadrant.m_sectors[sectorI][sectorJ],
-					sectorPathFindingThreads,
+					sectorPathFindingTasks,
 					quadrant,
 					sectorI,
 					sectorJ);				
@@ -597,7 +666,7 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 			{
 				FillSectorPathing(
 					northQuadrantIter->second.m_sectors[sectorI][QUADRANT_SIDE_LENGTH - 1],
-					sectorPathFindingThreads,
+					sectorPathFindingTasks,
 					northQuadrantIter->second,
 					sectorI,
 					QUADRANT_SIDE_LENGTH - 1);
@@ -607,7 +676,7 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 			{
 				FillSectorPathing(
 					southQuadrantIter->second.m_sectors[sectorI][0],
-					sectorPathFindingThreads,
+					sectorPathFindingTasks,
 					southQuadrantIter->second,
 					sectorI,
 					0);
@@ -617,7 +686,7 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 			{
 				FillSectorPathing(
 					eastQuadrantIter->second.m_sectors[0][sectorI],
-					sectorPathFindingThreads,
+					sectorPathFindingTasks,
 					eastQuadrantIter->second,
 					0,
 					sectorI);
@@ -627,22 +696,28 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 			{
 				FillSectorPathing(
 					westQuadrantIter->second.m_sectors[QUADRANT_SIDE_LENGTH - 1][sectorI],
-					sectorPathFindingThreads,
+					sectorPathFindingTasks,
 					westQuadrantIter->second,
 					QUADRANT_SIDE_LENGTH - 1,
 					sectorI);
 			}
 		}
-		for (auto&& thread : sectorPathFindingThreads)
+		WaitForGeneration(sectorPathFindingTasks);
+
+		// Sector crossings are settled, the neighbors' border crossings may have changed too
+		BuildQuadrantLandmarks(quadrant);
+		for (auto&& neighborIter : { northQuadrantIter, southQuadrantIter, eastQuadrantIter, westQuadrantIter })
 		{
-			thread.join();
+			if (neighborIter != m_spawnedQuadrants.end())
+			{
+				BuildQuadrantLandmarks(neighborIter->second);
+			}
 		}
 
 		FillQuadrantPathingEdges(quadrant);
 
-		static std::mutex sectorSelectionMutex;
 		{
-			std::lock_guard<std::mutex> lock(sectorSelectionMutex);
+			std::unique_lock<std::shared_mutex> lock(m_pathingDataMutex);
 			//Select border sectors for this quadrant, update border sectors for existing border sectors
 			if (northQuadrantIter == m_spawnedQuadrants.end())
 			{
@@ -711,68 +786,100 @@ std::thread WorldTile::SpawnQuadrant(const CoordinateVector2& coordinates)
 					eastQuadrantIter->second.m_pathingBorderSectors[static_cast<int>(PathingDirection::WEST)] = *borderSector;
 				}
 			}
-
-			// Now fill in pathing for each quadrant which was touched
-			FillCrossQuadrantPaths(quadrant, coordinates);
-			if (northQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(northQuadrantIter->second, northQuadrantIter->first); }
-			if (eastQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(eastQuadrantIter->second, eastQuadrantIter->first); }
-			if (southQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(southQuadrantIter->second, southQuadrantIter->first); }
-			if (westQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(westQuadrantIter->second, westQuadrantIter->first); }
 		}
+
+		// Now fill in pathing for each quadrant which was touched
+		FillCrossQuadrantPaths(quadrant, coordinates);
+		if (northQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(northQuadrantIter->second, northQuadrantIter->first); }
+		if (eastQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(eastQuadrantIter->second, eastQuadrantIter->first); }
+		if (southQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(southQuadrantIter->second, southQuadrantIter->first); }
+		if (westQuadrantIter != m_spawnedQuadrants.end()) { FillCrossQuadrantPaths(westQuadrantIter->second, westQuadrantIter->first); }
 		quadrant.m_spawningComplete = true;
-	});
+	}).share();
+	return quadrant.m_spawned;
 }
 
 void WorldTile::FillSectorPathing(
 	Sector& sector,
-	std::vector<std::thread>& pathFindingThreads,
+	std::vector<std::future<void>>& pathFindingTasks,
 	Quadrant& quadrant,
 	int sectorI,
 	int sectorJ)
 {
-	for (int sourceSide = static_cast<int>(PathingDirection::NORTH); sourceSide < static_cast<int>(PathingDirection::_COUNT); ++sourceSide)
-	{
-		for (int targetSide = static_cast<int>(PathingDirection::NORTH); targetSide < static_cast<int>(PathingDirection::_COUNT); ++targetSide)
-		{
-			if (sourceSide == targetSide
-				|| !sector.m_pathingBorderTiles[sourceSide]
-				|| !sector.m_pathingBorderTiles[targetSide])
+	// Every crossing of the sector is searched in the one task, and they're swapped in together
+	pathFindingTasks.push_back(m_generationPool.submit([&sector, &quadrant, sectorI, sectorJ, this]() {
+		auto GetSideTile = [](auto side, auto index) -> CoordinateVector2 {
+			switch (side)
 			{
-				continue;
+			case PathingDirection::NORTH: return { index, 0 };
+			case PathingDirection::SOUTH: return { index, TileConstants::SECTOR_SIDE_LENGTH - 1 };
+			case PathingDirection::EAST: return { TileConstants::SECTOR_SIDE_LENGTH - 1, index };
+			case PathingDirection::WEST: return { 0, index };
 			}
+			return {};
+		};
+		auto crossings = std::make_shared<Quadrant::SectorCrossings>();
+		{
+			// Another quadrant spawning next to this one may be moving the sector's border tiles
+			std::shared_lock<std::shared_mutex> lock(m_pathingDataMutex);
+			for (int sourceSide = static_cast<int>(PathingDirection::NORTH); sourceSide < static_cast<int>(PathingDirection::_COUNT); ++sourceSide)
+			{
+				for (int targetSide = static_cast<int>(PathingDirection::NORTH); targetSide < static_cast<int>(PathingDirection::_COUNT); ++targetSide)
+				{
+					if (sourceSide == targetSide
+						|| !sector.m_pathingBorderTiles[sourceSide]
+						|| !sector.m_pathingBorderTiles[targetSide])
+					{
+						continue;
+					}
 
-			pathFindingThreads.emplace_back([&sector, sourceSide, targetSide, &quadrant, sectorI, sectorJ]() {
-				auto GetSideTile = [](auto side, auto index) -> CoordinateVector2 {
-					switch (side)
+					auto path = Pathing::GetPath(
+						sector.m_tileMovementCosts,
+						GetSideTile(sourceSide, *sector.m_pathingBorderTiles[sourceSide]),
+						GetSideTile(targetSide, *sector.m_pathingBorderTiles[targetSide]));
+					if (path)
 					{
-					case PathingDirection::NORTH: return { index, 0 };
-					case PathingDirection::SOUTH: return { index, TileConstants::SECTOR_SIDE_LENGTH - 1 };
-					case PathingDirection::EAST: return { TileConstants::SECTOR_SIDE_LENGTH - 1, index };
-					case PathingDirection::WEST: return { 0, index };
+						crossings->m_paths[sourceSide][targetSide] = std::move(path->m_path);
+						crossings->m_costs[sourceSide][targetSide] = path->m_totalPathCost;
 					}
-					return {};
-				};
-				auto path = Pathing::GetPath(
-					sector.m_tileMovementCosts,
-					GetSideTile(sourceSide, *sector.m_pathingBorderTiles[sourceSide]),
-					GetSideTile(targetSide, *sector.m_pathingBorderTiles[targetSide]));
-				if (path)
-				{
-					quadrant.m_sectorCrossingPaths[sectorI][sectorJ][sourceSide][targetSide] = path->m_path;
-					quadrant.m_sectorCrossingPathCosts[sectorI][sectorJ][sourceSide][targetSide] = path->m_totalPathCost;
 				}
-			});
+			}
+		}
+		quadrant.m_sectorCrossings[sectorI][sectorJ].store(std::move(crossings));
+		++sector.m_pathingVersion;
+	}));
+}
+
+void WorldTile::BuildQuadrantLandmarks(Quadrant& quadrant)
+{
+	auto landmarks = std::make_shared<Quadrant::Landmarks>();
+	for (auto&& sectorRow : quadrant.m_sectors)
+	{
+		for (auto&& sector : sectorRow)
+		{
+			landmarks->m_sectorVersions.emplace_back(&sector, sector.m_pathingVersion.load());
 		}
 	}
+	SectorGraphView<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH> sectors({}, {});
+	sectors.SetQuadrant(0, 0, &quadrant);
+	landmarks->m_oracle = Pathing::BuildLandmarkOracle<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH>(
+		[&sectors](int sectorX, int sectorY, int entry, int exit) {
+			auto& crossings = sectors.m_crossings[sectorX][sectorY];
+			return crossings ? crossings->m_costs[entry][exit] : std::nullopt;
+		});
+	quadrant.m_landmarks.store(std::move(landmarks));
 }
 
 void WorldTile::FillCrossQuadrantPaths(Quadrant& quadrant, const CoordinateVector2& coordinates)
 {
+	// Quadrants spawning side by side both redo the one between them, one at a time so the later one wins
 	static std::mutex movementCostAccessMutex;
 	std::lock_guard<std::mutex> lock(movementCostAccessMutex);
 
-	auto& crossQuadrantPathCosts = m_quadrantMovementCosts[coordinates];
-	auto& crossQuadrantPaths = m_quadrantPaths[coordinates];
+	// Searched under the shared lock, so the path searches carry on over the old crossings meanwhile
+	Pathing::DirectionMovementCostMap::mapped_type crossQuadrantPathCosts{};
+	decltype(m_quadrantPaths)::mapped_type crossQuadrantPaths{};
+	std::shared_lock<std::shared_mutex> searchLock(m_pathingDataMutex);
 	for (int sourceDirection = 0; sourceDirection < static_cast<int>(PathingDirection::_COUNT); ++sourceDirection)
 	{
 		auto sourceTile = GetQuadrantSideTile(quadrant, coordinates, sourceDirection);
@@ -788,15 +895,15 @@ void WorldTile::FillCrossQuadrantPaths(Quadrant& quadrant, const CoordinateVecto
 			if (path)
 			{
 				crossQuadrantPathCosts[sourceDirection][targetDirection] = path->m_totalPathCost;
-				crossQuadrantPaths[sourceDirection][targetDirection] = path->m_path;
-			}
-			else
-			{
-				crossQuadrantPathCosts[sourceDirection][targetDirection].reset();
-				crossQuadrantPaths[sourceDirection][targetDirection].reset();
+				crossQuadrantPaths[sourceDirection][targetDirection] = std::move(path->m_path);
 			}
 		}
 	}
+	searchLock.unlock();
+
+	std::unique_lock<std::shared_mutex> publishLock(m_pathingDataMutex);
+	m_quadrantMovementCosts[coordinates] = crossQuadrantPathCosts;
+	m_quadrantPaths[coordinates] = std::move(crossQuadrantPaths);
 }
 
 std::optional<TilePosition> WorldTile::GetQuadrantSideTile(
@@ -950,7 +1057,6 @@ void WorldTile::FillQuadrantPathingEdges(Quadrant& quadrant)
 			s64 m_pathCost;
 		};
 		std::map<PathingDirection, std::vector<FoundPath>> foundPaths;
-		std::vector<std::thread> pathThreads;
 		for (int edgeI = 0; edgeI < QUADRANT_SIDE_LENGTH; ++edgeI)
 		{
 			{
@@ -1104,24 +1210,30 @@ CoordinateVector2 WorldTile::CoordinatesToWorldOffset(const WorldCoordinates& wo
 	};
 }
 
-std::thread WorldTile::SpawnBetween(
+std::future<void> WorldTile::SpawnBetween(
 	CoordinateVector2 origin,
 	CoordinateVector2 target)
 {
-	return std::thread([=]() {
+	return m_generationPool.submit([=]() {
 		// Base case: Spawn between a place and itself
 		if (origin == target)
 		{
 			// Spawn just in case, will return immediately in most cases.
-			SpawnQuadrant(target).join();
+			auto spawn = SpawnQuadrant(target);
+			WaitForGeneration(spawn);
 			return;
 		}
 
-		SpawnQuadrant(target).join();
-		SpawnQuadrant(origin).join();
+		// Quadrants read their spawned neighbours, so they're added one after another
+		for (auto&& coordinates : { target, origin })
+		{
+			auto spawn = SpawnQuadrant(coordinates);
+			WaitForGeneration(spawn);
+		}
 
 		auto mid = (target + origin) / 2;
-		SpawnQuadrant(mid).join();
+		auto midSpawn = SpawnQuadrant(mid);
+		WaitForGeneration(midSpawn);
 
 		if (mid == target || mid == origin)
 		{
@@ -1129,8 +1241,10 @@ std::thread WorldTile::SpawnBetween(
 			return;
 		}
 
-		SpawnBetween(origin, mid).join();
-		SpawnBetween(mid + CoordinateVector2(sign(target.m_x - origin.m_x), sign(target.m_y - origin.m_y)), target).join();
+		auto firstHalf = SpawnBetween(origin, mid);
+		WaitForGeneration(firstHalf);
+		auto secondHalf = SpawnBetween(mid + CoordinateVector2(sign(target.m_x - origin.m_x), sign(target.m_y - origin.m_y)), target);
+		WaitForGeneration(secondHalf);
 	});
 }
 
@@ -1206,10 +1320,11 @@ std::set<WorldTile::TileSide> WorldTile::GetAdjacents(const WorldCoordinates& co
 
 void WorldTile::GrowTerritories()
 {
+	PROFILE_ZONE("WorldTile::GrowTerritories");
 	using namespace ECS_Core;
 	// Get current time
 	// Assume the first entity is the one that has a valid time
-	auto timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	const auto& timeEntities = m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
 	if (timeEntities.size() == 0)
 	{
 		return;
@@ -1231,6 +1346,11 @@ void WorldTile::GrowTerritories()
 			if (!placementTile.m_owningBuilding)
 			{
 				placementTile.m_owningBuilding = manager.getHandle(entity);
+				if (placementTile.m_movementCost)
+				{
+					// Settlements pave their own tile
+					SetTileMovementCost(tilePos.m_position, c_minimumTileMovementCost);
+				}
 			}
 		}
 		return ecs::IterationBehavior::CONTINUE;
@@ -1414,64 +1534,98 @@ void WorldTile::UpdateTerritoryProductionPotential(ECS_Core::Components::C_TileP
 
 std::optional<WorldTile::Tile*> WorldTile::GetTile(const TilePosition& buildingTilePos)
 {
-	if (!m_spawnedQuadrants.count(buildingTilePos.m_quadrantCoords))
-	{
-		FetchQuadrant(buildingTilePos.m_quadrantCoords);
-		return std::nullopt;
-	}
-	if (!FetchQuadrant(buildingTilePos.m_quadrantCoords).m_spawningComplete) return std::nullopt;
-	return &FetchQuadrant(buildingTilePos.m_quadrantCoords)
-		.m_sectors[buildingTilePos.m_sectorCoords.m_x][buildingTilePos.m_sectorCoords.m_y]
+	// Starts spawning the quadrant if it isn't there yet
+	auto quadrant = FetchQuadrant(buildingTilePos.m_quadrantCoords);
+	if (!quadrant) return std::nullopt;
+	return &quadrant
+		->m_sectors[buildingTilePos.m_sectorCoords.m_x][buildingTilePos.m_sectorCoords.m_y]
 		.m_tiles[buildingTilePos.m_coords.m_x][buildingTilePos.m_coords.m_y];
 }
 
-WorldTile::Quadrant& WorldTile::FetchQuadrant(const CoordinateVector2 & quadrantCoords)
+WorldTile::Quadrant* WorldTile::FetchQuadrant(const CoordinateVector2 & quadrantCoords)
 {
-	if (m_spawnedQuadrants.find(quadrantCoords) == m_spawnedQuadrants.end())
 	{
-		std::thread([=]() {
-			// We're going to need to spawn world up to that point.
-			// first: find the closest available world tile
-			auto closest = FindNearestQuadrant(m_spawnedQuadrants, quadrantCoords);
+		std::lock_guard<std::mutex> lock(m_quadrantMapMutex);
+		auto quadrantIter = m_spawnedQuadrants.find(quadrantCoords);
+		if (quadrantIter != m_spawnedQuadrants.end())
+		{
+			return quadrantIter->second.m_spawningComplete ? &quadrantIter->second : nullptr;
+		}
+	}
+	if (!m_requestedQuadrants.insert(quadrantCoords).second)
+	{
+		// Already on its way
+		return nullptr;
+	}
 
-			SpawnBetween(
-				closest,
-				quadrantCoords).join();
+	// Nobody waits on this, the tiles are picked up once the quadrant finishes spawning
+	m_generationPool.submit([=]() {
+		// We're going to need to spawn world up to that point.
+		// first: find the closest available world tile
+		CoordinateVector2 closest;
+		{
+			std::lock_guard<std::mutex> lock(m_quadrantMapMutex);
+			closest = FindNearestQuadrant(m_spawnedQuadrants, quadrantCoords);
+		}
+
+		auto spawn = SpawnBetween(
+			closest,
+			quadrantCoords);
+		WaitForGeneration(spawn);
 
-			// Find all quadrants which can't be reached by repeated cardinal direction movement from the origin
-			CoordinateFromOriginSet touchedCoordinates, untouchedCoordinates;
+		// Find all quadrants which can't be reached by repeated cardinal direction movement from the origin
+		CoordinateFromOriginSet touchedCoordinates, untouchedCoordinates;
+		{
+			std::lock_guard<std::mutex> lock(m_quadrantMapMutex);
 			for (auto&& quadrant : m_spawnedQuadrants)
 			{
 				untouchedCoordinates.insert(quadrant.first);
 			}
 			TouchConnectedCoordinates({ 0, 0 }, untouchedCoordinates, touchedCoordinates);
+		}
 
-			// Start with the closest untouched, connect it. We'll only need to add one to connect it, we know they're corner-to-corner
-			// To be secure about it, connect on both sides. Screw your RAM.
-			while (untouchedCoordinates.size())
+		// Start with the closest untouched, connect it. We'll only need to add one to connect it, we know they're corner-to-corner
+		// To be secure about it, connect on both sides. Screw your RAM.
+		while (untouchedCoordinates.size())
+		{
+			auto nearestDisconnected = untouchedCoordinates.begin();
+			auto nearestConnected = FindNearestQuadrant(touchedCoordinates, *nearestDisconnected);
+			for (; nearestDisconnected != untouchedCoordinates.end(); ++nearestDisconnected)
 			{
-				auto nearestDisconnected = untouchedCoordinates.begin();
-				auto nearestConnected = FindNearestQuadrant(touchedCoordinates, *nearestDisconnected);
-				for (; nearestDisconnected != untouchedCoordinates.end(); ++nearestDisconnected)
-				{
-					if ((nearestConnected - *nearestDisconnected).MagnitudeSq() == 2)
-					{
-						break;
-					}
-				}
-				if (nearestDisconnected == untouchedCoordinates.end())
+				if ((nearestConnected - *nearestDisconnected).MagnitudeSq() == 2)
 				{
 					break;
 				}
-				SpawnQuadrant({ nearestDisconnected->m_x, nearestConnected.m_y }).join();
-				SpawnQuadrant({ nearestConnected.m_x, nearestDisconnected->m_y }).join();
-
-				touchedCoordinates.clear();
-				TouchConnectedCoordinates(nearestConnected, untouchedCoordinates, touchedCoordinates);
 			}
-		}).detach();
+			if (nearestDisconnected == untouchedCoordinates.end())
+			{
+				break;
+			}
+			for (auto&& corner : {
+				CoordinateVector2{ nearestDisconnected->m_x, nearestConnected.m_y },
+				CoordinateVector2{ nearestConnected.m_x, nearestDisconnected->m_y } })
+			{
+				auto cornerSpawn = SpawnQuadrant(corner);
+				WaitForGeneration(cornerSpawn);
+			}
+
+			touchedCoordinates.clear();
+			std::lock_guard<std::mutex> lock(m_quadrantMapMutex);
+			TouchConnectedCoordinates(nearestConnected, untouchedCoordinates, touchedCoordinates);
+		}
+	});
+	return nullptr;
+}
+
+const WorldTile::Quadrant* WorldTile::FindQuadrant(const CoordinateVector2& quadrantCoords) const
+{
+	std::lock_guard<std::mutex> lock(m_quadrantMapMutex);
+	auto quadrantIter = m_spawnedQuadrants.find(quadrantCoords);
+	if (quadrantIter == m_spawnedQuadrants.end() || !quadrantIter->second.m_spawningComplete)
+	{
+		return nullptr;
 	}
-	return m_spawnedQuadrants[quadrantCoords];
+	return &quadrantIter->second;
 }
 
 void WorldTile::ReturnDeadBuildingTiles()
@@ -1484,16 +1638,27 @@ void WorldTile::ReturnDeadBuildingTiles()
 		const Components::C_TilePosition& buildingPosition)
 	{
 		auto& buildingTile = FetchQuadrant(buildingPosition.m_position.m_quadrantCoords)
-			.m_sectors[buildingPosition.m_position.m_sectorCoords.m_x][buildingPosition.m_position.m_sectorCoords.m_y]
+			->m_sectors[buildingPosition.m_position.m_sectorCoords.m_x][buildingPosition.m_position.m_sectorCoords.m_y]
 			.m_tiles[buildingPosition.m_position.m_coords.m_x][buildingPosition.m_position.m_coords.m_y];
 		buildingTile.m_owningBuilding.reset();
+		SetTileMovementCost(
+			buildingPosition.m_position,
+			GeneratedMovementCost(
+				SectorStreamKey(
+					m_worldSeed,
+					buildingPosition.m_position.m_quadrantCoords,
+					TILE_MOVEMENT_COSTS,
+					buildingPosition.m_position.m_sectorCoords.m_x,
+					buildingPosition.m_position.m_sectorCoords.m_y),
+				TileIndex(buildingPosition.m_position.m_coords.m_x, buildingPosition.m_position.m_coords.m_y),
+				buildingTile.m_tileType));
 
 		if (manager.hasComponent<ECS_Core::Components::C_Territory>(deadBuildingEntity))
 		{
 			for (auto&& tile : manager.getComponent<ECS_Core::Components::C_Territory>(deadBuildingEntity).m_ownedTiles)
 			{
 				FetchQuadrant(tile.m_quadrantCoords)
-					.m_sectors[tile.m_sectorCoords.m_x][tile.m_sectorCoords.m_y]
+					->m_sectors[tile.m_sectorCoords.m_x][tile.m_sectorCoords.m_y]
 					.m_tiles[tile.m_coords.m_x][tile.m_coords.m_y].m_owningBuilding.reset();
 			}
 		}
@@ -1550,48 +1715,48 @@ void WorldTile::ProcessSelectTile(
 					}),
 						UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 						s32 result{ 0 };
-						for (auto&&[birthMonth, population] : pop.m_populations)
+						for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 						{
-							if (population.m_class == PopulationClass::WORKERS)
-								result += population.m_numMen;
+							if (pop.m_class[cohort] == PopulationClass::WORKERS)
+								result += pop.m_numMen[cohort];
 						}
 						return result;
 					}),
 						UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 						s32 result{ 0 };
-						for (auto&&[birthMonth, population] : pop.m_populations)
+						for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 						{
-							if (population.m_class == PopulationClass::WORKERS)
-								result += population.m_numWomen;
+							if (pop.m_class[cohort] == PopulationClass::WORKERS)
+								result += pop.m_numWomen[cohort];
 						}
 						return result;
 					}),
 						UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 						s32 result{ 0 };
-						for (auto&&[birthMonth, population] : pop.m_populations)
+						for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 						{
-							if (population.m_class == PopulationClass::CHILDREN)
-								result += population.m_numMen + population.m_numWomen;
+							if (pop.m_class[cohort] == PopulationClass::CHILDREN)
+								result += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 						}
 						return result;
 					}),
 						UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 						s32 result{ 0 };
-						for (auto&&[birthMonth, population] : pop.m_populations)
+						for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 						{
-							if (population.m_class == PopulationClass::ELDERS)
-								result += population.m_numMen + population.m_numWomen;
+							if (pop.m_class[cohort] == PopulationClass::ELDERS)
+								result += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 						}
 						return result;
 					}),
 						UIDataReader<C_Population, f64>([](const C_Population& pop) -> f64 {
 						f64 totalHealth{ 0 };
 						s32 totalPopulation{ 0 };
-						for (auto&&[birthMonth, population] : pop.m_populations)
+						for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 						{
-							totalHealth += (population.m_mensHealth * population.m_numMen)
-								+ (population.m_womensHealth * population.m_numWomen);
-							totalPopulation += population.m_numMen + population.m_numWomen;
+							totalHealth += (pop.m_mensHealth[cohort] * pop.m_numMen[cohort])
+								+ (pop.m_womensHealth[cohort] * pop.m_numWomen[cohort]);
+							totalPopulation += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 						}
 						return totalHealth / max<s32>(1, totalPopulation);
 					}),
@@ -1686,48 +1851,48 @@ void WorldTile::ProcessSelectTile(
 				uiFrame.m_frame = DefineUIFrame("Building",
 					UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 					s32 result{ 0 };
-					for (auto&&[birthMonth, population] : pop.m_populations)
+					for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 					{
-						if (population.m_class == PopulationClass::WORKERS)
-							result += population.m_numMen;
+						if (pop.m_class[cohort] == PopulationClass::WORKERS)
+							result += pop.m_numMen[cohort];
 					}
 					return result;
 				}),
 					UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 					s32 result{ 0 };
-					for (auto&&[birthMonth, population] : pop.m_populations)
+					for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 					{
-						if (population.m_class == PopulationClass::WORKERS)
-							result += population.m_numWomen;
+						if (pop.m_class[cohort] == PopulationClass::WORKERS)
+							result += pop.m_numWomen[cohort];
 					}
 					return result;
 				}),
 					UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 					s32 result{ 0 };
-					for (auto&&[birthMonth, population] : pop.m_populations)
+					for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 					{
-						if (population.m_class == PopulationClass::CHILDREN)
-							result += population.m_numMen + population.m_numWomen;
+						if (pop.m_class[cohort] == PopulationClass::CHILDREN)
+							result += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 					}
 					return result;
 				}),
 					UIDataReader<C_Population, s32>([](const C_Population& pop) -> s32 {
 					s32 result{ 0 };
-					for (auto&&[birthMonth, population] : pop.m_populations)
+					for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 					{
-						if (population.m_class == PopulationClass::ELDERS)
-							result += population.m_numMen + population.m_numWomen;
+						if (pop.m_class[cohort] == PopulationClass::ELDERS)
+							result += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 					}
 					return result;
 				}),
 					UIDataReader<C_Population, f64>([](const C_Population& pop) -> f64 {
 					f64 totalHealth{ 0 };
 					s32 totalPopulation{ 0 };
-					for (auto&&[birthMonth, population] : pop.m_populations)
+					for (size_t cohort = 0; cohort < pop.Size(); ++cohort)
 					{
-						totalHealth += (population.m_mensHealth * population.m_numMen)
-							+ (population.m_womensHealth * population.m_numWomen);
-						totalPopulation += population.m_numMen + population.m_numWomen;
+						totalHealth += (pop.m_mensHealth[cohort] * pop.m_numMen[cohort])
+							+ (pop.m_womensHealth[cohort] * pop.m_numWomen[cohort]);
+						totalPopulation += pop.m_numMen[cohort] + pop.m_numWomen[cohort];
 					}
 					return totalHealth / max<s32>(1, totalPopulation);
 				}),
@@ -1829,45 +1994,655 @@ void WorldTile::ProcessSelectTile(
 	}
 }
 
+void WorldTile::RequestPath(
+	ecs::EntityIndex requester,
+	const TilePosition& sourcePosition,
+	std::vector<TilePosition> targetPositions,
+	const std::optional<ecs::Impl::Handle>& targetingIcon)
+{
+	auto& request = m_managerRef.addComponent<ECS_Core::Components::C_PathRequest>(requester);
+	request.m_sourcePosition = sourcePosition;
+	request.m_targetPositions = std::move(targetPositions);
+	request.m_targetingIcon = targetingIcon;
+	request.m_requestId = m_nextPathRequestId++;
+}
+
+void WorldTile::DeliverPathResults()
+{
+	for (auto batch = m_pathBatches.begin(); batch != m_pathBatches.end();)
+	{
+		if (batch->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++batch;
+			continue;
+		}
+		for (auto&& result : batch->get())
+		{
+			if (!m_managerRef.isHandleValid(result.m_requester)
+				|| !m_managerRef.hasComponent<ECS_Core::Components::C_PathRequest>(result.m_requester))
+			{
+				continue;
+			}
+			auto& request = m_managerRef.getComponent<ECS_Core::Components::C_PathRequest>(result.m_requester);
+			if (request.m_requestId != result.m_requestId)
+			{
+				// Replaced while this one was being searched
+				continue;
+			}
+			if (result.m_movementCostVersion != m_movementCostVersion)
+			{
+				// Searched against tile costs that have changed since. Search again from wherever the unit has got to
+				if (m_managerRef.hasComponent<ECS_Core::Components::C_TilePosition>(result.m_requester))
+				{
+					request.m_sourcePosition = m_managerRef.getComponent<ECS_Core::Components::C_TilePosition>(result.m_requester).m_position;
+				}
+				request.m_submitted = false;
+				continue;
+			}
+			if (result.m_path && request.m_targetingIcon)
+			{
+				m_managerRef.addTag<ECS_Core::Tags::T_Dead>(*request.m_targetingIcon);
+			}
+			auto repair = request.m_repair;
+			m_managerRef.delComponent<ECS_Core::Components::C_PathRequest>(result.m_requester);
+			auto& pathResult = m_managerRef.addComponent<ECS_Core::Components::C_PathResult>(result.m_requester);
+			pathResult.m_targetPosition = result.m_targetPosition;
+			pathResult.m_path = std::move(result.m_path);
+			pathResult.m_repair = repair;
+		}
+		batch = m_pathBatches.erase(batch);
+	}
+}
+
+void WorldTile::ApplyPathResults()
+{
+	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_PathResult>([&manager = m_managerRef, this](
+		const ecs::EntityIndex& entity,
+		ECS_Core::Components::C_MovingUnit& mover,
+		ECS_Core::Components::C_PathResult& result)
+	{
+		if (result.m_repair)
+		{
+			// Only while the unit is still headed where the search was for
+			if (result.m_path
+				&& mover.m_currentMovement
+				&& mover.m_currentMovement->m_path.Back() == result.m_targetPosition)
+			{
+				if (!SpliceRemainingPath(*mover.m_currentMovement, result.m_path->m_path))
+				{
+					// Walked off the repaired path while it was searched, so search again from where the unit is now
+					manager.delComponent<ECS_Core::Components::C_PathResult>(entity);
+					RequestPath(entity, mover.m_currentMovement->m_path.CurrentTile(), { result.m_targetPosition });
+					manager.getComponent<ECS_Core::Components::C_PathRequest>(entity).m_repair = true;
+					return ecs::IterationBehavior::CONTINUE;
+				}
+				// Later changes repair the path in place with the search it came back with
+				mover.m_currentMovement->m_repairSearch = std::move(result.m_path->m_repairSearch);
+				mover.m_currentMovement->m_repairWindowOrigin = result.m_path->m_repairWindowOrigin;
+			}
+		}
+		else if (result.m_path)
+		{
+			if (mover.m_explorationPlan
+				&& !(result.m_targetPosition == mover.m_explorationPlan->m_homeBasePosition))
+			{
+				mover.m_explorationPlan->m_visitedPathNodes.insert(result.m_targetPosition);
+			}
+			mover.m_currentMovement = std::move(result.m_path);
+		}
+		manager.delComponent<ECS_Core::Components::C_PathResult>(entity);
+		return ecs::IterationBehavior::CONTINUE;
+	});
+}
+
+void WorldTile::SubmitPathRequests()
+{
+	if (!m_pendingMovementCosts.empty())
+	{
+		// The changes wait for the running searches to finish, new ones would only keep them waiting
+		return;
+	}
+	std::vector<PathJob> jobs;
+	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_PathRequest>([&jobs, this](
+		const ecs::EntityIndex& entity,
+		ECS_Core::Components::C_PathRequest& request)
+	{
+		if (request.m_submitted)
+		{
+			return ecs::IterationBehavior::CONTINUE;
+		}
+		request.m_submitted = true;
+		// Quadrants are spawned from here, the workers only look up ones that are already there
+		FetchQuadrant(request.m_sourcePosition.m_quadrantCoords);
+		for (auto&& target : request.m_targetPositions)
+		{
+			FetchQuadrant(target.m_quadrantCoords);
+		}
+		jobs.push_back({ m_managerRef.getHandle(entity), request.m_requestId, request.m_sourcePosition, request.m_targetPositions, request.m_repairWindow });
+		return ecs::IterationBehavior::CONTINUE;
+	});
+
+	for (size_t first = 0; first < jobs.size(); first += c_pathJobsPerTask)
+	{
+		std::vector<PathJob> taskJobs(
+			std::make_move_iterator(jobs.begin() + first),
+			std::make_move_iterator(jobs.begin() + min(jobs.size(), first + c_pathJobsPerTask)));
+		m_pathBatches.push_back(m_pathingPool.submit([taskJobs = std::move(taskJobs), this]() {
+			PROFILE_ZONE("WorldTile::PathBatch");
+			std::vector<PathJobResult> results;
+			results.reserve(taskJobs.size());
+			for (auto&& job : taskJobs)
+			{
+				// Let go between jobs, so whatever is waiting to change the quadrants gets a turn
+				std::shared_lock<std::shared_mutex> lock(m_pathingDataMutex);
+				PathJobResult result{ job.m_requester, job.m_requestId, job.m_sourcePosition, std::nullopt, m_movementCostVersion.load() };
+				for (auto&& target : job.m_targetPositions)
+				{
+					auto path = job.m_repairWindow
+						? BuildRepairSearch(job.m_sourcePosition, target, job.m_repairWindow->first, job.m_repairWindow->second)
+						: GetPath(job.m_sourcePosition, target);
+					if (path)
+					{
+						result.m_targetPosition = target;
+						result.m_path = std::move(path);
+						break;
+					}
+				}
+				results.push_back(std::move(result));
+			}
+			return results;
+		}));
+	}
+}
+
+void WorldTile::SetTileMovementCost(const TilePosition& position, std::optional<int> movementCost)
+{
+	m_pendingMovementCosts.emplace_back(position, movementCost);
+}
+
+void WorldTile::ApplyMovementCostChanges()
+{
+	if (m_pendingMovementCosts.empty())
+	{
+		return;
+	}
+	PROFILE_ZONE("WorldTile::ApplyMovementCostChanges");
+	std::set<std::pair<CoordinateVector2, CoordinateVector2>> changedSectors;
+	{
+		// The pathing workers read the costs as they search
+		// Rather than wait for them, leave the changes for a later frame while any search is running
+		std::unique_lock<std::shared_mutex> lock(m_pathingDataMutex, std::try_to_lock);
+		if (!lock.owns_lock())
+		{
+			return;
+		}
+		for (auto&& [position, movementCost] : m_pendingMovementCosts)
+		{
+			auto quadrant = FetchQuadrant(position.m_quadrantCoords);
+			if (!quadrant)
+			{
+				continue;
+			}
+			if (movementCost)
+			{
+				movementCost = max(*movementCost, c_minimumTileMovementCost);
+			}
+			auto& sector = quadrant->m_sectors[position.m_sectorCoords.m_x][position.m_sectorCoords.m_y];
+			sector.m_tiles[position.m_coords.m_x][position.m_coords.m_y].m_movementCost = movementCost;
+			sector.m_tileMovementCosts[position.m_coords.m_x][position.m_coords.m_y] = movementCost;
+			changedSectors.emplace(position.m_quadrantCoords, position.m_sectorCoords);
+			m_changedMovementCosts.push_back(position);
+		}
+	}
+	m_pendingMovementCosts.clear();
+
+	// Border tiles stay where they are, only the paths between them are searched again
+	std::vector<std::future<void>> sectorPathFindingTasks;
+	std::set<CoordinateVector2> changedQuadrants;
+	for (auto&& [quadrantCoords, sectorCoords] : changedSectors)
+	{
+		// The new crossings replace the old ones whole, so one the changes closed doesn't outlive them
+		auto& quadrant = *FetchQuadrant(quadrantCoords);
+		FillSectorPathing(
+			quadrant.m_sectors[sectorCoords.m_x][sectorCoords.m_y],
+			sectorPathFindingTasks,
+			quadrant,
+			static_cast<int>(sectorCoords.m_x),
+			static_cast<int>(sectorCoords.m_y));
+		changedQuadrants.insert(quadrantCoords);
+	}
+	WaitForGeneration(sectorPathFindingTasks);
+	for (auto&& [quadrantCoords, sectorCoords] : changedSectors)
+	{
+		// Even a sector without crossings has cached paths running over the changed tiles
+		++FetchQuadrant(quadrantCoords)->m_sectors[sectorCoords.m_x][sectorCoords.m_y].m_pathingVersion;
+	}
+	for (auto&& quadrantCoords : changedQuadrants)
+	{
+		auto& quadrant = *FetchQuadrant(quadrantCoords);
+		BuildQuadrantLandmarks(quadrant);
+		FillCrossQuadrantPaths(quadrant, quadrantCoords);
+	}
+	// Searches that started before now may have seen some of the changes and not others
+	++m_movementCostVersion;
+}
+
+void WorldTile::RepairPaths()
+{
+	PROFILE_ZONE("WorldTile::RepairPaths");
+	std::vector<CoordinateVector2> changedTiles;
+	changedTiles.reserve(m_changedMovementCosts.size());
+	for (auto&& position : m_changedMovementCosts)
+	{
+		changedTiles.push_back(GlobalTileCoordinates(position));
+	}
+	m_changedMovementCosts.clear();
+
+	m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_MovingUnit>([&changedTiles, this](
+		const ecs::EntityIndex& entity,
+		const ECS_Core::Components::C_TilePosition& tilePosition,
+		ECS_Core::Components::C_MovingUnit& mover,
+		const ECS_Core::Components::C_Population&,
+		const ECS_Core::Components::C_Vision&)
+	{
+		if (!mover.m_currentMovement)
+		{
+			return ecs::IterationBehavior::CONTINUE;
+		}
+		auto& movement = *mover.m_currentMovement;
+		if (movement.m_repairSearch
+			&& (movement.m_path.AtBack()
+				|| !movement.m_repairSearch->Contains(GlobalTileCoordinates(tilePosition.m_position) - movement.m_repairWindowOrigin)))
+		{
+			// Arrived, or walked out of the window it searches, so it can't be used again
+			movement.m_repairSearch.reset();
+		}
+		if (changedTiles.empty())
+		{
+			return ecs::IterationBehavior::CONTINUE;
+		}
+
+		// Only changes close to what's left of the path can change the best way along it
+		auto windowLow = GlobalTileCoordinates(tilePosition.m_position);
+		auto windowHigh = windowLow;
+		movement.m_path.ForEachRemainingTile([&windowLow, &windowHigh](const TilePosition& tile, int) {
+			auto coordinates = GlobalTileCoordinates(tile);
+			windowLow = { min(windowLow.m_x, coordinates.m_x), min(windowLow.m_y, coordinates.m_y) };
+			windowHigh = { max(windowHigh.m_x, coordinates.m_x), max(windowHigh.m_y, coordinates.m_y) };
+		});
+		windowLow -= CoordinateVector2(c_repairWindowMargin, c_repairWindowMargin);
+		windowHigh += CoordinateVector2(c_repairWindowMargin, c_repairWindowMargin);
+		if (std::none_of(changedTiles.begin(), changedTiles.end(), [&windowLow, &windowHigh](const CoordinateVector2& tile) {
+			return tile.m_x >= windowLow.m_x && tile.m_x <= windowHigh.m_x
+				&& tile.m_y >= windowLow.m_y && tile.m_y <= windowHigh.m_y;
+		}))
+		{
+			return ecs::IterationBehavior::CONTINUE;
+		}
+
+		bool windowFits = windowHigh.m_x - windowLow.m_x < c_maxRepairWindowSide
+			&& windowHigh.m_y - windowLow.m_y < c_maxRepairWindowSide;
+		auto start = GlobalTileCoordinates(tilePosition.m_position);
+		bool searchReusable = windowFits
+			&& movement.m_repairSearch
+			&& movement.m_repairSearch->Goal() + movement.m_repairWindowOrigin == GlobalTileCoordinates(movement.m_path.Back())
+			&& movement.m_repairSearch->Contains(start - movement.m_repairWindowOrigin);
+		if (!searchReusable)
+		{
+			// The rest of the path is searched off the main thread, in a window kept for later changes if it's small enough
+			movement.m_repairSearch.reset();
+			if (!m_managerRef.hasComponent<ECS_Core::Components::C_PathRequest>(entity))
+			{
+				// Otherwise new orders or a repair are already on their way, and are searched against the new costs
+				RequestPath(entity, tilePosition.m_position, { movement.m_path.Back() });
+				auto& request = m_managerRef.getComponent<ECS_Core::Components::C_PathRequest>(entity);
+				request.m_repair = true;
+				if (windowFits)
+				{
+					request.m_repairWindow.emplace(windowLow, windowHigh);
+				}
+			}
+			return ecs::IterationBehavior::CONTINUE;
+		}
+		auto remainingPath = RepairPath(movement, tilePosition.m_position, changedTiles);
+		if (!remainingPath)
+		{
+			// Nothing gets through any more. Keep walking, later changes may open a way again
+			return ecs::IterationBehavior::CONTINUE;
+		}
+		SpliceRemainingPath(movement, *remainingPath);
+		return ecs::IterationBehavior::CONTINUE;
+	});
+}
+
+bool WorldTile::SpliceRemainingPath(ECS_Core::Components::MoveToPoint& movement, const CompactPath& remainingPath)
+{
+	// Searched from an earlier tile of the path, the unit may have walked on since
+	auto currentTile = movement.m_path.CurrentTile();
+	std::optional<size_t> joinIndex;
+	size_t tileIndex = 0;
+	remainingPath.ForEachTile([&currentTile, &joinIndex, &tileIndex](const TilePosition& tile, int) {
+		if (!joinIndex && tile == currentTile)
+		{
+			joinIndex = tileIndex;
+		}
+		++tileIndex;
+	});
+	if (!joinIndex)
+	{
+		return false;
+	}
+
+	// The part already walked stays, caravans turn around at either end of the whole path
+	CompactPath repairedPath;
+	auto walkedTiles = movement.m_path.CurrentIndex();
+	movement.m_totalPathCost = 0;
+	auto appendTile = [&repairedPath, &movement](const TilePosition& tile, int movementCost) {
+		repairedPath.Append(tile, movementCost);
+		movement.m_totalPathCost += movementCost;
+	};
+	tileIndex = 0;
+	movement.m_path.ForEachTile([&appendTile, &tileIndex, walkedTiles](const TilePosition& tile, int movementCost) {
+		if (tileIndex++ < walkedTiles)
+		{
+			appendTile(tile, movementCost);
+		}
+	});
+	tileIndex = 0;
+	remainingPath.ForEachTile([&appendTile, &tileIndex, &joinIndex](const TilePosition& tile, int movementCost) {
+		if (tileIndex++ >= *joinIndex)
+		{
+			appendTile(tile, movementCost);
+		}
+	});
+	for (size_t i = 0; i < walkedTiles; ++i)
+	{
+		repairedPath.Advance();
+	}
+	movement.m_path = std::move(repairedPath);
+	return true;
+}
+
+std::optional<CompactPath> WorldTile::RepairPath(
+	ECS_Core::Components::MoveToPoint& movement,
+	const TilePosition& sourcePosition,
+	const std::vector<CoordinateVector2>& changedTiles)
+{
+	auto& search = *movement.m_repairSearch;
+	auto windowOrigin = movement.m_repairWindowOrigin;
+	auto costs = GetWindowCosts(windowOrigin, search.Width(), search.Height());
+
+	search.MoveStart(GlobalTileCoordinates(sourcePosition) - windowOrigin);
+	for (auto&& tile : changedTiles)
+	{
+		if (search.Contains(tile - windowOrigin))
+		{
+			search.NodeChanged(costs, tile - windowOrigin);
+		}
+	}
+	auto path = search.Replan(costs);
+	if (!path)
+	{
+		return std::nullopt;
+	}
+	return costs.ToCompactPath(path->m_path);
+}
+
+std::optional<ECS_Core::Components::MoveToPoint> WorldTile::BuildRepairSearch(
+	const TilePosition& sourcePosition,
+	const TilePosition& targetPosition,
+	const CoordinateVector2& windowLow,
+	const CoordinateVector2& windowHigh)
+{
+	auto width = static_cast<int>(windowHigh.m_x - windowLow.m_x + 1);
+	auto height = static_cast<int>(windowHigh.m_y - windowLow.m_y + 1);
+	auto search = std::make_shared<Pathing::IncrementalPath>(
+		width,
+		height,
+		GlobalTileCoordinates(sourcePosition) - windowLow,
+		GlobalTileCoordinates(targetPosition) - windowLow,
+		c_minimumTileMovementCost);
+	if (!search->Contains(GlobalTileCoordinates(sourcePosition) - windowLow))
+	{
+		// Searched again after the unit walked out of the window
+		return GetPath(sourcePosition, targetPosition);
+	}
+
+	auto costs = GetWindowCosts(windowLow, width, height);
+	auto path = search->Replan(costs);
+	if (!path)
+	{
+		return std::nullopt;
+	}
+	ECS_Core::Components::MoveToPoint movement;
+	movement.m_targetPosition = targetPosition;
+	movement.m_path = costs.ToCompactPath(path->m_path);
+	movement.m_totalPathCost = path->m_totalPathCost;
+	movement.m_repairSearch = std::move(search);
+	movement.m_repairWindowOrigin = windowLow;
+	return movement;
+}
+
+WorldTile::WindowCosts WorldTile::GetWindowCosts(const CoordinateVector2& windowOrigin, int width, int height) const
+{
+	WindowCosts costs;
+	costs.m_windowOrigin = windowOrigin;
+	costs.m_firstQuadrant = TilePositionAt(windowOrigin).m_quadrantCoords;
+	auto lastQuadrant = TilePositionAt(windowOrigin + CoordinateVector2(width - 1, height - 1)).m_quadrantCoords;
+	costs.m_quadrantRows = lastQuadrant.m_y - costs.m_firstQuadrant.m_y + 1;
+	for (auto x = costs.m_firstQuadrant.m_x; x <= lastQuadrant.m_x; ++x)
+	{
+		for (auto y = costs.m_firstQuadrant.m_y; y <= lastQuadrant.m_y; ++y)
+		{
+			costs.m_quadrants.push_back(FindQuadrant({ x, y }));
+		}
+	}
+	return costs;
+}
+
+const std::optional<int>& WorldTile::WindowCosts::operator()(s64 x, s64 y) const
+{
+	static const std::optional<int> c_unpathable;
+	auto position = TilePositionAt(m_windowOrigin + CoordinateVector2(x, y));
+	auto quadrant = m_quadrants[
+		(position.m_quadrantCoords.m_x - m_firstQuadrant.m_x) * m_quadrantRows
+			+ (position.m_quadrantCoords.m_y - m_firstQuadrant.m_y)];
+	if (!quadrant)
+	{
+		return c_unpathable;
+	}
+	return quadrant->m_sectors[position.m_sectorCoords.m_x][position.m_sectorCoords.m_y]
+		.m_tileMovementCosts[position.m_coords.m_x][position.m_coords.m_y];
+}
+
+CompactPath WorldTile::WindowCosts::ToCompactPath(const std::deque<CoordinateVector2>& path) const
+{
+	CompactPath steps;
+	for (auto&& coordinates : path)
+	{
+		// The unit may be standing on a tile which just closed
+		steps.Append(
+			TilePositionAt(m_windowOrigin + coordinates),
+			(*this)(coordinates.m_x, coordinates.m_y).value_or(c_minimumTileMovementCost));
+	}
+	return steps;
+}
+
 std::optional<ECS_Core::Components::MoveToPoint> WorldTile::GetPath(
 	const TilePosition& sourcePosition,
 	const TilePosition& targetPosition)
+{
+	auto cacheKey = std::make_pair(sourcePosition, targetPosition);
+	{
+		std::lock_guard<std::mutex> cacheLock(m_pathCacheMutex);
+		if (auto cachedPath = m_pathCache.Find(cacheKey))
+		{
+			if (std::all_of(cachedPath->m_sectorVersions.begin(), cachedPath->m_sectorVersions.end(), [](const auto& sectorVersion) {
+				return sectorVersion.first->m_pathingVersion == sectorVersion.second;
+			}))
+			{
+				return cachedPath->m_path;
+			}
+			m_pathCache.Erase(cacheKey);
+		}
+	}
+
+	// Searched without the lock, so the other workers can use the cache meanwhile
+	auto path = FindPath(sourcePosition, targetPosition);
+	if (path)
+	{
+		// Unreachable targets aren't cached, there's no sector whose change would make them reachable
+		CachedPath cachedPath{ *path, {} };
+		const Sector* lastSector = nullptr;
+		path->m_path.ForEachTile([&cachedPath, &lastSector, this](const TilePosition& tile, int) {
+			auto& sector = FindQuadrant(tile.m_quadrantCoords)
+				->m_sectors[tile.m_sectorCoords.m_x][tile.m_sectorCoords.m_y];
+			if (&sector == lastSector)
+			{
+				return;
+			}
+			lastSector = &sector;
+			cachedPath.m_sectorVersions.emplace_back(&sector, sector.m_pathingVersion.load());
+		});
+		std::lock_guard<std::mutex> cacheLock(m_pathCacheMutex);
+		m_pathCache.Insert(cacheKey, std::move(cachedPath));
+	}
+	return path;
+}
+
+std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindPath(
+	const TilePosition& sourcePosition,
+	const TilePosition& targetPosition)
 {
 	// Make sure you can get from source tile to target tile
 	// Are they in the same quadrant?
+	// Quadrants still spawning have nothing to path through yet
+	auto targetQuadrant = FindQuadrant(targetPosition.m_quadrantCoords);
+	auto sourceQuadrant = FindQuadrant(sourcePosition.m_quadrantCoords);
+	if (!targetQuadrant || !sourceQuadrant)
+	{
+		return std::nullopt;
+	}
 	if (sourcePosition.m_quadrantCoords != targetPosition.m_quadrantCoords)
 	{
-		auto& targetQuadrant = FetchQuadrant(targetPosition.m_quadrantCoords);
-		auto& sourceQuadrant = FetchQuadrant(sourcePosition.m_quadrantCoords);
-
-		return FindMultiQuadrantPath(sourceQuadrant, sourcePosition, targetQuadrant, targetPosition);
+		return FindMultiQuadrantPath(*sourceQuadrant, sourcePosition, *targetQuadrant, targetPosition);
+	}
+	// Lots of units headed here, follow the shared field
+	else if (auto flowField = FindFlowField(targetPosition))
+	{
+		return PathFromFlowField(*flowField, sourcePosition, targetPosition);
 	}
 	// Sweet, are they in the same sector?
 	else if (sourcePosition.m_sectorCoords != targetPosition.m_sectorCoords)
 	{
-		return FindSingleQuadrantPath(FetchQuadrant(targetPosition.m_quadrantCoords), sourcePosition, targetPosition);
+		return FindSingleQuadrantPath(*targetQuadrant, sourcePosition, targetPosition);
 	}
 	// Excellent. Cheap pathing
 	else
 	{
-		auto& sector = FetchQuadrant(targetPosition.m_quadrantCoords)
-			.m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
+		auto& sector = targetQuadrant->m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
 		return FindSingleSectorPath(sector.m_tileMovementCosts, sourcePosition, targetPosition);
 	}
 	return std::nullopt;
 }
 
+std::shared_ptr<const WorldTile::QuadrantFlowField> WorldTile::FindFlowField(const TilePosition& targetPosition)
+{
+	auto quadrantFound = FindQuadrant(targetPosition.m_quadrantCoords);
+	if (!quadrantFound)
+	{
+		return nullptr;
+	}
+	auto& quadrant = *quadrantFound;
+	{
+		std::lock_guard<std::mutex> cacheLock(m_pathCacheMutex);
+		if (auto flowField = m_flowFields.Find(targetPosition))
+		{
+			if (std::all_of((*flowField)->m_sectorVersions.begin(), (*flowField)->m_sectorVersions.end(), [](const auto& sectorVersion) {
+				return sectorVersion.first->m_pathingVersion == sectorVersion.second;
+			}))
+			{
+				return *flowField;
+			}
+			m_flowFields.Erase(targetPosition);
+		}
+		auto demand = m_flowFieldDemand.Find(targetPosition);
+		if (!demand)
+		{
+			m_flowFieldDemand.Insert(targetPosition, 1);
+			return nullptr;
+		}
+		if (++*demand < c_flowFieldMinimumRequests)
+		{
+			return nullptr;
+		}
+		m_flowFieldDemand.Erase(targetPosition);
+	}
+
+	PROFILE_ZONE("WorldTile::BuildFlowField");
+	auto flowField = std::make_shared<QuadrantFlowField>();
+	for (auto&& sectorRow : quadrant.m_sectors)
+	{
+		for (auto&& sector : sectorRow)
+		{
+			flowField->m_sectorVersions.emplace_back(&sector, sector.m_pathingVersion.load());
+		}
+	}
+	flowField->m_field = Pathing::BuildFlowField<Pathing::BucketOpenList, c_quadrantTiles, c_quadrantTiles>(
+		[&quadrant](int x, int y) -> const std::optional<int>& {
+			return quadrant.m_sectors[x / TileConstants::SECTOR_SIDE_LENGTH][y / TileConstants::SECTOR_SIDE_LENGTH]
+				.m_tileMovementCosts[x % TileConstants::SECTOR_SIDE_LENGTH][y % TileConstants::SECTOR_SIDE_LENGTH];
+		},
+		targetPosition.m_sectorCoords * TileConstants::SECTOR_SIDE_LENGTH + targetPosition.m_coords);
+
+	// Another worker may have built the same field meanwhile, either copy will do
+	std::lock_guard<std::mutex> cacheLock(m_pathCacheMutex);
+	m_flowFields.Insert(targetPosition, flowField);
+	return flowField;
+}
+
+std::optional<ECS_Core::Components::MoveToPoint> WorldTile::PathFromFlowField(
+	const QuadrantFlowField& flowField,
+	const TilePosition& sourcePosition,
+	const TilePosition& targetPosition)
+{
+	auto fieldPath = flowField.m_field.PathFrom(
+		sourcePosition.m_sectorCoords * TileConstants::SECTOR_SIDE_LENGTH + sourcePosition.m_coords);
+	if (!fieldPath)
+	{
+		return std::nullopt;
+	}
+	// The field was built from this quadrant, so it's done spawning
+	auto& quadrant = *FindQuadrant(targetPosition.m_quadrantCoords);
+	ECS_Core::Components::MoveToPoint path;
+	// Costs counted the same way as FindSingleQuadrantPath, source tile included
+	for (auto&& coordinate : fieldPath->m_path)
+	{
+		CoordinateVector2 sectorCoords(coordinate.m_x / TileConstants::SECTOR_SIDE_LENGTH, coordinate.m_y / TileConstants::SECTOR_SIDE_LENGTH);
+		CoordinateVector2 tileCoords(coordinate.m_x % TileConstants::SECTOR_SIDE_LENGTH, coordinate.m_y % TileConstants::SECTOR_SIDE_LENGTH);
+		auto movementCost = quadrant.m_sectors[sectorCoords.m_x][sectorCoords.m_y]
+			.m_tileMovementCosts[tileCoords.m_x][tileCoords.m_y].value_or(0);
+		path.m_path.Append({ targetPosition.m_quadrantCoords, sectorCoords, tileCoords }, movementCost);
+		path.m_totalPathCost += movementCost;
+	}
+	path.m_targetPosition = targetPosition;
+	return path;
+}
+
 const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadrantPath(
 	const WorldTile::Quadrant& sourceQuadrant,
 	const TilePosition& sourcePosition,
 	const WorldTile::Quadrant& targetQuadrant,
 	const TilePosition& targetPosition)
 {
+	PROFILE_ZONE("WorldTile::FindMultiQuadrantPath");
 	// Get shortest path between quadrants
-	auto quadrantPathCostCopyPtr = std::make_unique<decltype(m_quadrantMovementCosts)>(m_quadrantMovementCosts);
-	auto& quadrantPathCostCopy = *quadrantPathCostCopyPtr;
-	auto quadrantPathCopyPtr = std::make_unique<decltype(m_quadrantPaths)>(m_quadrantPaths);
-	auto& quadrantPathCopy = *quadrantPathCopyPtr;
+	// The shared crossing costs are read in place, only this query's start and end are kept aside
+	Pathing::EndpointCosts<s64> quadrantEndpoints(sourcePosition.m_quadrantCoords, targetPosition.m_quadrantCoords);
+	using QuadrantPath = decltype(m_quadrantPaths)::mapped_type::value_type::value_type;
+	std::array<QuadrantPath, static_cast<int>(PathingDirection::_COUNT)> startingPaths;
+	std::array<QuadrantPath, static_cast<int>(PathingDirection::_COUNT)> endingPaths;
+	auto targetFlowField = FindFlowField(targetPosition);
 	// Fill in the cost from current point to each side
 	for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
 	{
@@ -1878,35 +2653,25 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 				FindSingleQuadrantPath(sourceQuadrant, sourcePosition, *startingExitTile);
 			if (startingPath)
 			{
-				quadrantPathCostCopy[sourcePosition.m_quadrantCoords]
-					[static_cast<int>(PathingDirection::_COUNT)][direction]
-					= startingPath->m_totalPathCost;
-				quadrantPathCopy[sourcePosition.m_quadrantCoords]
-					[static_cast<int>(PathingDirection::_COUNT)][direction]
-					= startingPath->m_path;
+				quadrantEndpoints.m_originExits[direction] = startingPath->m_totalPathCost;
+				startingPaths[direction] = std::move(startingPath->m_path);
 			}
 		}
 		auto endingEntranceTile = GetQuadrantSideTile(targetQuadrant, targetPosition.m_quadrantCoords, direction);
 		if (endingEntranceTile)
 		{
-			auto endingPath =
-				FindSingleQuadrantPath(targetQuadrant, *endingEntranceTile, targetPosition);
+			auto endingPath = targetFlowField
+				? PathFromFlowField(*targetFlowField, *endingEntranceTile, targetPosition)
+				: FindSingleQuadrantPath(targetQuadrant, *endingEntranceTile, targetPosition);
 			if (endingPath)
 			{
-				quadrantPathCostCopy[targetPosition.m_quadrantCoords]
-					[direction][static_cast<int>(PathingDirection::_COUNT)]
-					= endingPath->m_totalPathCost;
-				quadrantPathCopy[targetPosition.m_quadrantCoords]
-					[direction][static_cast<int>(PathingDirection::_COUNT)]
-					= endingPath->m_path;
+				quadrantEndpoints.m_goalEntries[direction] = endingPath->m_totalPathCost;
+				endingPaths[direction] = std::move(endingPath->m_path);
 			}
 		}
 	}
 
-	auto quadrantPath = Pathing::GetPath(
-		quadrantPathCostCopy,
-		sourcePosition.m_quadrantCoords,
-		targetPosition.m_quadrantCoords);
+	auto quadrantPath = Pathing::GetPath(m_quadrantMovementCosts, quadrantEndpoints);
 
 	if (quadrantPath)
 	{
@@ -1926,37 +2691,8 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 			{
 				// A bit of a waste of space if there are only 2
 				// Shame
-				auto sectorCrossingPathCostsPtr = std::make_unique<
-					Quadrant::PathCostArray<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH * 3>>();
-				auto& sectorCrossingPathCosts = *sectorCrossingPathCostsPtr;
-
-				auto sectorCrossingPathsPtr = std::make_unique<
-					Quadrant::PathArray<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH * 3>>();
-				auto& sectorCrossingPaths = *sectorCrossingPathsPtr;
-
-				auto tileMovementsPtr = std::make_unique<Sector::MultiSectorMovementArray<
-					TileConstants::QUADRANT_SIDE_LENGTH,
-					TileConstants::QUADRANT_SIDE_LENGTH * 3,
-					TileConstants::SECTOR_SIDE_LENGTH,
-					TileConstants::SECTOR_SIDE_LENGTH>>();
-				auto& tileMovements = *tileMovementsPtr;
-
 				auto leastY = min(firstQuadrant.m_node.m_y, lastQuadrant.m_node.m_y);
 				auto greatestY = max(firstQuadrant.m_node.m_y, lastQuadrant.m_node.m_y);
-				for (auto y = leastY; y <= greatestY; ++y)
-				{
-					auto& quadrant = FetchQuadrant({ firstQuadrant.m_node.m_x, y });
-					for (int sectorX = 0; sectorX < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorX)
-					{
-						for (int sectorY = 0; sectorY < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorY)
-						{
-							auto yIndex = sectorY + TileConstants::QUADRANT_SIDE_LENGTH * (y - leastY);
-							sectorCrossingPathCosts[sectorX][yIndex] = quadrant.m_sectorCrossingPathCosts[sectorX][sectorY];
-							sectorCrossingPaths[sectorX][yIndex] = quadrant.m_sectorCrossingPaths[sectorX][sectorY];
-							tileMovements[sectorX][yIndex] = quadrant.m_sectors[sectorX][sectorY].m_tileMovementCosts;
-						}
-					}
-				}
 				auto localOffset = TilePosition({ sourcePosition.m_quadrantCoords.m_x, leastY }, {}, {});
 				auto localSourcePosition = sourcePosition - localOffset;
 				auto localTargetPosition = targetPosition - localOffset;
@@ -1965,14 +2701,18 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 				for (; localTargetPosition.m_quadrantCoords.m_y > 0;
 					--localTargetPosition.m_quadrantCoords.m_y, localTargetPosition.m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH);
 
-				auto& startingSector = FetchQuadrant(sourcePosition.m_quadrantCoords).m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
-				auto& endingSector = FetchQuadrant(targetPosition.m_quadrantCoords).m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
-				PrepareStartAndEndSectorPaths(
-					startingSector, sourcePosition.m_coords, localSourcePosition.m_sectorCoords,
-					sectorCrossingPathCosts, sectorCrossingPaths,
-					endingSector, targetPosition.m_coords, localTargetPosition.m_sectorCoords);
+				SectorGraphView<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH * 3> sectors(
+					localSourcePosition.m_sectorCoords, localTargetPosition.m_sectorCoords);
+				for (auto y = leastY; y <= greatestY; ++y)
+				{
+					sectors.SetQuadrant(0, static_cast<int>(y - leastY), FindQuadrant({ firstQuadrant.m_node.m_x, y }));
+				}
+
+				auto& startingSector = sourceQuadrant.m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
+				auto& endingSector = targetQuadrant.m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
+				PrepareStartAndEndSectorPaths(startingSector, sourcePosition.m_coords, endingSector, targetPosition.m_coords, sectors);
 
-				auto localPath = FindSingleQuadrantPath(sectorCrossingPathCosts, sectorCrossingPaths, tileMovements, localSourcePosition, localTargetPosition);
+				auto localPath = FindSingleQuadrantPath(sectors, localSourcePosition, localTargetPosition);
 				if (localPath)
 				{
 					ECS_Core::Components::MoveToPoint overallPath;
@@ -1982,12 +2722,10 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 						// operator+ handles conversion back into standard size quadrants
 						auto globalCoordinate = coordinate + localOffset;
 						auto movementCost =
-							*FetchQuadrant(globalCoordinate.m_quadrantCoords).
+							*FindQuadrant(globalCoordinate.m_quadrantCoords)->
 							m_sectors[globalCoordinate.m_sectorCoords.m_x][globalCoordinate.m_sectorCoords.m_y].
 							m_tileMovementCosts[globalCoordinate.m_coords.m_x][globalCoordinate.m_coords.m_y];
-						overallPath.m_path.push_back({
-							globalCoordinate,
-							movementCost });
+						overallPath.m_path.Append(globalCoordinate, movementCost);
 						overallPath.m_totalPathCost += movementCost;
 					}
 					overallPath.m_targetPosition = targetPosition;
@@ -1996,37 +2734,8 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 			}
 			else if (firstQuadrant.m_node.m_y == lastQuadrant.m_node.m_y)
 			{
-				auto sectorCrossingPathCostsPtr = std::make_unique<
-					Quadrant::PathCostArray<TileConstants::QUADRANT_SIDE_LENGTH * 3, TileConstants::QUADRANT_SIDE_LENGTH>>();
-				auto& sectorCrossingPathCosts = *sectorCrossingPathCostsPtr;
-
-				auto sectorCrossingPathsPtr = std::make_unique<
-					Quadrant::PathArray<TileConstants::QUADRANT_SIDE_LENGTH * 3, TileConstants::QUADRANT_SIDE_LENGTH>>();
-				auto& sectorCrossingPaths = *sectorCrossingPathsPtr;
-
-				auto tileMovementsPtr = std::make_unique<Sector::MultiSectorMovementArray<
-					TileConstants::QUADRANT_SIDE_LENGTH * 3,
-					TileConstants::QUADRANT_SIDE_LENGTH,
-					TileConstants::SECTOR_SIDE_LENGTH,
-					TileConstants::SECTOR_SIDE_LENGTH>>();
-				auto& tileMovements = *tileMovementsPtr;
-
 				auto leastX = min(firstQuadrant.m_node.m_x, lastQuadrant.m_node.m_x);
 				auto greatestX = max(firstQuadrant.m_node.m_x, lastQuadrant.m_node.m_x);
-				for (auto x = leastX; x <= greatestX; ++x)
-				{
-					auto& quadrant = FetchQuadrant({ x, firstQuadrant.m_node.m_y });
-					for (int sectorX = 0; sectorX < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorX)
-					{
-						for (int sectorY = 0; sectorY < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorY)
-						{
-							auto xIndex = sectorX + TileConstants::QUADRANT_SIDE_LENGTH * (x - leastX);
-							sectorCrossingPathCosts[xIndex][sectorY] = quadrant.m_sectorCrossingPathCosts[sectorX][sectorY];
-							sectorCrossingPaths[xIndex][sectorY] = quadrant.m_sectorCrossingPaths[sectorX][sectorY];
-							tileMovements[xIndex][sectorY] = quadrant.m_sectors[sectorX][sectorY].m_tileMovementCosts;
-						}
-					}
-				}
 				auto localOffset = TilePosition({ leastX, sourcePosition.m_quadrantCoords.m_y }, {}, {});
 				auto localSourcePosition = sourcePosition - localOffset;
 				auto localTargetPosition = targetPosition - localOffset;
@@ -2035,14 +2744,18 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 				for (; localTargetPosition.m_quadrantCoords.m_x > 0;
 					--localTargetPosition.m_quadrantCoords.m_x, localTargetPosition.m_sectorCoords.m_x += TileConstants::QUADRANT_SIDE_LENGTH);
 
-				auto& startingSector = FetchQuadrant(sourcePosition.m_quadrantCoords).m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
-				auto& endingSector = FetchQuadrant(targetPosition.m_quadrantCoords).m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
-				PrepareStartAndEndSectorPaths(
-					startingSector, sourcePosition.m_coords, localSourcePosition.m_sectorCoords,
-					sectorCrossingPathCosts, sectorCrossingPaths,
-					endingSector, targetPosition.m_coords, localTargetPosition.m_sectorCoords);
+				SectorGraphView<TileConstants::QUADRANT_SIDE_LENGTH * 3, TileConstants::QUADRANT_SIDE_LENGTH> sectors(
+					localSourcePosition.m_sectorCoords, localTargetPosition.m_sectorCoords);
+				for (auto x = leastX; x <= greatestX; ++x)
+				{
+					sectors.SetQuadrant(static_cast<int>(x - leastX), 0, FindQuadrant({ x, firstQuadrant.m_node.m_y }));
+				}
+
+				auto& startingSector = sourceQuadrant.m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
+				auto& endingSector = targetQuadrant.m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
+				PrepareStartAndEndSectorPaths(startingSector, sourcePosition.m_coords, endingSector, targetPosition.m_coords, sectors);
 
-				auto localPath = FindSingleQuadrantPath(sectorCrossingPathCosts, sectorCrossingPaths, tileMovements, localSourcePosition, localTargetPosition);
+				auto localPath = FindSingleQuadrantPath(sectors, localSourcePosition, localTargetPosition);
 				if (localPath)
 				{
 					ECS_Core::Components::MoveToPoint overallPath;
@@ -2052,12 +2765,10 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 						// operator+ handles conversion back into standard size quadrants
 						auto globalCoordinate = coordinate + localOffset;
 						auto movementCost =
-							*FetchQuadrant(globalCoordinate.m_quadrantCoords).
+							*FindQuadrant(globalCoordinate.m_quadrantCoords)->
 							m_sectors[globalCoordinate.m_sectorCoords.m_x][globalCoordinate.m_sectorCoords.m_y].
 							m_tileMovementCosts[globalCoordinate.m_coords.m_x][globalCoordinate.m_coords.m_y];
-						overallPath.m_path.push_back({
-							globalCoordinate,
-							movementCost });
+						overallPath.m_path.Append(globalCoordinate, movementCost);
 						overallPath.m_totalPathCost += movementCost;
 					}
 					overallPath.m_targetPosition = targetPosition;
@@ -2066,45 +2777,12 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 			}
 			else
 			{
-				auto sectorCrossingPathCostsPtr = std::make_unique<
-					Quadrant::PathCostArray<TileConstants::QUADRANT_SIDE_LENGTH * 2, TileConstants::QUADRANT_SIDE_LENGTH * 2>>();
-				auto& sectorCrossingPathCosts = *sectorCrossingPathCostsPtr;
-
-				auto sectorCrossingPathsPtr = std::make_unique<
-					Quadrant::PathArray<TileConstants::QUADRANT_SIDE_LENGTH * 2, TileConstants::QUADRANT_SIDE_LENGTH * 2>>();
-				auto& sectorCrossingPaths = *sectorCrossingPathsPtr;
-
-				auto tileMovementsPtr = std::make_unique<Sector::MultiSectorMovementArray<
-					TileConstants::QUADRANT_SIDE_LENGTH * 2,
-					TileConstants::QUADRANT_SIDE_LENGTH * 2,
-					TileConstants::SECTOR_SIDE_LENGTH,
-					TileConstants::SECTOR_SIDE_LENGTH>>();
-				auto& tileMovements = *tileMovementsPtr;
-
 				// They're diagonally adjacent. Include the cross-adjacent quadrants
 				auto lessX = min(firstQuadrant.m_node.m_x, lastQuadrant.m_node.m_x);
 				auto lessY = min(firstQuadrant.m_node.m_y, lastQuadrant.m_node.m_y);
 				auto greaterX = max(firstQuadrant.m_node.m_x, lastQuadrant.m_node.m_x);
 				auto greaterY = max(firstQuadrant.m_node.m_y, lastQuadrant.m_node.m_y);
 
-				for (auto x = lessX; x <= greaterX; ++x)
-				{
-					auto xIndex = (x - lessX) * TileConstants::QUADRANT_SIDE_LENGTH;
-					for (auto y = lessY; y <= greaterY; ++y)
-					{
-						auto yIndex = (y - lessY) * TileConstants::QUADRANT_SIDE_LENGTH;
-						auto& quadrant = FetchQuadrant({ x, y });
-						for (int sectorX = 0; sectorX < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorX)
-						{
-							for (int sectorY = 0; sectorY < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorY)
-							{
-								sectorCrossingPathCosts[xIndex + sectorX][yIndex + sectorY] = quadrant.m_sectorCrossingPathCosts[sectorX][sectorY];
-								sectorCrossingPaths[xIndex + sectorX][yIndex + sectorY] = quadrant.m_sectorCrossingPaths[sectorX][sectorY];
-								tileMovements[xIndex + sectorX][yIndex + sectorY] = quadrant.m_sectors[sectorX][sectorY].m_tileMovementCosts;
-							}
-						}
-					}
-				}
 				auto localOffset = TilePosition({ lessX, lessY }, {}, {});
 				auto localSourcePosition = sourcePosition - localOffset;
 				auto localTargetPosition = targetPosition - localOffset;
@@ -2117,14 +2795,22 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 				for (; localTargetPosition.m_quadrantCoords.m_y > 0;
 					--localTargetPosition.m_quadrantCoords.m_y, localTargetPosition.m_sectorCoords.m_y += TileConstants::QUADRANT_SIDE_LENGTH);
 
-				auto& startingSector = FetchQuadrant(sourcePosition.m_quadrantCoords).m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
-				auto& endingSector = FetchQuadrant(targetPosition.m_quadrantCoords).m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
-				PrepareStartAndEndSectorPaths(
-					startingSector, sourcePosition.m_coords, localSourcePosition.m_sectorCoords,
-					sectorCrossingPathCosts, sectorCrossingPaths,
-					endingSector, targetPosition.m_coords, localTargetPosition.m_sectorCoords);
+				SectorGraphView<TileConstants::QUADRANT_SIDE_LENGTH * 2, TileConstants::QUADRANT_SIDE_LENGTH * 2> sectors(
+					localSourcePosition.m_sectorCoords, localTargetPosition.m_sectorCoords);
+				for (auto x = lessX; x <= greaterX; ++x)
+				{
+					for (auto y = lessY; y <= greaterY; ++y)
+					{
+						// The cross-adjacent quadrants may still be spawning, their sectors are left out until they're done
+						sectors.SetQuadrant(static_cast<int>(x - lessX), static_cast<int>(y - lessY), FindQuadrant({ x, y }));
+					}
+				}
+
+				auto& startingSector = sourceQuadrant.m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y];
+				auto& endingSector = targetQuadrant.m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y];
+				PrepareStartAndEndSectorPaths(startingSector, sourcePosition.m_coords, endingSector, targetPosition.m_coords, sectors);
 
-				auto localPath = FindSingleQuadrantPath(sectorCrossingPathCosts, sectorCrossingPaths, tileMovements, localSourcePosition, localTargetPosition);
+				auto localPath = FindSingleQuadrantPath(sectors, localSourcePosition, localTargetPosition);
 				if (localPath)
 				{
 					ECS_Core::Components::MoveToPoint overallPath;
@@ -2134,12 +2820,10 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 						// operator+ handles conversion back into standard size quadrants
 						auto globalCoordinate = coordinate + localOffset;
 						auto movementCost =
-							*FetchQuadrant(globalCoordinate.m_quadrantCoords).
+							*FindQuadrant(globalCoordinate.m_quadrantCoords)->
 							m_sectors[globalCoordinate.m_sectorCoords.m_x][globalCoordinate.m_sectorCoords.m_y].
 							m_tileMovementCosts[globalCoordinate.m_coords.m_x][globalCoordinate.m_coords.m_y];
-						overallPath.m_path.push_back({
-							globalCoordinate,
-							movementCost });
+						overallPath.m_path.Append(globalCoordinate, movementCost);
 						overallPath.m_totalPathCost += movementCost;
 					}
 					overallPath.m_targetPosition = targetPosition;
@@ -2156,39 +2840,27 @@ const std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindMultiQuadr
 			const auto& startingMacroPath = quadrantPath->m_path.front();
 			const auto& endingMacroPath = quadrantPath->m_path.back();
 			ECS_Core::Components::MoveToPoint overallPath;
-			for (auto&& tile : *quadrantPathCopy[sourcePosition.m_quadrantCoords]
-				[static_cast<int>(PathingDirection::_COUNT)][static_cast<int>(startingMacroPath.m_exitDirection)])
-			{
-				overallPath.m_path.push_back(tile);
-			}
-			overallPath.m_totalPathCost += *quadrantPathCostCopy[sourcePosition.m_quadrantCoords]
-				[static_cast<int>(PathingDirection::_COUNT)][static_cast<int>(startingMacroPath.m_exitDirection)];
+			auto appendTile = [&overallPath](const TilePosition& tile, int movementCost) {
+				overallPath.m_path.Append(tile, movementCost);
+			};
+			startingPaths[static_cast<int>(startingMacroPath.m_exitDirection)]->ForEachTile(appendTile);
+			overallPath.m_totalPathCost += *quadrantEndpoints.m_originExits[static_cast<int>(startingMacroPath.m_exitDirection)];
 
 			for (int i = 1; i < quadrantPath->m_path.size() - 1; ++i)
 			{
 				auto& path = quadrantPath->m_path[i];
-				auto& crossingPath = quadrantPathCopy
-					[path.m_node]
+				auto& crossingPath = m_quadrantPaths.at(path.m_node)
 				[static_cast<int>(path.m_entryDirection)]
 				[static_cast<int>(path.m_exitDirection)];
-				for (auto&& tile : *crossingPath)
-				{
-					overallPath.m_path.push_back(tile);
-				}
-				overallPath.m_totalPathCost += *quadrantPathCostCopy
-					[path.m_node]
+				crossingPath->ForEachTile(appendTile);
+				overallPath.m_totalPathCost += *m_quadrantMovementCosts.at(path.m_node)
 				[static_cast<int>(path.m_entryDirection)]
 				[static_cast<int>(path.m_exitDirection)];
 			}
 
-			for (auto&& tile : *quadrantPathCopy[targetPosition.m_quadrantCoords]
-				[static_cast<int>(endingMacroPath.m_entryDirection)][static_cast<int>(PathingDirection::_COUNT)])
-			{
-				overallPath.m_path.push_back(tile);
-			}
+			endingPaths[static_cast<int>(endingMacroPath.m_entryDirection)]->ForEachTile(appendTile);
 			overallPath.m_targetPosition = targetPosition;
-			overallPath.m_totalPathCost += *quadrantPathCostCopy[targetPosition.m_quadrantCoords]
-				[static_cast<int>(endingMacroPath.m_entryDirection)][static_cast<int>(PathingDirection::_COUNT)];
+			overallPath.m_totalPathCost += *quadrantEndpoints.m_goalEntries[static_cast<int>(endingMacroPath.m_entryDirection)];
 			return overallPath;
 		}
 	}
@@ -2209,8 +2881,8 @@ std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindSingleSectorPath
 		ECS_Core::Components::MoveToPoint path;
 		for (auto&& tile : totalPath->m_path)
 		{
-			path.m_path.push_back({ { sourcePosition.m_quadrantCoords, sourcePosition.m_sectorCoords, tile },
-				*movementCosts[tile.m_x][tile.m_y] });
+			path.m_path.Append({ sourcePosition.m_quadrantCoords, sourcePosition.m_sectorCoords, tile },
+				*movementCosts[tile.m_x][tile.m_y]);
 		}
 		path.m_targetPosition = targetPosition;
 		path.m_totalPathCost = totalPath->m_totalPathCost;
@@ -2233,16 +2905,13 @@ std::optional<CoordinateVector2> WorldTile::GetSectorBorderTile(const Sector& se
 	return CoordinateVector2{ 0,0 };
 }
 
-template <int X, int Y>
+template <int SX, int SY>
 void WorldTile::PrepareStartAndEndSectorPaths(
 	const WorldTile::Sector& startingSector,
 	const CoordinateVector2& sourceTilePosition,
-	const CoordinateVector2& sourceSectorCoords,
-	Quadrant::PathCostArray<X, Y>& pathCosts,
-	Quadrant::PathArray<X, Y>& paths,
 	const WorldTile::Sector& endingSector,
 	const CoordinateVector2& targetTilePosition,
-	const CoordinateVector2& targetSectorCoords)
+	SectorGraphView<SX, SY>& sectors)
 {
 	for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
 	{
@@ -2255,12 +2924,8 @@ void WorldTile::PrepareStartAndEndSectorPaths(
 				*borderTile);
 			if (startingPath)
 			{
-				pathCosts[sourceSectorCoords.m_x][sourceSectorCoords.m_y]
-					[static_cast<int>(PathingDirection::_COUNT)][direction]
-					= startingPath->m_totalPathCost;
-				paths[sourceSectorCoords.m_x][sourceSectorCoords.m_y]
-					[static_cast<int>(PathingDirection::_COUNT)][direction]
-					= startingPath->m_path;
+				sectors.m_endpoints.m_originExits[direction] = startingPath->m_totalPathCost;
+				sectors.m_originExitPaths[direction] = std::move(startingPath->m_path);
 			}
 		}
 		borderTile = GetSectorBorderTile(endingSector, static_cast<PathingDirection>(direction));
@@ -2272,12 +2937,8 @@ void WorldTile::PrepareStartAndEndSectorPaths(
 				targetTilePosition);
 			if (endingPath)
 			{
-				pathCosts[targetSectorCoords.m_x][targetSectorCoords.m_y]
-					[direction][static_cast<int>(PathingDirection::_COUNT)]
-					= endingPath->m_totalPathCost;
-				paths[targetSectorCoords.m_x][targetSectorCoords.m_y]
-					[direction][static_cast<int>(PathingDirection::_COUNT)]
-					= endingPath->m_path;
+				sectors.m_endpoints.m_goalEntries[direction] = endingPath->m_totalPathCost;
+				sectors.m_goalEntryPaths[direction] = std::move(endingPath->m_path);
 			}
 		}
 	}
@@ -2288,51 +2949,40 @@ std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindSingleQuadrantPa
 	const TilePosition& sourcePosition,
 	const TilePosition& targetPosition)
 {
-	auto sectorPathCostCopyPtr = std::make_unique<decltype(quadrant.m_sectorCrossingPathCosts)>(quadrant.m_sectorCrossingPathCosts);
-	auto sectorPathCopyPtr = std::make_unique<decltype(quadrant.m_sectorCrossingPaths)>(quadrant.m_sectorCrossingPaths);
-	auto sectorPathCostCopy = *sectorPathCostCopyPtr;
-	auto sectorPathCopy = *sectorPathCopyPtr;
-
-	auto movementCostsCopyPtr = std::make_unique<Sector::MultiSectorMovementArray<
-		TileConstants::QUADRANT_SIDE_LENGTH,
-		TileConstants::QUADRANT_SIDE_LENGTH,
-		TileConstants::SECTOR_SIDE_LENGTH,
-		TileConstants::SECTOR_SIDE_LENGTH>>();
-	auto& movementCostsCopy = *movementCostsCopyPtr;
-	for (int secX = 0; secX < TileConstants::QUADRANT_SIDE_LENGTH; ++secX)
-	{
-		for (int secY = 0; secY < TileConstants::QUADRANT_SIDE_LENGTH; ++secY)
-		{
-			movementCostsCopy[secX][secY] = quadrant.m_sectors[secX][secY].m_tileMovementCosts;
-		}
-	}
+	SectorGraphView<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH> sectors(
+		sourcePosition.m_sectorCoords, targetPosition.m_sectorCoords);
+	sectors.SetQuadrant(0, 0, &quadrant);
 
 	// Fill in the cost from current point to each side
 	PrepareStartAndEndSectorPaths(
 		quadrant.m_sectors[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y],
 		sourcePosition.m_coords,
-		sourcePosition.m_sectorCoords,
-		sectorPathCostCopy,
-		sectorPathCopy,
 		quadrant.m_sectors[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y],
 		targetPosition.m_coords,
-		targetPosition.m_sectorCoords);
+		sectors);
+
+	auto landmarks = quadrant.m_landmarks.load();
+	if (landmarks && !std::all_of(landmarks->m_sectorVersions.begin(), landmarks->m_sectorVersions.end(), [](const auto& sectorVersion) {
+		return sectorVersion.first->m_pathingVersion == sectorVersion.second;
+	}))
+	{
+		// Mid-respawn of a neighbor, search without bounds until they're rebuilt
+		landmarks = nullptr;
+	}
 
-	auto pathTilePositions = FindSingleQuadrantPath(sectorPathCostCopy, sectorPathCopy, movementCostsCopy, sourcePosition, targetPosition);
+	auto pathTilePositions = FindSingleQuadrantPath(sectors, sourcePosition, targetPosition,
+		landmarks ? &landmarks->m_oracle : nullptr);
 	if (pathTilePositions)
 	{
 		ECS_Core::Components::MoveToPoint overallPath;
 		// Translate back from local to global
 		for (auto&& coordinate : *pathTilePositions)
 		{
-			// operator+ handles conversion back into standard size quadrants
+			// Every tile is in this quadrant
 			auto movementCost =
-				*FetchQuadrant(coordinate.m_quadrantCoords).
-				m_sectors[coordinate.m_sectorCoords.m_x][coordinate.m_sectorCoords.m_y].
+				*quadrant.m_sectors[coordinate.m_sectorCoords.m_x][coordinate.m_sectorCoords.m_y].
 				m_tileMovementCosts[coordinate.m_coords.m_x][coordinate.m_coords.m_y];
-			overallPath.m_path.push_back({
-				coordinate,
-				movementCost });
+			overallPath.m_path.Append(coordinate, movementCost);
 			overallPath.m_totalPathCost += movementCost;
 		}
 		overallPath.m_targetPosition = targetPosition;
@@ -2341,18 +2991,28 @@ std::optional<ECS_Core::Components::MoveToPoint> WorldTile::FindSingleQuadrantPa
 	return std::nullopt;
 }
 
-template <int SX, int SY, int X, int Y>
+template <int SX, int SY>
 std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
-	Quadrant::PathCostArray<SX,SY>& sectorPathCostCopy,
-	Quadrant::PathArray<SX,SY>& sectorPathCopy,
-	const Sector::MultiSectorMovementArray<SX, SY, X, Y>& sectorMovementCosts,
+	const SectorGraphView<SX, SY>& sectors,
 	const TilePosition& sourcePosition,
-	const TilePosition& targetPosition)
+	const TilePosition& targetPosition,
+	const Pathing::LandmarkOracle<SX, SY>* landmarks)
 {
-	auto sectorPath = Pathing::GetPath(
-		sectorPathCostCopy,
-		sourcePosition.m_sectorCoords,
-		targetPosition.m_sectorCoords);
+	auto crossingCost = [&sectors](int sectorX, int sectorY, int entry, int exit) {
+		return sectors.CrossingCost(sectorX, sectorY, entry, exit);
+	};
+	auto sectorPath = landmarks
+		? Pathing::GetDirectionalPath<Pathing::HeapOpenList, SX, SY>(
+			crossingCost,
+			sourcePosition.m_sectorCoords,
+			targetPosition.m_sectorCoords,
+			[landmarks, &targetPosition](int sectorX, int sectorY, int entry) {
+				return landmarks->LowerBound(sectorX, sectorY, entry, targetPosition.m_sectorCoords);
+			})
+		: Pathing::GetDirectionalPath<Pathing::HeapOpenList, SX, SY>(
+			crossingCost,
+			sourcePosition.m_sectorCoords,
+			targetPosition.m_sectorCoords);
 
 	if (sectorPath)
 	{
@@ -2379,7 +3039,7 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 				auto greatestY = max(firstSector.m_node.m_y, lastSector.m_node.m_y);
 				for (auto y = leastY; y <= greatestY; ++y)
 				{
-					auto& sector = sectorMovementCosts[firstSector.m_node.m_x][y];
+					auto& sector = sectors.SectorAt(firstSector.m_node.m_x, y).m_tileMovementCosts;
 					for (int tileX = 0; tileX < TileConstants::SECTOR_SIDE_LENGTH; ++tileX)
 					{
 						for (int tileY = 0; tileY < TileConstants::SECTOR_SIDE_LENGTH; ++tileY)
@@ -2402,11 +3062,10 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 				{
 					std::deque<TilePosition> overallPath;
 					// Translate back from local to global
-					for (auto&& coordinate : localPath->m_path)
-					{
+					localPath->m_path.ForEachTile([&overallPath, &localOffset](const TilePosition& tile, int) {
 						// operator+ handles conversion back into standard size quadrants
-						overallPath.push_back(coordinate.m_tile + localOffset);
-					}
+						overallPath.push_back(tile + localOffset);
+					});
 					return overallPath;
 				}
 			}
@@ -2419,7 +3078,7 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 				auto greatestX = max(firstSector.m_node.m_x, lastSector.m_node.m_x);
 				for (auto x = leastX; x <= greatestX; ++x)
 				{
-					auto& sector = sectorMovementCosts[x][firstSector.m_node.m_y];
+					auto& sector = sectors.SectorAt(x, firstSector.m_node.m_y).m_tileMovementCosts;
 					for (int tileX = 0; tileX < TileConstants::SECTOR_SIDE_LENGTH; ++tileX)
 					{
 						for (int tileY = 0; tileY < TileConstants::SECTOR_SIDE_LENGTH; ++tileY)
@@ -2442,11 +3101,10 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 				{
 					std::deque<TilePosition> overallPath;
 					// Translate back from local to global
-					for (auto&& coordinate : localPath->m_path)
-					{
+					localPath->m_path.ForEachTile([&overallPath, &localOffset](const TilePosition& tile, int) {
 						// operator+ handles conversion back into standard size quadrants
-						overallPath.push_back(coordinate.m_tile + localOffset);
-					}
+						overallPath.push_back(tile + localOffset);
+					});
 					return overallPath;
 				}
 			}
@@ -2466,7 +3124,12 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 					for (auto y = lessY; y <= greaterY; ++y)
 					{
 						auto yIndex = (y - lessY) * TileConstants::SECTOR_SIDE_LENGTH;
-						auto& sector = sectorMovementCosts[x][y];
+						if (!sectors.QuadrantOf(x, y))
+						{
+							// The cross-adjacent quadrant is still spawning, its tiles stay unpathable
+							continue;
+						}
+						auto& sector = sectors.SectorAt(x, y).m_tileMovementCosts;
 						for (int sectorX = 0; sectorX < TileConstants::SECTOR_SIDE_LENGTH; ++sectorX)
 						{
 							for (int sectorY = 0; sectorY < TileConstants::SECTOR_SIDE_LENGTH; ++sectorY)
@@ -2493,11 +3156,10 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 				{
 					std::deque<TilePosition> overallPath;
 					// Translate back from local to global
-					for (auto&& coordinate : localPath->m_path)
-					{
+					localPath->m_path.ForEachTile([&overallPath, &localOffset](const TilePosition& tile, int) {
 						// operator+ handles conversion back into standard size quadrants
-						overallPath.push_back(coordinate.m_tile + localOffset);
-					}
+						overallPath.push_back(tile + localOffset);
+					});
 					return overallPath;
 				}
 			}
@@ -2511,8 +3173,8 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 			const auto& startingMacroPath = sectorPath->m_path.front();
 			const auto& endingMacroPath = sectorPath->m_path.back();
 			std::deque<TilePosition> overallPath;
-			for (auto&& tile : *sectorPathCopy[sourcePosition.m_sectorCoords.m_x][sourcePosition.m_sectorCoords.m_y]
-				[static_cast<int>(PathingDirection::_COUNT)][static_cast<int>(startingMacroPath.m_exitDirection)])
+			for (auto&& tile : sectors.CrossingPath(sourcePosition.m_sectorCoords.m_x, sourcePosition.m_sectorCoords.m_y,
+				static_cast<int>(PathingDirection::_COUNT), static_cast<int>(startingMacroPath.m_exitDirection)))
 			{
 				overallPath.push_back({ sourcePosition.m_quadrantCoords, sourcePosition.m_sectorCoords, tile });
 			}
@@ -2520,19 +3182,19 @@ std::optional<std::deque<TilePosition>> WorldTile::FindSingleQuadrantPath(
 			for (int i = 1; i < sectorPath->m_path.size() - 1; ++i)
 			{
 				auto& path = sectorPath->m_path[i];
-				auto& crossingPath = sectorPathCopy
-					[path.m_node.m_x]
-				[path.m_node.m_y]
-				[static_cast<int>(path.m_entryDirection)]
-				[static_cast<int>(path.m_exitDirection)];
-				for (auto&& tile : *crossingPath)
+				auto& crossingPath = sectors.CrossingPath(
+					path.m_node.m_x,
+					path.m_node.m_y,
+					static_cast<int>(path.m_entryDirection),
+					static_cast<int>(path.m_exitDirection));
+				for (auto&& tile : crossingPath)
 				{
 					overallPath.push_back({ sourcePosition.m_quadrantCoords,{ path.m_node.m_x, path.m_node.m_y }, tile });
 				}
 			}
 
-			for (auto&& tile : *sectorPathCopy[targetPosition.m_sectorCoords.m_x][targetPosition.m_sectorCoords.m_y]
-				[static_cast<int>(endingMacroPath.m_entryDirection)][static_cast<int>(PathingDirection::_COUNT)])
+			for (auto&& tile : sectors.CrossingPath(targetPosition.m_sectorCoords.m_x, targetPosition.m_sectorCoords.m_y,
+				static_cast<int>(endingMacroPath.m_entryDirection), static_cast<int>(PathingDirection::_COUNT)))
 			{
 				overallPath.push_back({ targetPosition.m_quadrantCoords, targetPosition.m_sectorCoords, tile });
 			}
@@ -2617,9 +3279,14 @@ void WorldTile::CollectTiles(std::set<TilePosition>& possibleTiles, int movesRem
 
 void WorldTile::ProgramInit() {}
 void WorldTile::SetupGameplay() {
-	std::thread([this]() {
-		auto spawnThread = SpawnQuadrant({ 0, 0 });
-		spawnThread.join();
+	for (auto&& windowEntity : m_managerRef.entitiesMatching<ECS_Core::Signatures::S_WindowInfo>())
+	{
+		m_headless = m_managerRef.getComponent<ECS_Core::Components::C_WindowInfo>(windowEntity).m_headless;
+	}
+
+	m_generationPool.submit([this]() {
+		auto baseSpawn = SpawnQuadrant({ 0, 0 });
+		WaitForGeneration(baseSpawn);
 		m_baseQuadrantSpawned = true;
 
 		for (int x = -1; x < 2; ++x)
@@ -2628,11 +3295,12 @@ void WorldTile::SetupGameplay() {
 			{
 				if (x != 0 || y != 0)
 				{
-					SpawnQuadrant({ x,y }).join();
+					auto spawn = SpawnQuadrant({ x,y });
+					WaitForGeneration(spawn);
 				}
 			}
 		}
-	}).detach();
+	});
 }
 
 void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
@@ -2649,14 +3317,19 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 			// and a random tile in that sector.
 			// If there's a path from the tile to all edges of the sector, spawn there.
 			bool tileFound{ false };
-			while (!tileFound)
+			// From the world seed too, so the same world starts the builder in the same place
+			auto startingTileStream = GenerationStreamKey(m_worldSeed, { 0, 0 }, STARTING_TILE);
+			for (u32 attempt = 0; !tileFound; ++attempt)
 			{
-				auto sectorX = rand() % QUADRANT_SIDE_LENGTH;
-				auto sectorY = rand() % QUADRANT_SIDE_LENGTH;
-				auto tileX = rand() % SECTOR_SIDE_LENGTH;
-				auto tileY = rand() % SECTOR_SIDE_LENGTH;
+				auto drawBelow = [startingTileStream, attempt](u32 draw, int bound) {
+					return static_cast<int>(CounterRandom::ToRange(CounterRandom::Draw(startingTileStream, (4 * attempt) + draw), bound));
+				};
+				auto sectorX = drawBelow(0, QUADRANT_SIDE_LENGTH);
+				auto sectorY = drawBelow(1, QUADRANT_SIDE_LENGTH);
+				auto tileX = drawBelow(2, SECTOR_SIDE_LENGTH);
+				auto tileY = drawBelow(3, SECTOR_SIDE_LENGTH);
 
-				auto& sector = FetchQuadrant({ 0,0 }).m_sectors[sectorX][sectorY];
+				auto& sector = FetchQuadrant({ 0,0 })->m_sectors[sectorX][sectorY];
 				if (sector.m_pathingBorderTiles[static_cast<int>(PathingDirection::NORTH)] &&
 					Pathing::GetPath(sector.m_tileMovementCosts,
 						{ tileX, tileY },
@@ -2749,6 +3422,12 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 		// Grow territories that are able to do so before taking any actions
 		GrowTerritories();
 
+		// Tile costs changed since the last frame, then paths asked for on earlier frames
+		ApplyMovementCostChanges();
+		DeliverPathResults();
+		ApplyPathResults();
+		RepairPaths();
+
 		m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_Planner>([&manager = m_managerRef, this](
 			const ecs::EntityIndex& governorEntity,
 			ECS_Core::Components::C_ActionPlan& actionPlan)
@@ -2762,21 +3441,14 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					if (!manager.hasComponent<ECS_Core::Components::C_TilePosition>(setMovement.m_mover)) continue;
 					if (!manager.hasComponent<ECS_Core::Components::C_MovingUnit>(setMovement.m_mover)) continue;
 					auto& sourcePosition = manager.getComponent<ECS_Core::Components::C_TilePosition>(setMovement.m_mover).m_position;
-					auto& targetPosition = setMovement.m_targetPosition;
 
-					auto path = GetPath(sourcePosition, targetPosition);
-					if (!path)
-					{
-						continue;
-					}
-
-					auto& movingUnit = manager.getComponent<ECS_Core::Components::C_MovingUnit>(setMovement.m_mover);
-					movingUnit.m_currentMovement = *path;
-
-					if (setMovement.m_targetingIcon)
-					{
-						manager.addTag<ECS_Core::Tags::T_Dead>(*setMovement.m_targetingIcon);
-					}
+					// The new path starts from the tile the unit is on now, so it waits there for the path to arrive
+					manager.getComponent<ECS_Core::Components::C_MovingUnit>(setMovement.m_mover).m_currentMovement.reset();
+					RequestPath(
+						manager.getEntityIndex(setMovement.m_mover),
+						sourcePosition,
+						{ setMovement.m_targetPosition },
+						setMovement.m_targetingIcon);
 				}
 				else if (std::holds_alternative<Action::CreateCaravan>(action.m_command))
 				{
@@ -2804,14 +3476,14 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					// Check that 
 					int sourceTotalMen{ 0 };
 					int sourceTotalWomen{ 0 };
-					for (auto&&[birthMonth, pop] : sourcePopulation.m_populations)
+					for (size_t cohort = 0; cohort < sourcePopulation.Size(); ++cohort)
 					{
-						if (pop.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+						if (sourcePopulation.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 						{
 							continue;
 						}
-						sourceTotalMen += pop.m_numMen;
-						sourceTotalWomen += pop.m_numWomen;
+						sourceTotalMen += sourcePopulation.m_numMen[cohort];
+						sourceTotalWomen += sourcePopulation.m_numWomen[cohort];
 					}
 					int totalMenToMove = 10;
 					int totalWomenToMove = 5;
@@ -2839,7 +3511,7 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					// Spawn entity for the unit, then take costs and population
 					// Then we'll take 100 each of the highest resource counts
 					auto newEntity = manager.createHandle();
-					manager.addComponent<ECS_Core::Components::C_TilePosition>(newEntity).m_position = path->m_path.front().m_tile;
+					manager.addComponent<ECS_Core::Components::C_TilePosition>(newEntity).m_position = path->m_path.Front();
 					manager.addComponent<ECS_Core::Components::C_PositionCartesian>(newEntity);
 					auto& movingUnit = manager.addComponent<ECS_Core::Components::C_MovingUnit>(newEntity);
 					manager.addComponent<ECS_Core::Components::C_Vision>(newEntity);
@@ -2853,26 +3525,26 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 					auto& population = manager.addComponent<ECS_Core::Components::C_Population>(newEntity);
 					int menMoved = 0;
 					int womenMoved = 0;
-					for (auto&&[birthMonth, pop] : sourcePopulation.m_populations)
+					for (size_t cohort = 0; cohort < sourcePopulation.Size(); ++cohort)
 					{
 						if (menMoved == totalMenToMove && totalWomenToMove == 5)
 						{
 							break;
 						}
-						if (pop.m_class != ECS_Core::Components::PopulationClass::WORKERS)
+						if (sourcePopulation.m_class[cohort] != ECS_Core::Components::PopulationClass::WORKERS)
 						{
 							continue;
 						}
-						auto menToMove = min<int>(totalMenToMove - menMoved, pop.m_numMen);
-						auto womenToMove = min<int>(totalWomenToMove - womenMoved, pop.m_numWomen);
+						auto menToMove = min<int>(totalMenToMove - menMoved, sourcePopulation.m_numMen[cohort]);
+						auto womenToMove = min<int>(totalWomenToMove - womenMoved, sourcePopulation.m_numWomen[cohort]);
 
-						auto& popCopy = population.m_populations[birthMonth];
-						popCopy = pop;
-						popCopy.m_numMen = menToMove;
-						popCopy.m_numWomen = womenToMove;
+						auto copyCohort = population.FindOrInsert(sourcePopulation.m_keys[cohort]);
+						population.CopyCohort(copyCohort, sourcePopulation, cohort);
+						population.m_numMen[copyCohort] = menToMove;
+						population.m_numWomen[copyCohort] = womenToMove;
 
-						pop.m_numMen -= menToMove;
-						pop.m_numWomen -= womenToMove;
+						sourcePopulation.m_numMen[cohort] -= menToMove;
+						sourcePopulation.m_numWomen[cohort] -= womenToMove;
 
 
 						menMoved += menToMove;
@@ -2960,7 +3632,7 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				const ECS_Core::Components::C_Population&,
 				ECS_Core::Components::C_CommandMessage& command)
 		{
-			if (mover.m_currentMovement)
+			if (mover.m_currentMovement || m_managerRef.hasComponent<ECS_Core::Components::C_PathRequest>(mI))
 			{
 				return ecs::IterationBehavior::CONTINUE;
 			}
@@ -2969,8 +3641,8 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				return ecs::IterationBehavior::CONTINUE;
 			}
 
-			mover.m_currentMovement = GetPath(tilePosition.m_position,
-				m_managerRef.getComponent<ECS_Core::Components::C_TilePosition>(command.m_commandee).m_position);
+			RequestPath(mI, tilePosition.m_position,
+				{ m_managerRef.getComponent<ECS_Core::Components::C_TilePosition>(command.m_commandee).m_position });
 			return ecs::IterationBehavior::CONTINUE;
 		});
 
@@ -2978,7 +3650,7 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 			m_managerRef.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>().front());
 		m_managerRef.forEntitiesMatching<ECS_Core::Signatures::S_MovingUnit>(
 			[this, &time](
-				const ecs::EntityIndex&,
+				const ecs::EntityIndex& explorerEntity,
 				const ECS_Core::Components::C_TilePosition& tilePosition,
 				ECS_Core::Components::C_MovingUnit& movement,
 				const ECS_Core::Components::C_Population&,
@@ -2989,9 +3661,10 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				// Only interested in explorers
 				return ecs::IterationBehavior::CONTINUE;
 			}
-			if (movement.m_currentMovement)
+			if (movement.m_currentMovement
+				|| m_managerRef.hasComponent<ECS_Core::Components::C_PathRequest>(explorerEntity))
 			{
-				// Only interested in the ones that aren't currently on a path
+				// Only interested in the ones that aren't currently on a path or waiting for one
 				return ecs::IterationBehavior::CONTINUE;
 			}
 
@@ -3009,11 +3682,7 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				}
 				else
 				{
-					auto path = GetPath(tilePosition.m_position, movement.m_explorationPlan->m_homeBasePosition);
-					if (path)
-					{
-						movement.m_currentMovement = path;
-					}
+					RequestPath(explorerEntity, tilePosition.m_position, { movement.m_explorationPlan->m_homeBasePosition });
 				}
 			}
 			else
@@ -3066,21 +3735,14 @@ void WorldTile::Operate(GameLoopPhase phase, const timeuS& frameDuration)
 				std::vector<TilePosition> positionVector(possibleTiles.begin(), possibleTiles.end());
 				std::sort(positionVector.begin(), positionVector.end(), sortFunction);
 
-				// Iterate through until we get a valid path
-				for (auto&& position : positionVector)
-				{
-					auto path = GetPath(tilePosition.m_position, position);
-					if (path)
-					{
-						movement.m_explorationPlan->m_visitedPathNodes.insert(position);
-						movement.m_currentMovement = path;
-						break;
-					}
-				}
+				// The worker takes the first of these it can find a path to
+				RequestPath(explorerEntity, tilePosition.m_position, std::move(positionVector));
 			}
 
 			return ecs::IterationBehavior::CONTINUE;
 		});
+
+		SubmitPathRequests();
 	}
 		break;
 
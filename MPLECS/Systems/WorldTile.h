@@ -25,47 +25,53 @@
 // A thickness of up to 3 quadrants may be spawned to try to create pathing 
 // to the target quadrant
 
+#include "../Core/TileConstants.h"
 #include "../ECS/System.h"
 
+#include "../Util/LruCache.h"
 #include "../Util/Pathing.h"
 
 #include <array>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
 
-namespace TileConstants
-{
-	constexpr int TILE_SIDE_LENGTH = 5;
-	constexpr int SECTOR_SIDE_LENGTH = 50;
-	constexpr int QUADRANT_SIDE_LENGTH = 8;
-
-	constexpr int BASE_QUADRANT_ORIGIN_COORDINATE =
-		-TILE_SIDE_LENGTH *
-		SECTOR_SIDE_LENGTH *
-		QUADRANT_SIDE_LENGTH / 2;
-
-	// Will later be configuration data
-	constexpr int TILE_TYPE_COUNT = 8;
-}
-
 class WorldTile : public SystemBase
 {
 	using QuadrantId = CoordinateVector2;
 public:
+	// Spawns quadrants and units and hands out paths, so every phase but INPUT and CLEANUP runs alone
+	using Access = SystemAccess<
+		StructuralPhase<GameLoopPhase::PREPARATION>,
+		PhaseAccess<GameLoopPhase::INPUT,
+			Reads<ECS_Core::Components::C_TilePosition, ECS_Core::Components::C_ResourceInventory, ECS_Core::Components::C_Population>,
+			Writes<ECS_Core::Components::C_UserInputs, ECS_Core::Components::C_MovingUnit, ECS_Core::Components::C_CommandMessage, ECS_Core::Components::C_ActionPlan>>,
+		StructuralPhase<GameLoopPhase::ACTION>,
+		StructuralPhase<GameLoopPhase::ACTION_RESPONSE>,
+		PhaseAccess<GameLoopPhase::CLEANUP,
+			Reads<ECS_Core::Components::C_BuildingDescription, ECS_Core::Components::C_TilePosition, ECS_Core::Components::C_Territory>,
+			Writes<>>>;
+
 	WorldTile() : SystemBase() { }
 	virtual ~WorldTile() {}
 	virtual void ProgramInit() override;
 	virtual void SetupGameplay() override;
 	virtual void Operate(GameLoopPhase phase, const timeuS& frameDuration) override;
 	virtual bool ShouldExit() override;
+
+	void SetWorldSeed(u32 worldSeed) { m_worldSeed = worldSeed; }
 protected:
+	// Kept for every tile of every spawned quadrant, so only what can't be derived
+	// Colors come from the tile type, through the palette, when the texture is built
 	struct Tile
 	{
-		ECS_Core::Components::TileType m_tileType;
-		std::optional<int> m_movementCost; // If notset, unpathable
-										   // Each 1 pixel is 4 components: RGBA
-		std::array<sf::Uint32, TileConstants::TILE_SIDE_LENGTH * TileConstants::TILE_SIDE_LENGTH> m_tilePixels;
 		std::optional<ecs::Impl::Handle> m_owningBuilding; // If notset, no building owns this tile
+		std::optional<int> m_movementCost; // If notset, unpathable
+		u8 m_tileType; // An ECS_Core::Components::TileType
 	};
+	static_assert(TileConstants::TILE_TYPE_COUNT <= 256, "Tile types are stored in a byte");
 
 	struct Sector
 	{
@@ -78,8 +84,8 @@ protected:
 		
 		MovementCostArray<TileConstants::SECTOR_SIDE_LENGTH, TileConstants::SECTOR_SIDE_LENGTH> m_tileMovementCosts;
 
-		template <int SX, int SY, int X, int Y>
-		using MultiSectorMovementArray = std::array<std::array<std::array<std::array<std::optional<int>, Y>, X>, SY>, SX>;
+		// Bumped whenever the paths through the sector are redone, cached paths through an older version are dropped
+		std::atomic<u32> m_pathingVersion{ 0 };
 
 		// Relevant index of the tile on each border being used for 
 		// pathing between sectors
@@ -102,45 +108,123 @@ protected:
 
 		sf::Texture m_texture;
 
-		template<int X, int Y>
-		using PathCostArray =
+		// The paths across one sector between its border tiles, and what they cost
+		struct SectorCrossings
+		{
 			std::array<
-				std::array<
-					std::array<
-						std::array<std::optional<int>, static_cast<int>(PathingDirection::_COUNT) + 1>, // Exit
-						static_cast<int>(PathingDirection::_COUNT) + 1>, // Entry
-					Y>,
-				X>;
-
-		template<int X, int Y>
-		using PathArray = 
+				std::array<std::optional<int>, static_cast<int>(PathingDirection::_COUNT) + 1>, // Exit
+				static_cast<int>(PathingDirection::_COUNT) + 1> // Entry
+				m_costs;
 			std::array<
-				std::array<
-					std::array<
-						std::array<std::optional<std::deque<CoordinateVector2>>, static_cast<int>(PathingDirection::_COUNT) + 1>, // Exit
-						static_cast<int>(PathingDirection::_COUNT) + 1>, // Entry
-					Y>,
-				X>;
-
-		PathCostArray <TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH>
-			m_sectorCrossingPathCosts;
-
-		PathArray <TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH>
-			m_sectorCrossingPaths;
+				std::array<std::optional<std::deque<CoordinateVector2>>, static_cast<int>(PathingDirection::_COUNT) + 1>, // Exit
+				static_cast<int>(PathingDirection::_COUNT) + 1> // Entry
+				m_paths;
+		};
+		// Searching a sector again builds a new SectorCrossings and stores it in whole,
+		// so a search that loaded the old one keeps reading it until it's done. nullptr until first searched
+		std::array<
+			std::array<std::atomic<std::shared_ptr<const SectorCrossings>>, TileConstants::QUADRANT_SIDE_LENGTH>,
+			TileConstants::QUADRANT_SIDE_LENGTH>
+			m_sectorCrossings;
 
 		std::array<std::map<s64, std::vector<s64>>, static_cast<int>(PathingDirection::_COUNT)> m_pathingBorderSectorCandidates;
 		std::array<std::optional<s64>, static_cast<int>(PathingDirection::_COUNT)> m_pathingBorderSectors;
 
-		bool m_spawningComplete{ false };
+		// Bounds for searches across the sectors, only good while every sector is still at the version recorded
+		struct Landmarks
+		{
+			Pathing::LandmarkOracle<TileConstants::QUADRANT_SIDE_LENGTH, TileConstants::QUADRANT_SIDE_LENGTH> m_oracle;
+			std::vector<std::pair<const Sector*, u32>> m_sectorVersions;
+		};
+		// Replaced in whole when a neighbor's spawning redoes the border crossings
+		std::atomic<std::shared_ptr<const Landmarks>> m_landmarks;
+
+		// Set by the generation worker once every sector is filled in, read by the main thread and the path searches
+		std::atomic<bool> m_spawningComplete{ false };
+		// The task filling the quadrant in, so a second spawn of it waits on the first
+		std::shared_future<void> m_spawned;
 	};
 	using SpawnedQuadrantMap = std::map<QuadrantId, Quadrant>;
 
+	// SX by SY sectors from one or more quadrants laid side by side, read in place.
+	// The start and goal sectors' paths for one query are kept here rather than written into the quadrants
+	// Each sector's crossings are loaded once as its quadrant is set, and held until the query is done
+	template <int SX, int SY>
+	struct SectorGraphView
+	{
+		SectorGraphView(const CoordinateVector2& sourceSector, const CoordinateVector2& targetSector)
+			: m_endpoints(sourceSector, targetSector)
+		{
+		}
+
+		// quadrant may be nullptr, its sectors can't be crossed then
+		void SetQuadrant(int quadrantX, int quadrantY, const Quadrant* quadrant)
+		{
+			m_quadrants[quadrantX][quadrantY] = quadrant;
+			for (int sectorX = 0; sectorX < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorX)
+			{
+				for (int sectorY = 0; sectorY < TileConstants::QUADRANT_SIDE_LENGTH; ++sectorY)
+				{
+					m_crossings[quadrantX * TileConstants::QUADRANT_SIDE_LENGTH + sectorX][quadrantY * TileConstants::QUADRANT_SIDE_LENGTH + sectorY] =
+						quadrant ? quadrant->m_sectorCrossings[sectorX][sectorY].load() : nullptr;
+				}
+			}
+		}
+
+		const Quadrant* QuadrantOf(int sectorX, int sectorY) const
+		{
+			return m_quadrants[sectorX / TileConstants::QUADRANT_SIDE_LENGTH][sectorY / TileConstants::QUADRANT_SIDE_LENGTH];
+		}
+
+		const Sector& SectorAt(int sectorX, int sectorY) const
+		{
+			return QuadrantOf(sectorX, sectorY)->m_sectors
+				[sectorX % TileConstants::QUADRANT_SIDE_LENGTH]
+				[sectorY % TileConstants::QUADRANT_SIDE_LENGTH];
+		}
+
+		std::optional<int> CrossingCost(int sectorX, int sectorY, int entry, int exit) const
+		{
+			auto& crossings = m_crossings[sectorX][sectorY];
+			return m_endpoints.Overlay({ sectorX, sectorY }, entry, exit,
+				crossings
+				? crossings->m_costs[entry][exit]
+				: std::nullopt);
+		}
+
+		// Only for sectors on a path found through CrossingCost
+		const std::deque<CoordinateVector2>& CrossingPath(int sectorX, int sectorY, int entry, int exit) const
+		{
+			if (entry == static_cast<int>(PathingDirection::_COUNT)
+				&& m_originExitPaths[exit]
+				&& CoordinateVector2(sectorX, sectorY) == m_endpoints.m_origin)
+			{
+				return *m_originExitPaths[exit];
+			}
+			if (exit == static_cast<int>(PathingDirection::_COUNT)
+				&& m_goalEntryPaths[entry]
+				&& CoordinateVector2(sectorX, sectorY) == m_endpoints.m_goal)
+			{
+				return *m_goalEntryPaths[entry];
+			}
+			return *m_crossings[sectorX][sectorY]->m_paths[entry][exit];
+		}
+
+		std::array<
+			std::array<const Quadrant*, SY / TileConstants::QUADRANT_SIDE_LENGTH>,
+			SX / TileConstants::QUADRANT_SIDE_LENGTH>
+			m_quadrants{};
+		std::array<std::array<std::shared_ptr<const Quadrant::SectorCrossings>, SY>, SX> m_crossings;
+
+		Pathing::EndpointCosts<int> m_endpoints;
+		std::array<std::optional<std::deque<CoordinateVector2>>, static_cast<int>(PathingDirection::_COUNT)> m_originExitPaths;
+		std::array<std::optional<std::deque<CoordinateVector2>>, static_cast<int>(PathingDirection::_COUNT)> m_goalEntryPaths;
+	};
+
 	struct SectorSeed
 	{
-		int m_seedTileType{ rand() % TileConstants::TILE_TYPE_COUNT };
-		CoordinateVector2 m_seedPosition{
-			rand() % TileConstants::SECTOR_SIDE_LENGTH,
-			rand() % TileConstants::SECTOR_SIDE_LENGTH };
+		int m_seedTileType;
+		CoordinateVector2 m_seedPosition;
 	};
 	struct SectorSeedPosition
 	{
@@ -149,14 +233,6 @@ protected:
 		// Top left sector (-1, -1) from current sector is origin
 		CoordinateVector2 m_position;
 	};
-	struct QuadrantSeed
-	{
-		std::array<
-			std::array<SectorSeed, TileConstants::QUADRANT_SIDE_LENGTH>,
-			TileConstants::QUADRANT_SIDE_LENGTH>
-			m_sectors;
-	};
-	using SeededQuadrantMap = std::map<QuadrantId, QuadrantSeed>;
 	using WorldCoordinates = TilePosition;
 
 	struct TileSide
@@ -195,8 +271,14 @@ protected:
 	WorldCoordinates WorldPositionToCoordinates(const CoordinateVector2 & worldPos);
 	CoordinateVector2 CoordinatesToWorldPosition(const WorldCoordinates & worldCoords);
 	CoordinateVector2 CoordinatesToWorldOffset(const WorldCoordinates & worldOffset);
-	void SeedForQuadrant(const CoordinateVector2& coordinates);
-	std::vector<WorldTile::SectorSeedPosition> GetRelevantSeeds(
+	SectorSeed SeedForSector(
+		const CoordinateVector2& quadrantCoords,
+		s64 secX,
+		s64 secY) const;
+	// The seeds of a sector and the 8 around it
+	static constexpr int c_relevantSeedCount = 9;
+	using RelevantSeeds = std::array<SectorSeedPosition, c_relevantSeedCount>;
+	RelevantSeeds GetRelevantSeeds(
 		const CoordinateVector2 & coordinates,
 		int secX,
 		int secY) const;
@@ -206,15 +288,24 @@ protected:
 		ECS_Core::Components::C_TileProductionPotential & yieldPotential,
 		const ECS_Core::Components::C_Territory & territory);
 	std::optional<Tile*> GetTile(const TilePosition& buildingTilePos);
-	Quadrant& FetchQuadrant(const CoordinateVector2 & quadrantCoords);
-	std::thread SpawnQuadrant(const CoordinateVector2& coordinates);
+	// Starts spawning the quadrant, and the world up to it, if it isn't there yet.
+	// nullptr until it has finished spawning. Only from Operate, not the generation or pathing workers
+	Quadrant* FetchQuadrant(const CoordinateVector2 & quadrantCoords);
+	// nullptr until the quadrant has finished spawning. Never spawns
+	const Quadrant* FindQuadrant(const CoordinateVector2& quadrantCoords) const;
+	// Generation tasks run on m_generationPool, and finish before their future is ready
+	std::shared_future<void> SpawnQuadrant(const CoordinateVector2& coordinates);
+	void WaitForGeneration(std::future<void>& task);
+	void WaitForGeneration(const std::shared_future<void>& task);
+	void WaitForGeneration(std::vector<std::future<void>>& tasks);
 	void FillSectorPathing(
 		Sector& sector,
-		std::vector<std::thread>& pathFindingThreads,
+		std::vector<std::future<void>>& pathFindingTasks,
 		Quadrant& quadrant,
 		int sectorI,
 		int sectorJ);
 	void FillQuadrantPathingEdges(Quadrant& quadrant);
+	void BuildQuadrantLandmarks(Quadrant& quadrant);
 	void FillCrossQuadrantPaths(
 		Quadrant& quadrant,
 		const CoordinateVector2& coordinates);
@@ -222,7 +313,7 @@ protected:
 		const Quadrant& quadrant,
 		const CoordinateVector2& quadrantCoords,
 		int direction);
-	std::thread SpawnBetween(
+	std::future<void> SpawnBetween(
 		CoordinateVector2 origin,
 		CoordinateVector2 target);
 	void ReturnDeadBuildingTiles();
@@ -233,7 +324,69 @@ protected:
 	void ProcessPlanDirectionScout(const Action::LocalPlayer::PlanDirectionScout& planDirectionScout, const ecs::EntityIndex & governorEntity);
 	void CancelMovementPlans();
 
+	void RequestPath(
+		ecs::EntityIndex requester,
+		const TilePosition& sourcePosition,
+		std::vector<TilePosition> targetPositions,
+		const std::optional<ecs::Impl::Handle>& targetingIcon = std::nullopt);
+	void DeliverPathResults();
+	void ApplyPathResults();
+	void SubmitPathRequests();
+
+	// Changes are queued, and applied at the start of an ACTION once no path search is running
+	// New searches are held back while changes wait, rather than the main thread waiting on the running ones
+	// Costs below c_minimumTileMovementCost are raised to it
+	void SetTileMovementCost(const TilePosition& position, std::optional<int> movementCost);
+	void ApplyMovementCostChanges();
+	// Moves the units whose paths pass near changed tiles onto the best path under the new costs
+	// A unit's first repair is searched on the pathing workers, and joined on when the search comes back
+	// Later changes repair it in place with the search that came back with it
+	void RepairPaths();
+	std::optional<CompactPath> RepairPath(
+		ECS_Core::Components::MoveToPoint& movement,
+		const TilePosition& sourcePosition,
+		const std::vector<CoordinateVector2>& changedTiles);
+	// The whole path from the source when it's outside the window. Callers hold m_pathingDataMutex shared
+	std::optional<ECS_Core::Components::MoveToPoint> BuildRepairSearch(
+		const TilePosition& sourcePosition,
+		const TilePosition& targetPosition,
+		const CoordinateVector2& windowLow,
+		const CoordinateVector2& windowHigh);
+	// The tile costs under a repair search's window, the quadrants looked up once rather than for every tile searched
+	struct WindowCosts
+	{
+		CoordinateVector2 m_windowOrigin;
+		CoordinateVector2 m_firstQuadrant;
+		s64 m_quadrantRows{ 0 };
+		std::vector<const Quadrant*> m_quadrants;
+
+		const std::optional<int>& operator()(s64 x, s64 y) const;
+		// Tiles searched in the window, as a path through the world
+		CompactPath ToCompactPath(const std::deque<CoordinateVector2>& path) const;
+	};
+	WindowCosts GetWindowCosts(const CoordinateVector2& windowOrigin, int width, int height) const;
+	// Keeps the part of the path already walked, and goes on from the unit's tile along the remaining path
+	// False if the remaining path doesn't pass the unit's tile
+	bool SpliceRemainingPath(ECS_Core::Components::MoveToPoint& movement, const CompactPath& remainingPath);
+
+	// Served from the path cache where possible
+	// The searches only look quadrants up, callers hold m_pathingDataMutex shared
 	std::optional<ECS_Core::Components::MoveToPoint> GetPath(const TilePosition& sourcePosition, const TilePosition& targetPosition);
+	std::optional<ECS_Core::Components::MoveToPoint> FindPath(const TilePosition& sourcePosition, const TilePosition& targetPosition);
+
+	// Next step toward one target tile from every tile of the target's quadrant
+	struct QuadrantFlowField
+	{
+		Pathing::FlowField m_field;
+		// Each sector of the quadrant, and its pathing version when the field was built
+		std::vector<std::pair<const Sector*, u32>> m_sectorVersions;
+	};
+	// Only built once enough paths have been asked for to the target, nullptr until then
+	std::shared_ptr<const QuadrantFlowField> FindFlowField(const TilePosition& targetPosition);
+	std::optional<ECS_Core::Components::MoveToPoint> PathFromFlowField(
+		const QuadrantFlowField& flowField,
+		const TilePosition& sourcePosition,
+		const TilePosition& targetPosition);
 
 	const std::optional<ECS_Core::Components::MoveToPoint> FindMultiQuadrantPath(
 		const WorldTile::Quadrant& sourceQuadrant,
@@ -241,23 +394,19 @@ protected:
 		const WorldTile::Quadrant& targetQuadrant,
 		const TilePosition& targetPosition);
 	
-	template<int SX, int SY, int X, int Y>
+	template<int SX, int SY>
 	std::optional<std::deque<TilePosition>> FindSingleQuadrantPath(
-		Quadrant::PathCostArray<SX, SY>& pathCosts,
-		Quadrant::PathArray<SX, SY>& paths,
-		const Sector::MultiSectorMovementArray<SX, SY, X, Y>& sectorMovementCosts,
+		const SectorGraphView<SX, SY>& sectors,
 		const TilePosition& sourcePosition,
-		const TilePosition& targetPosition);
-	template <int X, int Y>
+		const TilePosition& targetPosition,
+		const Pathing::LandmarkOracle<SX, SY>* landmarks = nullptr);
+	template <int SX, int SY>
 	void PrepareStartAndEndSectorPaths(
 		const WorldTile::Sector& startingSector,
 		const CoordinateVector2& sourceTilePosition,
-		const CoordinateVector2& sourceSectorCoords,
-		Quadrant::PathCostArray<X, Y>& pathCosts,
-		Quadrant::PathArray<X, Y>& paths,
 		const WorldTile::Sector& endingSector,
 		const CoordinateVector2& targetTilePosition,
-		const CoordinateVector2& targetSectorCoords);
+		SectorGraphView<SX, SY>& sectors);
 	std::optional<ECS_Core::Components::MoveToPoint> FindSingleQuadrantPath(
 		const WorldTile::Quadrant& quadrant,
 		const TilePosition& sourcePosition,
@@ -279,26 +428,97 @@ protected:
 	};
 
 	using CoordinateFromOriginSet = std::set<CoordinateVector2, SortByOriginDist>;
+	// Callers hold m_quadrantMapMutex
 	void TouchConnectedCoordinates(
 		const CoordinateVector2& origin,
 		CoordinateFromOriginSet& untouched,
 		CoordinateFromOriginSet& touched);
 
+	// Callers hold m_quadrantMapMutex when searching m_spawnedQuadrants
 	CoordinateVector2 FindNearestQuadrant(const SpawnedQuadrantMap & searchedQuadrants, const CoordinateVector2 & quadrantCoords);
 
 	CoordinateVector2 FindNearestQuadrant(const CoordinateFromOriginSet & searchedQuadrants, const CoordinateVector2 & quadrantCoords);
 
 	void CollectTiles(std::set<TilePosition>& possibleTiles, int movesRemaining, const TilePosition& position);
 
+	// The path searches hold this shared while they read the cross-quadrant graph
+	// and the borders picked between sectors and quadrants. Anything changing those holds it unique
+	mutable std::shared_mutex m_pathingDataMutex;
+	// Only held to find, insert or walk the quadrants, never while waiting on another lock,
+	// so the main thread's lookups don't queue behind the path searches.
+	// Quadrants are never removed, so a reference into the map outlives the lock it was found under
+	mutable std::mutex m_quadrantMapMutex;
 	SpawnedQuadrantMap m_spawnedQuadrants;
+	// Quadrants FetchQuadrant has already started spawning. Only touched from Operate
+	std::set<CoordinateVector2> m_requestedQuadrants;
 	Pathing::DirectionMovementCostMap m_quadrantMovementCosts;
 	std::map<CoordinateVector2,
 		std::array<
-			std::array<std::optional<std::vector<ECS_Core::Components::MovementTilePosition>>, static_cast<int>(PathingDirection::_COUNT) + 1>
+			std::array<std::optional<CompactPath>, static_cast<int>(PathingDirection::_COUNT) + 1>
 			, static_cast<int>(PathingDirection::_COUNT) + 1>>
 		m_quadrantPaths;
+
+	struct CachedPath
+	{
+		ECS_Core::Components::MoveToPoint m_path;
+		// Each sector the path passes through, and its pathing version when the path was found
+		std::vector<std::pair<const Sector*, u32>> m_sectorVersions;
+	};
+	static constexpr size_t c_pathCacheCapacity = 1024;
+	LruCache<std::pair<TilePosition, TilePosition>, CachedPath> m_pathCache{ c_pathCacheCapacity };
+	// Targets asked for this many times get a flow field, so later units just follow it
+	static constexpr u32 c_flowFieldMinimumRequests = 8;
+	static constexpr size_t c_flowFieldCapacity = 16;
+	LruCache<TilePosition, u32> m_flowFieldDemand{ c_pathCacheCapacity };
+	LruCache<TilePosition, std::shared_ptr<const QuadrantFlowField>> m_flowFields{ c_flowFieldCapacity };
+	// The pathing workers share the caches with Operate
+	std::mutex m_pathCacheMutex;
+
+	struct PathJob
+	{
+		ecs::Impl::Handle m_requester;
+		u64 m_requestId{ 0 };
+		TilePosition m_sourcePosition;
+		std::vector<TilePosition> m_targetPositions;
+		std::optional<std::pair<CoordinateVector2, CoordinateVector2>> m_repairWindow;
+	};
+	struct PathJobResult
+	{
+		ecs::Impl::Handle m_requester;
+		u64 m_requestId{ 0 };
+		TilePosition m_targetPosition;
+		std::optional<ECS_Core::Components::MoveToPoint> m_path;
+		// m_movementCostVersion when the search started
+		u32 m_movementCostVersion{ 0 };
+	};
+	// Every tile costs at least this to enter, the repair searches' heuristic counts on it
+	static constexpr int c_minimumTileMovementCost = 1;
+	std::vector<std::pair<TilePosition, std::optional<int>>> m_pendingMovementCosts;
+	// Bumped once applied changes are searched into the sectors, results searched before are searched again
+	std::atomic<u32> m_movementCostVersion{ 0 };
+	// Applied since the paths were last repaired
+	std::vector<TilePosition> m_changedMovementCosts;
+	// Tiles kept around the rest of a unit's path in its repair search
+	// Paths spanning more than the largest window are searched again whole instead
+	static constexpr int c_repairWindowMargin = 16;
+	static constexpr int c_maxRepairWindowSide = 256;
+
+	static constexpr size_t c_pathJobsPerTask = 16;
+	u64 m_nextPathRequestId{ 1 };
+	std::vector<std::future<std::vector<PathJobResult>>> m_pathBatches;
+
 	bool m_baseQuadrantSpawned{ false };
 	bool m_startingBuilderSpawned{ false };
-	SeededQuadrantMap m_quadrantSeeds;
+	// Set when running without a window, quadrants then skip building their textures
+	bool m_headless{ false };
+	// Everything generated comes from this, so the same seed always makes the same world
+	u32 m_worldSeed{ 0 };
+
+	// World generation and path searches get their own workers, so the main thread never picks them up
+	// while it helps the shared pool. Last members, so their workers stop before the data they read goes
+	// Path searches read the quadrants generation writes, so the pathing workers stop first
+	ecs::ThreadPool m_generationPool{ max<size_t>(1, ecs::ThreadPool::defaultWorkerCount() / 2) };
+	static constexpr size_t c_pathingWorkerCount = 2;
+	ecs::ThreadPool m_pathingPool{ c_pathingWorkerCount };
 };
 template <> std::unique_ptr<WorldTile> InstantiateSystem();
\ No newline at end of file
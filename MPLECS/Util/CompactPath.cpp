@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/CompactPath.cpp
+// Packing and walking the steps of a CompactPath
+
+#include "CompactPath.h"
+
+namespace
+{
+	// Indexed by PathingDirection, as Pathing::neighborOffsets
+	const TilePosition c_stepOffsets[] = {
+		{ { 0, 0 }, { 0, 0 }, { 0, -1 } }, // NORTH
+		{ { 0, 0 }, { 0, 0 }, { 0, 1 } }, // SOUTH
+		{ { 0, 0 }, { 0, 0 }, { 1, 0 } }, // EAST
+		{ { 0, 0 }, { 0, 0 }, { -1, 0 } }, // WEST
+	};
+}
+
+void CompactPath::Append(const TilePosition& tile, int movementCost)
+{
+	movementCost = min(max(movementCost, 0), c_maxMovementCost);
+	if (m_tileCount == 0)
+	{
+		m_first = tile;
+		m_firstMovementCost = movementCost;
+		m_last = tile;
+		m_current = Start();
+		++m_tileCount;
+		return;
+	}
+
+	u16 kind = STEP_JUMP;
+	if (tile == m_last)
+	{
+		kind = STEP_STAY;
+	}
+	else
+	{
+		for (u16 direction = 0; direction < static_cast<u16>(PathingDirection::_COUNT); ++direction)
+		{
+			if (m_last + c_stepOffsets[direction] == tile)
+			{
+				kind = direction;
+				break;
+			}
+		}
+	}
+	if (kind == STEP_JUMP)
+	{
+		m_jumps.emplace_back(m_last, tile);
+	}
+	m_steps.push_back(static_cast<u16>((kind << c_kindShift) | movementCost));
+	m_last = tile;
+	++m_tileCount;
+}
+
+void CompactPath::Reverse()
+{
+	m_reversed = !m_reversed;
+	m_current = Start();
+}
+
+CompactPath::Cursor CompactPath::Start() const
+{
+	Cursor cursor;
+	cursor.m_tile = Front();
+	return cursor;
+}
+
+void CompactPath::Advance(Cursor& cursor) const
+{
+	if (cursor.m_index + 1 >= m_tileCount)
+	{
+		return;
+	}
+	// Walking backwards crosses the step before the current tile, the other way round
+	auto stepIndex = m_reversed ? m_tileCount - 2 - cursor.m_index : cursor.m_index;
+	auto kind = m_steps[stepIndex] >> c_kindShift;
+	if (kind == STEP_JUMP)
+	{
+		if (m_reversed)
+		{
+			cursor.m_tile = m_jumps[m_jumps.size() - 1 - cursor.m_jumpsPassed].first;
+		}
+		else
+		{
+			cursor.m_tile = m_jumps[cursor.m_jumpsPassed].second;
+		}
+		++cursor.m_jumpsPassed;
+	}
+	else if (kind != STEP_STAY)
+	{
+		cursor.m_tile += c_stepOffsets[static_cast<int>(m_reversed
+			? Opposite(static_cast<PathingDirection>(kind))
+			: static_cast<PathingDirection>(kind))];
+	}
+	++cursor.m_index;
+}
+
+int CompactPath::MovementCostAt(const Cursor& cursor) const
+{
+	// Tile i's cost is on the step into it, the first tile has no step
+	auto tileIndex = m_reversed ? m_tileCount - 1 - cursor.m_index : cursor.m_index;
+	if (tileIndex == 0)
+	{
+		return m_firstMovementCost;
+	}
+	return m_steps[tileIndex - 1] & c_maxMovementCost;
+}
@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/CompactPath.h
+// A path of tiles, kept as its first tile and one packed step into each tile after it
+// Two bytes a tile, and it can be walked from either end without touching the steps
+
+#pragma once
+
+#include "../Core/typedef.h"
+
+#include <utility>
+#include <vector>
+
+class CompactPath
+{
+public:
+	// Steps can't record a higher movement cost than this
+	static constexpr int c_maxMovementCost = (1 << 13) - 1;
+
+	// Adds a tile at the back. Only for paths being built, before any Reverse
+	// Tiles are expected next to the one before, but a repeated tile or a jump comes back out the same
+	void Append(const TilePosition& tile, int movementCost);
+
+	bool Empty() const { return m_tileCount == 0; }
+	size_t Size() const { return m_tileCount; }
+	// In the order the path is walked
+	const TilePosition& Front() const { return m_reversed ? m_last : m_first; }
+	const TilePosition& Back() const { return m_reversed ? m_first : m_last; }
+
+	// The back becomes the front, and the walk starts over from there
+	void Reverse();
+
+	// Where the walk along the path has got to, starting at the front
+	const TilePosition& CurrentTile() const { return m_current.m_tile; }
+	int CurrentMovementCost() const { return MovementCostAt(m_current); }
+	size_t CurrentIndex() const { return m_current.m_index; }
+	bool AtBack() const { return m_current.m_index + 1 >= m_tileCount; }
+	// Stays put at the back
+	void Advance() { Advance(m_current); }
+
+	// callback(tile, movementCost) for each tile, front to back
+	template <typename Callback>
+	void ForEachTile(Callback&& callback) const
+	{
+		ForEachTileFrom(Start(), callback);
+	}
+	// As ForEachTile, from the current tile on
+	template <typename Callback>
+	void ForEachRemainingTile(Callback&& callback) const
+	{
+		ForEachTileFrom(m_current, callback);
+	}
+
+private:
+	enum StepKind : u16
+	{
+		// NORTH to WEST are the PathingDirection of the step
+		STEP_STAY = static_cast<u16>(PathingDirection::_COUNT),
+		// The tiles on each side of the step are in m_jumps
+		STEP_JUMP,
+	};
+	// Kind in the top 3 bits, movement cost of the tile stepped into below
+	static constexpr int c_kindShift = 13;
+
+	struct Cursor
+	{
+		// Tiles from the front
+		size_t m_index{ 0 };
+		TilePosition m_tile;
+		// m_jumps entries passed, from the front in walking order
+		size_t m_jumpsPassed{ 0 };
+	};
+
+	Cursor Start() const;
+	void Advance(Cursor& cursor) const;
+	int MovementCostAt(const Cursor& cursor) const;
+
+	template <typename Callback>
+	void ForEachTileFrom(Cursor cursor, Callback& callback) const
+	{
+		if (Empty())
+		{
+			return;
+		}
+		while (true)
+		{
+			callback(cursor.m_tile, MovementCostAt(cursor));
+			if (cursor.m_index + 1 >= m_tileCount)
+			{
+				return;
+			}
+			Advance(cursor);
+		}
+	}
+
+	TilePosition m_first;
+	int m_firstMovementCost{ 0 };
+	TilePosition m_last;
+	size_t m_tileCount{ 0 };
+	// Step i goes from tile i to tile i + 1, in the order the tiles were added
+	std::vector<u16> m_steps;
+	// The tiles before and after each STEP_JUMP step, in the order the tiles were added
+	std::vector<std::pair<TilePosition, TilePosition>> m_jumps;
+	bool m_reversed{ false };
+	Cursor m_current;
+};
@@ -0,0 +1,51 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/CounterRandom.h
+// Stateless random numbers: the n-th value of a stream is a hash of the stream's key and n
+// Nothing is shared between threads, and the same keys always give the same values
+// Only 32 bit integer math, so loops drawing a value per element can vectorize
+
+#pragma once
+
+#include "../Core/typedef.h"
+
+namespace CounterRandom
+{
+	// Murmur3 finalizer
+	inline u32 Mix(u32 x)
+	{
+		x ^= x >> 16;
+		x *= 0x85ebca6bu;
+		x ^= x >> 13;
+		x *= 0xc2b2ae35u;
+		x ^= x >> 16;
+		return x;
+	}
+
+	// Combines identifiers into the key of a stream
+	inline u32 StreamKey(u32 first, u32 second)
+	{
+		return Mix(first ^ Mix(second + 0x9e3779b9u));
+	}
+
+	inline u32 Draw(u32 streamKey, u32 counter)
+	{
+		return Mix(streamKey ^ Mix(counter * 0x9e3779b9u + 0x7f4a7c15u));
+	}
+
+	// Uniform in (0, 1), never exactly 0 so it can be divided by
+	inline f64 ToUnitDouble(u32 bits)
+	{
+		return (bits + 0.5) * (1. / 4294967296.);
+	}
+
+	// Uniform in [0, bound). Scaled rather than taken modulo, so all the bits count
+	inline u32 ToRange(u32 bits, u32 bound)
+	{
+		return static_cast<u32>((static_cast<u64>(bits) * bound) >> 32);
+	}
+}
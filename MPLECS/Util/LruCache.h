@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/LruCache.h
+// Map with a fixed number of entries
+// Once full, adding an entry drops the one that was used least recently
+
+#pragma once
+
+#include "../Core/typedef.h"
+
+#include <list>
+#include <map>
+#include <utility>
+
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+	explicit LruCache(size_t capacity)
+		: m_capacity(capacity)
+	{
+	}
+
+	// nullptr if the key isn't cached, otherwise marks the entry as just used
+	Value* Find(const Key& key)
+	{
+		auto indexIter = m_index.find(key);
+		if (indexIter == m_index.end())
+		{
+			return nullptr;
+		}
+		m_entries.splice(m_entries.begin(), m_entries, indexIter->second);
+		return &indexIter->second->second;
+	}
+
+	void Insert(const Key& key, Value value)
+	{
+		auto indexIter = m_index.find(key);
+		if (indexIter != m_index.end())
+		{
+			indexIter->second->second = std::move(value);
+			m_entries.splice(m_entries.begin(), m_entries, indexIter->second);
+			return;
+		}
+		if (m_entries.size() >= m_capacity && !m_entries.empty())
+		{
+			m_index.erase(m_entries.back().first);
+			m_entries.pop_back();
+		}
+		m_entries.emplace_front(key, std::move(value));
+		m_index.emplace(key, m_entries.begin());
+	}
+
+	void Erase(const Key& key)
+	{
+		auto indexIter = m_index.find(key);
+		if (indexIter == m_index.end())
+		{
+			return;
+		}
+		m_entries.erase(indexIter->second);
+		m_index.erase(indexIter);
+	}
+
+	void Clear()
+	{
+		m_entries.clear();
+		m_index.clear();
+	}
+
+	size_t Size() const { return m_entries.size(); }
+
+private:
+	using Entry = std::pair<Key, Value>;
+
+	// Most recently used first
+	std::list<Entry> m_entries;
+	std::map<Key, typename std::list<Entry>::iterator> m_index;
+	size_t m_capacity;
+};
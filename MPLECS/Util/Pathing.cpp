@@ -8,205 +8,211 @@
 // A*-based implementation of a pathing system
 
 #include "Pathing.h"
-namespace std
-{
-	bool operator<(const Pathing::SortedCoordinate& left, const Pathing::SortedCoordinate& right)
-	{
-		if (left.m_airDistToTarget == 0 && right.m_airDistToTarget != 0)
-		{
-			return true;
-		}
-		if (left.m_airDistToTarget != 0 && right.m_airDistToTarget == 0)
-		{
-			return false;
-		}
-		if ((left.m_airDistToTarget + left.m_costToPoint) < (right.m_airDistToTarget + right.m_costToPoint))
-		{
-			return true;
-		}
-		if ((left.m_airDistToTarget + left.m_costToPoint) > (right.m_airDistToTarget + right.m_costToPoint))
-		{
-			return false;
-		}
-		return left.m_coordinates < right.m_coordinates;
-	}
-
-	bool operator<(const Pathing::SortedDirectionalCoordinate& left, const Pathing::SortedDirectionalCoordinate& right)
-	{
-		if (left.m_airDistToTarget == 0 && right.m_airDistToTarget != 0)
-		{
-			return true;
-		}
-		if (left.m_airDistToTarget != 0 && right.m_airDistToTarget == 0)
-		{
-			return false;
-		}
-		if ((left.m_airDistToTarget + left.m_costToPoint) < (right.m_airDistToTarget + right.m_costToPoint))
-		{
-			return true;
-		}
-		if ((left.m_airDistToTarget + left.m_costToPoint) > (right.m_airDistToTarget + right.m_costToPoint))
-		{
-			return false;
-		}
-		if (left.m_entry < right.m_entry) return true;
-		if (left.m_entry > right.m_entry) return false;
-
-		if (left.m_exit < right.m_exit) return true;
-		if (left.m_exit > right.m_exit) return false;
-
-		return left.m_coordinates < right.m_coordinates;
-	}
-}
-
-PathingDirection Opposite(PathingDirection d)
-{
-	switch (d)
-	{
-	case PathingDirection::NORTH: return PathingDirection::SOUTH;
-	case PathingDirection::SOUTH: return PathingDirection::NORTH;
-	case PathingDirection::EAST:  return PathingDirection::WEST;
-	case PathingDirection::WEST:  return PathingDirection::EAST;
-	}
-	return PathingDirection::_COUNT;
-}
-
-PathingDirection Clockwise90(PathingDirection d)
-{
-	switch (d)
-	{
-	case PathingDirection::NORTH: return PathingDirection::EAST;
-	case PathingDirection::EAST: return PathingDirection::SOUTH;
-	case PathingDirection::SOUTH: return PathingDirection::WEST;
-	case PathingDirection::WEST: return PathingDirection::NORTH;
-	}
-	return PathingDirection::_COUNT;
-}
-
-PathingDirection Counterclockwise90(PathingDirection d)
-{
-	switch (d)
-	{
-	case PathingDirection::NORTH: return PathingDirection::WEST;
-	case PathingDirection::WEST: return PathingDirection::SOUTH;
-	case PathingDirection::SOUTH: return PathingDirection::EAST;
-	case PathingDirection::EAST: return PathingDirection::NORTH;
-	}
-	return PathingDirection::_COUNT;
-}
 
-Direction Opposite(Direction d)
+auto Pathing::GetPath(
+	const DirectionMovementCostMap& movementCosts,
+	const CoordinateVector2& origin,
+	const CoordinateVector2& goal) 
+	-> std::optional<MacroPath>
 {
-	switch (d)
-	{
-	case Direction::NORTH: return Direction::SOUTH;
-	case Direction::SOUTH: return Direction::NORTH;
-	case Direction::EAST:  return Direction::WEST;
-	case Direction::WEST:  return Direction::EAST;
-	case Direction::NORTHEAST: return Direction::SOUTHWEST;
-	case Direction::SOUTHEAST: return Direction::NORTHWEST;
-	case Direction::NORTHWEST:  return Direction::SOUTHEAST;
-	case Direction::SOUTHWEST:  return Direction::NORTHEAST;
-	}
-	return Direction::_COUNT;
+	return GetPath(movementCosts, EndpointCosts<s64>(origin, goal));
 }
 
 auto Pathing::GetPath(
 	const DirectionMovementCostMap& movementCosts,
-	const CoordinateVector2& origin,
-	const CoordinateVector2& goal) 
+	const EndpointCosts<s64>& endpoints)
 	-> std::optional<MacroPath>
 {
-	std::map<CoordinateVector2, std::map<int, std::set<int>>> visited;
-	std::map<CoordinateVector2, std::map<int, std::map<int, int>>> costToPoint;
-	std::map<CoordinateVector2, int> pointHeuristic;
-	std::map<CoordinateVector2, PathingDirection> fastestDirectionIntoNode;
+	const auto& origin = endpoints.m_origin;
+	const auto& goal = endpoints.m_goal;
+
+	// Number the nodes once, so the search state can live in flat arrays
+	// The endpoints may only have costs in the overlay
+	using NodeCosts = DirectionMovementCostMap::mapped_type;
+	std::map<CoordinateVector2, int> nodeIndices;
+	std::vector<CoordinateVector2> nodeCoordinates;
+	std::vector<const NodeCosts*> nodeCosts;
+	nodeCoordinates.reserve(movementCosts.size() + 2);
+	nodeCosts.reserve(movementCosts.size() + 2);
 	for (auto&&[coordinates, costs] : movementCosts)
 	{
-		for (int inDirection = static_cast<int>(PathingDirection::NORTH); inDirection <= static_cast<int>(PathingDirection::_COUNT); ++inDirection)
+		nodeIndices.emplace(coordinates, static_cast<int>(nodeCoordinates.size()));
+		nodeCoordinates.push_back(coordinates);
+		nodeCosts.push_back(&costs);
+	}
+	for (auto&& endpoint : { origin, goal })
+	{
+		if (nodeIndices.emplace(endpoint, static_cast<int>(nodeCoordinates.size())).second)
+		{
+			nodeCoordinates.push_back(endpoint);
+			nodeCosts.push_back(nullptr);
+		}
+	}
+	auto costOf = [&](int nodeIndex, int entry, int exit) -> std::optional<s64> {
+		auto costs = nodeCosts[nodeIndex];
+		return endpoints.Overlay(
+			nodeCoordinates[nodeIndex],
+			entry,
+			exit,
+			costs ? (*costs)[entry][exit] : std::nullopt);
+	};
+
+	auto& states = ThreadScratch<SearchWorkspace<s64>>();
+	states.Begin(nodeCoordinates.size() * c_directionalSides * c_directionalSides);
+
+	// Every node between here and the goal has to be crossed, at no less than the cheapest crossing
+	s64 minimumCrossing = std::numeric_limits<s64>::max();
+	for (auto&& costs : nodeCosts)
+	{
+		if (!costs) continue;
+		for (int entry = static_cast<int>(PathingDirection::NORTH); entry < static_cast<int>(PathingDirection::_COUNT); ++entry)
 		{
-			for (int outDirection = static_cast<int>(PathingDirection::NORTH); outDirection <= static_cast<int>(PathingDirection::_COUNT); ++outDirection)
+			for (int exit = static_cast<int>(PathingDirection::NORTH); exit < static_cast<int>(PathingDirection::_COUNT); ++exit)
 			{
-				costToPoint[coordinates][inDirection][outDirection] = std::numeric_limits<int>::max();
+				if ((*costs)[entry][exit])
+				{
+					minimumCrossing = min(minimumCrossing, *(*costs)[entry][exit]);
+				}
 			}
 		}
-		pointHeuristic[coordinates] = 0;
-		fastestDirectionIntoNode[coordinates] = PathingDirection::_COUNT;
 	}
-	std::set<SortedDirectionalCoordinate> openPoints;
+	if (minimumCrossing == std::numeric_limits<s64>::max())
+	{
+		minimumCrossing = 0;
+	}
+	// Estimated cost left once a state's node has been left by its exit
+	auto heuristic = [&goal, minimumCrossing](const CoordinateVector2& coordinates, int exit) {
+		if (exit == static_cast<int>(PathingDirection::_COUNT))
+		{
+			return 0;
+		}
+		return static_cast<int>(ManhattanDistance(coordinates + neighborOffsets[exit], goal) * minimumCrossing);
+	};
+
+	auto& openPoints = ThreadScratch<HeapOpenList<SortedDirectionalCoordinate>>();
+	openPoints.Clear();
+	auto originIndex = nodeIndices.at(origin);
 	for (int exitDirection = static_cast<int>(PathingDirection::NORTH); exitDirection <= static_cast<int>(PathingDirection::_COUNT); ++exitDirection)
 	{
-		if (!movementCosts.at(origin)[static_cast<int>(PathingDirection::_COUNT)][exitDirection]) continue;
+		if (!costOf(originIndex, static_cast<int>(PathingDirection::_COUNT), exitDirection)) continue;
 
 		// Cost to enter the current node is always 0
-		costToPoint[origin][static_cast<int>(PathingDirection::_COUNT)][exitDirection] = 0;
-		openPoints.insert({ origin, 0, pointHeuristic[origin], static_cast<int>(PathingDirection::_COUNT), exitDirection,{} });
+		states.Reach(DirectionalState(originIndex, static_cast<int>(PathingDirection::_COUNT), exitDirection), 0, c_noState);
+		auto estimate = heuristic(origin, exitDirection);
+		openPoints.Push(estimate,
+			{ origin, originIndex, 0, estimate, static_cast<int>(PathingDirection::_COUNT), exitDirection });
 	}
 
-	while (!openPoints.empty())
+	while (!openPoints.Empty())
 	{
-		auto currentNode = *openPoints.begin();
+		auto currentNode = openPoints.Pop();
+		auto currentState = currentNode.State();
 		if (currentNode.m_coordinates == goal && currentNode.m_exit == PathingDirection::_COUNT)
 		{
-			MacroPath result;
-			result.m_totalPathCost = costToPoint[goal]
-				[static_cast<int>(currentNode.m_entry)][static_cast<int>(currentNode.m_exit)];
-			result.m_path = currentNode.m_previousPath;
+			auto result = ReconstructMacroPath(currentState, [&states](int state) {
+				return states.Parent(state);
+			}, [&nodeCoordinates](int nodeIndex) {
+				return nodeCoordinates[nodeIndex];
+			});
+			result.m_totalPathCost = static_cast<int>(states.CostTo(currentState));
 			return result;
 		}
 
-		if (visited[currentNode.m_coordinates]
-			[static_cast<int>(currentNode.m_entry)].count(static_cast<int>(currentNode.m_exit)))
+		if (states.Visited(currentState))
 		{
-			openPoints.erase(currentNode);
 			continue;
 		}
 
-		visited[currentNode.m_coordinates]
-			[static_cast<int>(currentNode.m_entry)].insert(static_cast<int>(currentNode.m_exit));
+		states.Visit(currentState);
 
 		auto& neighborOffset = neighborOffsets[static_cast<int>(currentNode.m_exit)];
 		auto neighborCoords = currentNode.m_coordinates + neighborOffset;
-		auto neighborCostIter = movementCosts.find(neighborCoords);
-		if (neighborCostIter == movementCosts.end())
+		auto neighborIndexIter = nodeIndices.find(neighborCoords);
+		if (neighborIndexIter == nodeIndices.end())
 		{
-			openPoints.erase(currentNode);
 			continue;
 		}
-		auto nodeMovementCosts = neighborCostIter->second;
+		auto neighborIndex = neighborIndexIter->second;
 		auto originDirection = static_cast<int>(Opposite(currentNode.m_exit));
 		for (int exitDirection = static_cast<int>(PathingDirection::NORTH); exitDirection <= static_cast<int>(PathingDirection::_COUNT); ++exitDirection)
 		{
 			if (exitDirection == originDirection) continue;
-			if (!nodeMovementCosts[originDirection][exitDirection]) continue;
+			auto nodeMovementCost = costOf(neighborIndex, originDirection, exitDirection);
+			if (!nodeMovementCost) continue;
 
-			if (visited[neighborCoords][originDirection].count(exitDirection))
+			auto neighborState = DirectionalState(neighborIndex, originDirection, exitDirection);
+			if (states.Visited(neighborState))
 			{
 				continue;
 			}
 
-			auto costToNeighbor = currentNode.m_costToPoint + *nodeMovementCosts[originDirection][exitDirection];
-			if (costToNeighbor >= costToPoint[neighborCoords][originDirection][exitDirection])
+			auto costToNeighbor = currentNode.m_costToPoint + *nodeMovementCost;
+			if (costToNeighbor >= states.CostTo(neighborState))
 			{
 				continue;
 			}
 
-			fastestDirectionIntoNode[neighborCoords] = Opposite(currentNode.m_exit);
-			costToPoint[neighborCoords][originDirection][exitDirection] = static_cast<int>(costToNeighbor);
-			openPoints.insert({
+			states.Reach(neighborState, costToNeighbor, currentState);
+			auto estimate = heuristic(neighborCoords, exitDirection);
+			openPoints.Push(static_cast<int>(costToNeighbor) + estimate, {
 				neighborCoords,
+				neighborIndex,
 				static_cast<int>(costToNeighbor),
-				pointHeuristic[neighborCoords],
+				estimate,
 				originDirection,
-				exitDirection,
-				currentNode.m_previousPath });
+				exitDirection });
 		}
-
-		openPoints.erase(currentNode);
 	}
 	return std::nullopt;
 }
 
+Pathing::IncrementalPath::IncrementalPath(
+	int width,
+	int height,
+	const CoordinateVector2& start,
+	const CoordinateVector2& goal,
+	int minimumCost)
+	: m_width(width)
+	, m_height(height)
+	, m_start(start)
+	, m_goal(goal)
+	, m_minimumCost(minimumCost)
+	, m_costToGoal(width * height, c_unreachable)
+	, m_rhs(width * height, c_unreachable)
+{
+	m_rhs[Index(goal)] = 0;
+	Push(Index(goal));
+}
+
+bool Pathing::IncrementalPath::Contains(const CoordinateVector2& coordinates) const
+{
+	return coordinates.m_x >= 0 && coordinates.m_x < m_width
+		&& coordinates.m_y >= 0 && coordinates.m_y < m_height;
+}
+
+void Pathing::IncrementalPath::MoveStart(const CoordinateVector2& start)
+{
+	// The heuristic to every node shrank by at most the distance moved
+	m_keyModifier += ManhattanDistance(m_start, start) * m_minimumCost;
+	m_start = start;
+}
+
+auto Pathing::IncrementalPath::KeyOf(int nodeIndex) const -> Key
+{
+	s64 cost = min(m_costToGoal[nodeIndex], m_rhs[nodeIndex]);
+	if (cost == c_unreachable)
+	{
+		return { std::numeric_limits<s64>::max(), cost };
+	}
+	return { cost + ManhattanDistance(m_start, CoordinatesOf(nodeIndex)) * m_minimumCost + m_keyModifier, cost };
+}
+
+void Pathing::IncrementalPath::Push(int nodeIndex)
+{
+	m_open.push_back({ KeyOf(nodeIndex), nodeIndex });
+	std::push_heap(m_open.begin(), m_open.end(), LaterKey);
+}
+
 const std::set<Direction> c_directions
 {
 	Direction::NORTH,
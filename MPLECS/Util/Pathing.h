@@ -14,21 +14,14 @@
 #include "../Core/typedef.h"
 #include "../ECS/ECS.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <deque>
+#include <limits>
 #include <optional>
-
-namespace Pathing
-{
-	struct SortedCoordinate;
-	struct SortedDirectionalCoordinate;
-}
-
-namespace std
-{
-	bool operator<(const Pathing::SortedCoordinate& left, const Pathing::SortedCoordinate& right);
-	bool operator<(const Pathing::SortedDirectionalCoordinate& left, const Pathing::SortedDirectionalCoordinate& right);
-}
+#include <utility>
+#include <vector>
 
 namespace Pathing
 {
@@ -69,33 +62,312 @@ namespace Pathing
 		int m_airDistToTarget{ 0 };
 	};
 
+	// Entry and exit sides of a node, plus "starts here" and "ends here"
+	constexpr int c_directionalSides = static_cast<int>(PathingDirection::_COUNT) + 1;
+	constexpr int c_noState = -1;
+
+	// A search state is a node entered from one side and left by another
+	inline int DirectionalState(int nodeIndex, int entry, int exit)
+	{
+		return (nodeIndex * c_directionalSides + entry) * c_directionalSides + exit;
+	}
+
 	struct SortedDirectionalCoordinate
 	{
 		SortedDirectionalCoordinate(
 			const CoordinateVector2& coordinates,
+			int nodeIndex,
 			int costToPoint,
 			int airDistToTarget,
 			int entry,
-			int exit,
-			const std::vector<MacroPathNode>& previousPath)
+			int exit)
 			: m_coordinates(coordinates)
+			, m_nodeIndex(nodeIndex)
 			, m_costToPoint(costToPoint)
 			, m_airDistToTarget(airDistToTarget)
 			, m_entry(static_cast<PathingDirection>(entry))
 			, m_exit(static_cast<PathingDirection>(exit))
-			, m_previousPath(previousPath)
 		{
-			m_previousPath.emplace_back(coordinates, static_cast<PathingDirection>(m_entry), static_cast<PathingDirection>(m_exit));
+		}
+
+		int State() const
+		{
+			return DirectionalState(m_nodeIndex, static_cast<int>(m_entry), static_cast<int>(m_exit));
 		}
 
 		CoordinateVector2 m_coordinates;
+		int m_nodeIndex{ 0 };
 		int m_costToPoint{ 0 };
 		int m_airDistToTarget{ 0 };
 		PathingDirection m_entry{ PathingDirection::_COUNT };
 		PathingDirection m_exit{ PathingDirection::_COUNT };
-		std::vector<MacroPathNode> m_previousPath;
 	};
 
+	// The costs out of a search's origin and into its goal, laid over the shared graph costs
+	// so each query doesn't have to copy the graph to add its own endpoints
+	template <typename Cost>
+	struct EndpointCosts
+	{
+		EndpointCosts(const CoordinateVector2& origin, const CoordinateVector2& goal)
+			: m_origin(origin)
+			, m_goal(goal)
+		{
+		}
+
+		std::optional<Cost> Overlay(
+			const CoordinateVector2& node,
+			int entry,
+			int exit,
+			const std::optional<Cost>& graphCost) const
+		{
+			if (entry == static_cast<int>(PathingDirection::_COUNT)
+				&& exit != static_cast<int>(PathingDirection::_COUNT)
+				&& m_originExits[exit]
+				&& node == m_origin)
+			{
+				return m_originExits[exit];
+			}
+			if (exit == static_cast<int>(PathingDirection::_COUNT)
+				&& entry != static_cast<int>(PathingDirection::_COUNT)
+				&& m_goalEntries[entry]
+				&& node == m_goal)
+			{
+				return m_goalEntries[entry];
+			}
+			return graphCost;
+		}
+
+		CoordinateVector2 m_origin;
+		CoordinateVector2 m_goal;
+		// From inside the origin out through each side
+		std::array<std::optional<Cost>, static_cast<int>(PathingDirection::_COUNT)> m_originExits;
+		// In through each side to inside the goal
+		std::array<std::optional<Cost>, static_cast<int>(PathingDirection::_COUNT)> m_goalEntries;
+	};
+
+	// Follows the states' parents back from the goal, then lays the path out from the origin
+	template <typename ParentOf, typename CoordinatesOfNode>
+	MacroPath ReconstructMacroPath(
+		int goalState,
+		ParentOf&& parentOf,
+		CoordinatesOfNode&& coordinatesOfNode)
+	{
+		MacroPath result;
+		for (auto state = goalState; state != c_noState; state = parentOf(state))
+		{
+			auto exit = state % c_directionalSides;
+			auto entry = (state / c_directionalSides) % c_directionalSides;
+			auto nodeIndex = state / (c_directionalSides * c_directionalSides);
+			result.m_path.emplace_back(
+				coordinatesOfNode(nodeIndex),
+				static_cast<PathingDirection>(entry),
+				static_cast<PathingDirection>(exit));
+		}
+		std::reverse(result.m_path.begin(), result.m_path.end());
+		return result;
+	}
+
+	// Open list policies for the searches below
+	// Entries come out lowest priority first. Priorities are never negative
+
+	// One bucket per priority (Dial's algorithm), for searches over small integer costs
+	// Entries may go in below the lowest priority so far, in case a heuristic isn't consistent
+	template <typename Entry>
+	class BucketOpenList
+	{
+	public:
+		bool Empty() const { return m_size == 0; }
+		// Drops every entry, but keeps the storage for the next search
+		void Clear()
+		{
+			m_entries.clear();
+			std::fill(m_bucketHeads.begin(), m_bucketHeads.end(), c_noEntry);
+			m_freeEntries = c_noEntry;
+			m_lowest = 0;
+			m_size = 0;
+		}
+		void Push(int priority, const Entry& entry)
+		{
+			auto bucket = static_cast<size_t>(priority);
+			if (bucket >= m_bucketHeads.size())
+			{
+				m_bucketHeads.resize(bucket + 1, c_noEntry);
+			}
+			// Each bucket is a list threaded through the entry pool, so buckets cost one int each
+			int entryIndex;
+			if (m_freeEntries != c_noEntry)
+			{
+				entryIndex = m_freeEntries;
+				m_freeEntries = m_entries[entryIndex].m_next;
+				m_entries[entryIndex] = { entry, m_bucketHeads[bucket] };
+			}
+			else
+			{
+				entryIndex = static_cast<int>(m_entries.size());
+				m_entries.push_back({ entry, m_bucketHeads[bucket] });
+			}
+			m_bucketHeads[bucket] = entryIndex;
+			m_lowest = min(m_lowest, bucket);
+			++m_size;
+		}
+		Entry Pop()
+		{
+			while (m_bucketHeads[m_lowest] == c_noEntry)
+			{
+				++m_lowest;
+			}
+			// Last in first out within a priority, which favors the deeper nodes
+			auto entryIndex = m_bucketHeads[m_lowest];
+			auto& node = m_entries[entryIndex];
+			m_bucketHeads[m_lowest] = node.m_next;
+			node.m_next = m_freeEntries;
+			m_freeEntries = entryIndex;
+			--m_size;
+			return std::move(node.m_entry);
+		}
+
+	private:
+		static constexpr int c_noEntry = -1;
+		struct Node
+		{
+			Entry m_entry;
+			int m_next;
+		};
+		std::vector<Node> m_entries;
+		std::vector<int> m_bucketHeads;
+		int m_freeEntries{ c_noEntry };
+		size_t m_lowest{ 0 };
+		size_t m_size{ 0 };
+	};
+
+	// 4-ary min heap, for costs too spread out to bucket
+	template <typename Entry>
+	class HeapOpenList
+	{
+	public:
+		bool Empty() const { return m_heap.empty(); }
+		// Drops every entry, but keeps the storage for the next search
+		void Clear() { m_heap.clear(); }
+		void Push(int priority, const Entry& entry)
+		{
+			m_heap.push_back({ priority, entry });
+			auto child = m_heap.size() - 1;
+			while (child > 0)
+			{
+				auto parent = (child - 1) / c_arity;
+				if (m_heap[parent].m_priority <= m_heap[child].m_priority)
+				{
+					break;
+				}
+				std::swap(m_heap[parent], m_heap[child]);
+				child = parent;
+			}
+		}
+		Entry Pop()
+		{
+			auto entry = std::move(m_heap.front().m_entry);
+			if (m_heap.size() > 1)
+			{
+				m_heap.front() = std::move(m_heap.back());
+			}
+			m_heap.pop_back();
+			size_t parent = 0;
+			while (true)
+			{
+				auto smallest = parent;
+				auto firstChild = parent * c_arity + 1;
+				for (auto child = firstChild; child < min(firstChild + c_arity, m_heap.size()); ++child)
+				{
+					if (m_heap[child].m_priority < m_heap[smallest].m_priority)
+					{
+						smallest = child;
+					}
+				}
+				if (smallest == parent)
+				{
+					break;
+				}
+				std::swap(m_heap[parent], m_heap[smallest]);
+				parent = smallest;
+			}
+			return entry;
+		}
+
+	private:
+		static constexpr size_t c_arity = 4;
+		struct HeapEntry
+		{
+			int m_priority;
+			Entry m_entry;
+		};
+		std::vector<HeapEntry> m_heap;
+	};
+
+	// Per node bookkeeping of a search, kept from one search to the next
+	// Entries are stamped with the search that wrote them, so starting a search clears nothing
+	template <typename Cost>
+	class SearchWorkspace
+	{
+	public:
+		// Makes room for nodes [0, nodeCount) and forgets the previous search
+		void Begin(size_t nodeCount)
+		{
+			if (m_nodes.size() < nodeCount)
+			{
+				m_nodes.resize(nodeCount);
+			}
+			if (++m_search == 0)
+			{
+				// The stamps wrapped around, so old entries could pass for this search's
+				std::fill(m_nodes.begin(), m_nodes.end(), Node());
+				m_search = 1;
+			}
+		}
+
+		bool Visited(size_t node) const { return m_nodes[node].m_visitedBy == m_search; }
+		void Visit(size_t node) { m_nodes[node].m_visitedBy = m_search; }
+
+		// Max if the node hasn't been reached this search
+		Cost CostTo(size_t node) const
+		{
+			return m_nodes[node].m_reachedBy == m_search ? m_nodes[node].m_cost : std::numeric_limits<Cost>::max();
+		}
+		// Only meaningful for nodes reached this search
+		int Parent(size_t node) const { return m_nodes[node].m_parent; }
+		void Reach(size_t node, Cost cost, int parent)
+		{
+			auto& entry = m_nodes[node];
+			entry.m_reachedBy = m_search;
+			entry.m_cost = cost;
+			entry.m_parent = parent;
+		}
+
+	private:
+		struct Node
+		{
+			u32 m_visitedBy{ 0 };
+			u32 m_reachedBy{ 0 };
+			Cost m_cost{};
+			int m_parent{ c_noState };
+		};
+		std::vector<Node> m_nodes;
+		u32 m_search{ 0 };
+	};
+
+	// The calling thread's instance, for scratch space which outlives a single search
+	// Searches never run inside one another, so one of each type per thread is enough
+	template <typename Scratch>
+	Scratch& ThreadScratch()
+	{
+		thread_local Scratch scratch;
+		return scratch;
+	}
+
+	inline s64 ManhattanDistance(const CoordinateVector2& from, const CoordinateVector2& to)
+	{
+		return std::abs(to.m_x - from.m_x) + std::abs(to.m_y - from.m_y);
+	}
+
 	static const CoordinateVector2 neighborOffsets[] = {
 		{ 0, -1 }, // NORTH
 		{ 0,  1 }, // SOUTH
@@ -104,7 +376,8 @@ namespace Pathing
 	};
 
 	// Movement Cost is cost to enter a node.
-	template<int X, int Y>
+	// Tile costs are small, so the open list defaults to buckets
+	template<template <typename> class OpenList = BucketOpenList, int X, int Y>
 	std::optional<Path> GetPath(
 		const MovementCostArray2<X, Y>& movementCosts,
 		const CoordinateVector2& origin,
@@ -130,36 +403,46 @@ namespace Pathing
 		{
 			return std::nullopt;
 		}
-		auto visitedPtr = std::make_unique<std::array<std::array<bool, Y>, X>>();
-		auto& visited = *visitedPtr;
-		auto costToPointPtr = std::make_unique<std::array<std::array<int, Y>, X>>();
-		auto& costToPoint = *costToPointPtr;
-		auto pointHeuristicPtr = std::make_unique<std::array<std::array<int, Y>, X>>();
-		auto& pointHeuristic = *pointHeuristicPtr;
-		auto fastestDirectionIntoNodePtr = std::make_unique<std::array<std::array<PathingDirection, Y>, X>>();
-		auto& fastestDirectionIntoNode = *fastestDirectionIntoNodePtr;
+		int minimumCost = std::numeric_limits<int>::max();
 		for (auto i = 0; i < X; ++i)
 		{
 			for (auto j = 0; j < Y; ++j)
 			{
-				visited[i][j] = false;
-				costToPoint[i][j] = std::numeric_limits<int>::max();
-				pointHeuristic[i][j] = static_cast<int>((goal - CoordinateVector2(i, j)).MagnitudeSq());
-				fastestDirectionIntoNode[i][j] = PathingDirection::_COUNT;
+				if (movementCosts[i][j])
+				{
+					minimumCost = min(minimumCost, *movementCosts[i][j]);
+				}
 			}
 		}
+		// Every step enters a node, so the cheapest node times the steps left never overestimates,
+		// and the first path to the goal out of the open list is the cheapest
+		auto heuristic = [&goal, minimumCost](const CoordinateVector2& coordinates) {
+			return static_cast<int>(ManhattanDistance(goal, coordinates)) * minimumCost;
+		};
+		auto priority = [](const SortedCoordinate& point) {
+			return point.m_costToPoint + point.m_airDistToTarget;
+		};
+		auto nodeIndexOf = [](const CoordinateVector2& coordinates) {
+			return coordinates.m_x * Y + coordinates.m_y;
+		};
+		// Parents are the direction each node was entered by
+		auto& nodes = ThreadScratch<SearchWorkspace<int>>();
+		nodes.Begin(X * Y);
 		// Cost to enter the current node is always 0
-		costToPoint[origin.m_x][origin.m_y] = 0;
-		std::set<SortedCoordinate> openPoints;
-		openPoints.insert({ origin, 0, pointHeuristic[origin.m_x][origin.m_y] });
+		nodes.Reach(nodeIndexOf(origin), 0, c_noState);
+		auto& openPoints = ThreadScratch<OpenList<SortedCoordinate>>();
+		openPoints.Clear();
+		SortedCoordinate originPoint{ origin, 0, heuristic(origin) };
+		openPoints.Push(priority(originPoint), originPoint);
 
-		while (!openPoints.empty())
+		while (!openPoints.Empty())
 		{
-			auto currentNode = *openPoints.begin();
+			auto currentNode = openPoints.Pop();
+			auto currentIndex = nodeIndexOf(currentNode.m_coordinates);
 			if (currentNode.m_coordinates == goal)
 			{
 				Path result;
-				result.m_totalPathCost = costToPoint[goal.m_x][goal.m_y];
+				result.m_totalPathCost = nodes.CostTo(currentIndex);
 				auto currentCoords = currentNode.m_coordinates;
 				while (true) // because I'm evil
 				{
@@ -168,18 +451,16 @@ namespace Pathing
 					{
 						return result;
 					}
-					currentCoords -= neighborOffsets[static_cast<int>(fastestDirectionIntoNode
-						[currentCoords.m_x][currentCoords.m_y])];
+					currentCoords -= neighborOffsets[nodes.Parent(nodeIndexOf(currentCoords))];
 				}
 			}
 
-			if (visited[currentNode.m_coordinates.m_x][currentNode.m_coordinates.m_y])
+			if (nodes.Visited(currentIndex))
 			{
-				openPoints.erase(currentNode);
 				continue;
 			}
 
-			visited[currentNode.m_coordinates.m_x][currentNode.m_coordinates.m_y] = true;
+			nodes.Visit(currentIndex);
 
 			for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
 			{
@@ -190,7 +471,8 @@ namespace Pathing
 				{
 					continue;
 				}
-				if (visited[neighborCoords.m_x][neighborCoords.m_y])
+				auto neighborIndex = nodeIndexOf(neighborCoords);
+				if (nodes.Visited(neighborIndex))
 				{
 					continue;
 				}
@@ -200,32 +482,505 @@ namespace Pathing
 				}
 
 				auto costToNeighbor = currentNode.m_costToPoint + *movementCosts[neighborCoords.m_x][neighborCoords.m_y];
-				if (costToNeighbor >= costToPoint[neighborCoords.m_x][neighborCoords.m_y])
+				if (costToNeighbor >= nodes.CostTo(neighborIndex))
 				{
 					continue;
 				}
 
-				fastestDirectionIntoNode[neighborCoords.m_x][neighborCoords.m_y] = static_cast<PathingDirection>(direction);
-				costToPoint[neighborCoords.m_x][neighborCoords.m_y] = costToNeighbor;
-				openPoints.insert({
+				nodes.Reach(neighborIndex, costToNeighbor, direction);
+				SortedCoordinate neighborPoint{
 					neighborCoords,
 					costToNeighbor,
-					pointHeuristic[neighborCoords.m_x][neighborCoords.m_y]
-					});
+					heuristic(neighborCoords) };
+				openPoints.Push(priority(neighborPoint), neighborPoint);
 			}
-
-			openPoints.erase(currentNode);
 		}
 		return std::nullopt;
 	}
 
+	// Cost to the goal from every node of a grid, and the neighbor to step to from each
+	// Searched once outward from the goal, then followed by every unit headed there
+	struct FlowField
+	{
+		static constexpr int c_unreachable = std::numeric_limits<int>::max();
+
+		bool Reachable(const CoordinateVector2& origin) const
+		{
+			return origin.m_x >= 0 && origin.m_x < m_width
+				&& origin.m_y >= 0 && origin.m_y < m_height
+				&& m_costToGoal[Index(origin)] != c_unreachable;
+		}
+
+		// Same shape as GetPath's result, origin first
+		std::optional<Path> PathFrom(const CoordinateVector2& origin) const
+		{
+			if (!Reachable(origin))
+			{
+				return std::nullopt;
+			}
+			Path result;
+			result.m_totalPathCost = m_costToGoal[Index(origin)];
+			for (auto coords = origin; ; coords += neighborOffsets[static_cast<int>(m_nextStep[Index(coords)])])
+			{
+				result.m_path.push_back(coords);
+				if (coords == m_goal)
+				{
+					return result;
+				}
+			}
+		}
+
+		int Index(const CoordinateVector2& coordinates) const
+		{
+			return static_cast<int>(coordinates.m_x * m_height + coordinates.m_y);
+		}
+
+		CoordinateVector2 m_goal;
+		int m_width{ 0 };
+		int m_height{ 0 };
+		// Indexed x * height + y
+		std::vector<int> m_costToGoal;
+		// _COUNT at the goal and wherever the goal can't be reached from
+		std::vector<PathingDirection> m_nextStep;
+	};
+
+	// Movement cost is cost to enter a node, as in GetPath
+	// costOf(x, y) gives the optional cost of a node, so callers can read their grid in place
+	template<template <typename> class OpenList = BucketOpenList, int X, int Y, typename CostOf>
+	FlowField BuildFlowField(
+		const CostOf& costOf,
+		const CoordinateVector2& goal)
+	{
+		FlowField field;
+		field.m_goal = goal;
+		field.m_width = X;
+		field.m_height = Y;
+		field.m_costToGoal.assign(X * Y, FlowField::c_unreachable);
+		field.m_nextStep.assign(X * Y, PathingDirection::_COUNT);
+		if (!costOf(goal.m_x, goal.m_y))
+		{
+			// Nothing can enter the goal
+			return field;
+		}
+
+		std::vector<bool> visited(X * Y, false);
+		field.m_costToGoal[field.Index(goal)] = 0;
+		OpenList<SortedCoordinate> openPoints;
+		openPoints.Push(0, { goal, 0, 0 });
+		while (!openPoints.Empty())
+		{
+			auto currentNode = openPoints.Pop();
+			auto currentIndex = field.Index(currentNode.m_coordinates);
+			if (visited[currentIndex])
+			{
+				continue;
+			}
+			visited[currentIndex] = true;
+
+			// Units may stand on a node they couldn't enter, but can't pass through one
+			auto enterCost = costOf(currentNode.m_coordinates.m_x, currentNode.m_coordinates.m_y);
+			if (!enterCost)
+			{
+				continue;
+			}
+			for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
+			{
+				auto neighborCoords = currentNode.m_coordinates + neighborOffsets[direction];
+				if (neighborCoords.m_x < 0 || neighborCoords.m_x >= X ||
+					neighborCoords.m_y < 0 || neighborCoords.m_y >= Y)
+				{
+					continue;
+				}
+				auto neighborIndex = field.Index(neighborCoords);
+				auto costFromNeighbor = currentNode.m_costToPoint + *enterCost;
+				if (visited[neighborIndex] || costFromNeighbor >= field.m_costToGoal[neighborIndex])
+				{
+					continue;
+				}
+				field.m_costToGoal[neighborIndex] = costFromNeighbor;
+				field.m_nextStep[neighborIndex] = Opposite(static_cast<PathingDirection>(direction));
+				openPoints.Push(costFromNeighbor, { neighborCoords, costFromNeighbor, 0 });
+			}
+		}
+		return field;
+	}
+
+	// D* Lite: searches from the goal back to a start which moves along the path, and keeps what it found,
+	// so when costs change only the part of the search they affect is redone
+	// Covers a width by height grid. costOf(x, y) gives the optional cost to enter a node, as for BuildFlowField
+	// Costs may change between calls, but never below minimumCost, which the heuristic relies on
+	class IncrementalPath
+	{
+	public:
+		static constexpr int c_unreachable = std::numeric_limits<int>::max();
+
+		IncrementalPath(
+			int width,
+			int height,
+			const CoordinateVector2& start,
+			const CoordinateVector2& goal,
+			int minimumCost);
+
+		int Width() const { return m_width; }
+		int Height() const { return m_height; }
+		const CoordinateVector2& Goal() const { return m_goal; }
+		bool Contains(const CoordinateVector2& coordinates) const;
+
+		// The start moves along as the unit follows its path
+		void MoveStart(const CoordinateVector2& start);
+
+		// The cost to enter the node changed, so did the cost to the goal of each node next to it
+		template <typename CostOf>
+		void NodeChanged(const CostOf& costOf, const CoordinateVector2& node)
+		{
+			for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
+			{
+				auto neighborCoords = node + neighborOffsets[direction];
+				if (Contains(neighborCoords))
+				{
+					UpdateNode(costOf, neighborCoords);
+				}
+			}
+		}
+
+		// Settles whatever the changes since the last call unsettled, then follows the cheapest path from the start
+		// The first call does the whole search
+		template <typename CostOf>
+		std::optional<Path> Replan(const CostOf& costOf)
+		{
+			auto startIndex = Index(m_start);
+			while (!m_open.empty()
+				&& (m_open.front().first < KeyOf(startIndex) || m_rhs[startIndex] != m_costToGoal[startIndex]))
+			{
+				std::pop_heap(m_open.begin(), m_open.end(), LaterKey);
+				auto [queuedKey, nodeIndex] = m_open.back();
+				m_open.pop_back();
+				if (m_costToGoal[nodeIndex] == m_rhs[nodeIndex])
+				{
+					// Settled since it was queued
+					continue;
+				}
+				if (queuedKey != KeyOf(nodeIndex))
+				{
+					// Queued before the start moved or the node changed again
+					Push(nodeIndex);
+					continue;
+				}
+				auto coordinates = CoordinatesOf(nodeIndex);
+				if (m_costToGoal[nodeIndex] > m_rhs[nodeIndex])
+				{
+					m_costToGoal[nodeIndex] = m_rhs[nodeIndex];
+				}
+				else
+				{
+					m_costToGoal[nodeIndex] = c_unreachable;
+					UpdateNode(costOf, coordinates);
+				}
+				// Entering this node is how its neighbors get to the goal through it
+				NodeChanged(costOf, coordinates);
+			}
+			return PathFromStart(costOf);
+		}
+
+	private:
+		// Ordered by the first, then the second
+		using Key = std::pair<s64, s64>;
+		using QueuedNode = std::pair<Key, int>;
+
+		static bool LaterKey(const QueuedNode& left, const QueuedNode& right) { return right.first < left.first; }
+
+		int Index(const CoordinateVector2& coordinates) const
+		{
+			return static_cast<int>(coordinates.m_x * m_height + coordinates.m_y);
+		}
+		CoordinateVector2 CoordinatesOf(int nodeIndex) const
+		{
+			return CoordinateVector2(nodeIndex / m_height, nodeIndex % m_height);
+		}
+		Key KeyOf(int nodeIndex) const;
+		void Push(int nodeIndex);
+
+		// Cheapest way to the goal by way of a neighbor
+		template <typename CostOf>
+		void UpdateNode(const CostOf& costOf, const CoordinateVector2& node)
+		{
+			auto nodeIndex = Index(node);
+			if (!(node == m_goal))
+			{
+				auto best = c_unreachable;
+				for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
+				{
+					auto neighborCoords = node + neighborOffsets[direction];
+					if (!Contains(neighborCoords))
+					{
+						continue;
+					}
+					auto enterCost = costOf(neighborCoords.m_x, neighborCoords.m_y);
+					auto neighborCost = m_costToGoal[Index(neighborCoords)];
+					if (enterCost && neighborCost != c_unreachable)
+					{
+						best = min(best, neighborCost + *enterCost);
+					}
+				}
+				m_rhs[nodeIndex] = best;
+			}
+			if (m_rhs[nodeIndex] != m_costToGoal[nodeIndex])
+			{
+				Push(nodeIndex);
+			}
+		}
+
+		template <typename CostOf>
+		std::optional<Path> PathFromStart(const CostOf& costOf) const
+		{
+			if (m_costToGoal[Index(m_start)] == c_unreachable)
+			{
+				return std::nullopt;
+			}
+			Path result;
+			result.m_totalPathCost = m_costToGoal[Index(m_start)];
+			auto coords = m_start;
+			result.m_path.push_back(coords);
+			// Each step lowers the cost left, so this only guards against costs changed without NodeChanged
+			for (int steps = 0; !(coords == m_goal); ++steps)
+			{
+				if (steps == m_width * m_height)
+				{
+					return std::nullopt;
+				}
+				auto best = c_unreachable;
+				auto next = coords;
+				for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
+				{
+					auto neighborCoords = coords + neighborOffsets[direction];
+					if (!Contains(neighborCoords))
+					{
+						continue;
+					}
+					auto enterCost = costOf(neighborCoords.m_x, neighborCoords.m_y);
+					auto neighborCost = m_costToGoal[Index(neighborCoords)];
+					if (enterCost && neighborCost != c_unreachable && neighborCost + *enterCost < best)
+					{
+						best = neighborCost + *enterCost;
+						next = neighborCoords;
+					}
+				}
+				if (best == c_unreachable)
+				{
+					return std::nullopt;
+				}
+				coords = next;
+				result.m_path.push_back(coords);
+			}
+			return result;
+		}
+
+		int m_width;
+		int m_height;
+		CoordinateVector2 m_start;
+		CoordinateVector2 m_goal;
+		int m_minimumCost;
+		// Added to every key queued after the start moves, so older keys stay comparable
+		s64 m_keyModifier{ 0 };
+		// Indexed x * height + y. The cost to the goal as last settled, and as the neighbors have it now
+		std::vector<int> m_costToGoal;
+		std::vector<int> m_rhs;
+		// Heap of nodes whose two costs differ. A node may be in it more than once, stale entries are skipped
+		std::vector<QueuedNode> m_open;
+	};
+
+	// Lower bounds for directional searches over an X by Y graph, from exact costs to and from a few landmarks (ALT)
+	// Vertices are nodes entered by one side. Only the costs through nodes are used,
+	// so the bounds hold whatever a query lays over its origin and goal
+	template <int X, int Y>
+	struct LandmarkOracle
+	{
+		static constexpr int c_maxLandmarks = 4;
+		static constexpr s64 c_unreachable = std::numeric_limits<s64>::max();
+		using LandmarkCosts = std::array<s64, c_maxLandmarks>;
+
+		static int Vertex(int x, int y, int entry)
+		{
+			return (x * Y + y) * static_cast<int>(PathingDirection::_COUNT) + entry;
+		}
+
+		// For GetDirectionalPath: the cost from entering (x, y) by entry to getting into the goal
+		std::optional<s64> LowerBound(int x, int y, int entry, const CoordinateVector2& goal) const
+		{
+			if (x == goal.m_x && y == goal.m_y)
+			{
+				return 0;
+			}
+			std::optional<s64> best;
+			for (int goalEntry = static_cast<int>(PathingDirection::NORTH); goalEntry < static_cast<int>(PathingDirection::_COUNT); ++goalEntry)
+			{
+				auto bound = LowerBoundBetween(
+					Vertex(x, y, entry),
+					Vertex(static_cast<int>(goal.m_x), static_cast<int>(goal.m_y), goalEntry));
+				if (bound)
+				{
+					best = best ? min(*best, *bound) : *bound;
+				}
+			}
+			return best;
+		}
+
+		// nullopt when the landmarks show there's no way from one to the other
+		std::optional<s64> LowerBoundBetween(int from, int to) const
+		{
+			s64 bound = 0;
+			for (int landmark = 0; landmark < m_landmarkCount; ++landmark)
+			{
+				// from -> to -> landmark is no shorter than from -> landmark
+				if (m_toLandmark[to][landmark] != c_unreachable)
+				{
+					if (m_toLandmark[from][landmark] == c_unreachable)
+					{
+						return std::nullopt;
+					}
+					bound = max(bound, m_toLandmark[from][landmark] - m_toLandmark[to][landmark]);
+				}
+				// landmark -> from -> to is no shorter than landmark -> to
+				if (m_fromLandmark[from][landmark] != c_unreachable)
+				{
+					if (m_fromLandmark[to][landmark] == c_unreachable)
+					{
+						return std::nullopt;
+					}
+					bound = max(bound, m_fromLandmark[to][landmark] - m_fromLandmark[from][landmark]);
+				}
+			}
+			return bound;
+		}
+
+		int m_landmarkCount{ 0 };
+		// Indexed by vertex
+		std::vector<LandmarkCosts> m_toLandmark;
+		std::vector<LandmarkCosts> m_fromLandmark;
+	};
+
+	// Landmarks are picked farthest first, so they sit around the edge of the graph
+	// costOf(x, y, entry, exit) as for GetDirectionalPath
+	template <int X, int Y, typename CostOf>
+	LandmarkOracle<X, Y> BuildLandmarkOracle(const CostOf& costOf)
+	{
+		using Oracle = LandmarkOracle<X, Y>;
+		constexpr int c_sides = static_cast<int>(PathingDirection::_COUNT);
+		constexpr int c_vertexCount = X * Y * c_sides;
+
+		// Leaving a node by its exit enters the neighbor by the opposite side
+		struct Edge
+		{
+			int m_vertex;
+			s64 m_cost;
+		};
+		std::vector<std::vector<Edge>> edges(c_vertexCount);
+		std::vector<std::vector<Edge>> reverseEdges(c_vertexCount);
+		for (int x = 0; x < X; ++x)
+		{
+			for (int y = 0; y < Y; ++y)
+			{
+				for (int entry = 0; entry < c_sides; ++entry)
+				{
+					for (int exit = 0; exit < c_sides; ++exit)
+					{
+						auto neighborCoords = CoordinateVector2(x, y) + neighborOffsets[exit];
+						if (exit == entry ||
+							neighborCoords.m_x < 0 || neighborCoords.m_x >= X ||
+							neighborCoords.m_y < 0 || neighborCoords.m_y >= Y)
+						{
+							continue;
+						}
+						auto cost = costOf(x, y, entry, exit);
+						if (!cost)
+						{
+							continue;
+						}
+						auto from = Oracle::Vertex(x, y, entry);
+						auto to = Oracle::Vertex(
+							static_cast<int>(neighborCoords.m_x),
+							static_cast<int>(neighborCoords.m_y),
+							static_cast<int>(Opposite(static_cast<PathingDirection>(exit))));
+						edges[from].push_back({ to, *cost });
+						reverseEdges[to].push_back({ from, *cost });
+					}
+				}
+			}
+		}
+
+		auto costsFrom = [](const std::vector<std::vector<Edge>>& graph, int source) {
+			std::vector<s64> costs(graph.size(), Oracle::c_unreachable);
+			costs[source] = 0;
+			HeapOpenList<int> openVertices;
+			openVertices.Push(0, source);
+			while (!openVertices.Empty())
+			{
+				auto vertex = openVertices.Pop();
+				for (auto&& edge : graph[vertex])
+				{
+					auto cost = costs[vertex] + edge.m_cost;
+					if (cost < costs[edge.m_vertex])
+					{
+						costs[edge.m_vertex] = cost;
+						openVertices.Push(static_cast<int>(cost), edge.m_vertex);
+					}
+				}
+			}
+			return costs;
+		};
+
+		Oracle oracle;
+		oracle.m_toLandmark.assign(c_vertexCount, {});
+		oracle.m_fromLandmark.assign(c_vertexCount, {});
+		auto firstVertex = std::find_if(edges.begin(), edges.end(), [](const auto& vertexEdges) { return !vertexEdges.empty(); });
+		if (firstVertex == edges.end())
+		{
+			return oracle;
+		}
+		// Distance from the landmarks so far, the next landmark is the vertex farthest from all of them
+		auto spread = costsFrom(edges, static_cast<int>(firstVertex - edges.begin()));
+		for (; oracle.m_landmarkCount < Oracle::c_maxLandmarks; ++oracle.m_landmarkCount)
+		{
+			int landmark = -1;
+			for (int vertex = 0; vertex < c_vertexCount; ++vertex)
+			{
+				if (spread[vertex] != Oracle::c_unreachable && spread[vertex] > 0
+					&& (landmark < 0 || spread[vertex] > spread[landmark]))
+				{
+					landmark = vertex;
+				}
+			}
+			if (landmark < 0)
+			{
+				break;
+			}
+			auto fromLandmark = costsFrom(edges, landmark);
+			auto toLandmark = costsFrom(reverseEdges, landmark);
+			for (int vertex = 0; vertex < c_vertexCount; ++vertex)
+			{
+				oracle.m_fromLandmark[vertex][oracle.m_landmarkCount] = fromLandmark[vertex];
+				oracle.m_toLandmark[vertex][oracle.m_landmarkCount] = toLandmark[vertex];
+				if (oracle.m_landmarkCount == 0 || fromLandmark[vertex] < spread[vertex])
+				{
+					spread[vertex] = fromLandmark[vertex];
+				}
+			}
+		}
+		return oracle;
+	}
+
 	// Movement cost is cost to move through the previous node from a certain side to
 	// the side adjacent to the current node
-	template<int X, int Y>
-	std::optional<MacroPath> GetPath(
-		const DirectionMovementCostArray<X, Y>& movementCosts,
+	// These costs are whole paths through a sector or quadrant, so the open list defaults to a heap
+	// costOf(x, y, entry, exit) gives the optional cost through a node, so callers can read their graph in place
+	// lowerBound(x, y, entry) gives a cost the rest of a path entering (x, y) by entry can't beat,
+	// or nullopt if the goal can't be reached from there, such as a LandmarkOracle's
+	template<template <typename> class OpenList = HeapOpenList, int X, int Y, typename CostOf, typename LowerBound>
+	std::optional<MacroPath> GetDirectionalPath(
+		const CostOf& costOf,
 		const CoordinateVector2& origin,
-		const CoordinateVector2& goal)
+		const CoordinateVector2& goal,
+		const LowerBound& lowerBound)
 	{
 		bool triviallyReachable = false;
 		for (int direction = static_cast<int>(PathingDirection::NORTH); direction < static_cast<int>(PathingDirection::_COUNT); ++direction)
@@ -237,14 +992,13 @@ namespace Pathing
 			{
 				continue;
 			}
-			auto& neighborMovementCosts = movementCosts[neighborCoords.m_x][neighborCoords.m_y];
 			for (int enterDirection = static_cast<int>(PathingDirection::NORTH); enterDirection < static_cast<int>(PathingDirection::_COUNT); ++enterDirection)
 			{
 				if (enterDirection == static_cast<int>(Opposite(static_cast<PathingDirection>(direction))))
 				{
 					continue;
 				}
-				if (neighborMovementCosts[enterDirection][static_cast<int>(Opposite(static_cast<PathingDirection>(direction)))])
+				if (costOf(neighborCoords.m_x, neighborCoords.m_y, enterDirection, static_cast<int>(Opposite(static_cast<PathingDirection>(direction)))))
 				{
 					triviallyReachable = true;
 					break;
@@ -257,108 +1011,171 @@ namespace Pathing
 			return std::nullopt;
 		}
 
-		auto visitedPtr = std::make_unique<std::array<std::array<std::array<std::array<bool, static_cast<int>(PathingDirection::_COUNT) + 1>, static_cast<int>(PathingDirection::_COUNT) + 1>, Y>, X>>();
-		auto& visited = *visitedPtr;
-		auto costToPointPtr = std::make_unique<std::array<std::array<std::array<std::array<int, static_cast<int>(PathingDirection::_COUNT) + 1>, static_cast<int>(PathingDirection::_COUNT) + 1>, Y>, X>>();
-		auto& costToPoint = *costToPointPtr;
-		auto pointHeuristicPtr = std::make_unique<std::array<std::array<int, Y>, X>>();
-		auto& pointHeuristic = *pointHeuristicPtr;
-		auto fastestDirectionIntoNodePtr = std::make_unique<std::array<std::array<PathingDirection, Y>, X>>();
-		auto& fastestDirectionIntoNode = *fastestDirectionIntoNodePtr;
+		// Each state only keeps the state it was reached from, the path is rebuilt once at the goal
+		auto& states = ThreadScratch<SearchWorkspace<int>>();
+		states.Begin(X * Y * c_directionalSides * c_directionalSides);
+
+		// Every node between here and the goal has to be crossed, at no less than the cheapest crossing
+		int minimumCrossing = std::numeric_limits<int>::max();
 		for (auto i = 0; i < X; ++i)
 		{
 			for (auto j = 0; j < Y; ++j)
 			{
-				for (int inDirection = static_cast<int>(PathingDirection::NORTH); inDirection <= static_cast<int>(PathingDirection::_COUNT); ++inDirection)
+				for (int entry = static_cast<int>(PathingDirection::NORTH); entry < static_cast<int>(PathingDirection::_COUNT); ++entry)
 				{
-					for (int outDirection = static_cast<int>(PathingDirection::NORTH); outDirection <= static_cast<int>(PathingDirection::_COUNT); ++outDirection)
+					for (int exit = static_cast<int>(PathingDirection::NORTH); exit < static_cast<int>(PathingDirection::_COUNT); ++exit)
 					{
-						visited[i][j][inDirection][outDirection] = false;
-						costToPoint[i][j][inDirection][outDirection] = std::numeric_limits<int>::max();
+						if (auto crossing = costOf(i, j, entry, exit))
+						{
+							minimumCrossing = min(minimumCrossing, static_cast<int>(*crossing));
+						}
 					}
 				}
-				pointHeuristic[i][j] = 0; // static_cast<int>((goal - CoordinateVector2(i, j)).MagnitudeSq());
-				fastestDirectionIntoNode[i][j] = PathingDirection::_COUNT;
 			}
 		}
-		std::set<SortedDirectionalCoordinate> openPoints;
+		if (minimumCrossing == std::numeric_limits<int>::max())
+		{
+			minimumCrossing = 0;
+		}
+		// Estimated cost left once a state's node has been left by its exit
+		auto heuristic = [&goal, &lowerBound, minimumCrossing](const CoordinateVector2& coordinates, int exit) -> std::optional<int> {
+			if (exit == static_cast<int>(PathingDirection::_COUNT))
+			{
+				return 0;
+			}
+			auto nextCoordinates = coordinates + neighborOffsets[exit];
+			if (nextCoordinates.m_x < 0 || nextCoordinates.m_x >= X ||
+				nextCoordinates.m_y < 0 || nextCoordinates.m_y >= Y)
+			{
+				return std::nullopt;
+			}
+			auto bound = lowerBound(
+				static_cast<int>(nextCoordinates.m_x),
+				static_cast<int>(nextCoordinates.m_y),
+				static_cast<int>(Opposite(static_cast<PathingDirection>(exit))));
+			if (!bound)
+			{
+				return std::nullopt;
+			}
+			return max(static_cast<int>(ManhattanDistance(nextCoordinates, goal)) * minimumCrossing, static_cast<int>(*bound));
+		};
+		auto nodeIndexOf = [](const CoordinateVector2& coordinates) {
+			return static_cast<int>(coordinates.m_x * Y + coordinates.m_y);
+		};
+
+		auto& openPoints = ThreadScratch<OpenList<SortedDirectionalCoordinate>>();
+		openPoints.Clear();
 		for (int exitDirection = static_cast<int>(PathingDirection::NORTH); exitDirection <= static_cast<int>(PathingDirection::_COUNT); ++exitDirection)
 		{
-			if (!movementCosts[origin.m_x][origin.m_y][static_cast<int>(PathingDirection::_COUNT)][exitDirection]) continue;
+			if (!costOf(origin.m_x, origin.m_y, static_cast<int>(PathingDirection::_COUNT), exitDirection)) continue;
+			auto estimate = heuristic(origin, exitDirection);
+			if (!estimate) continue;
 
 			// Cost to enter the current node is always 0
-			costToPoint[origin.m_x][origin.m_y][static_cast<int>(PathingDirection::_COUNT)][exitDirection] = 0;
-			openPoints.insert({ origin, 0, pointHeuristic[origin.m_x][origin.m_y], static_cast<int>(PathingDirection::_COUNT), exitDirection,{} });
+			states.Reach(DirectionalState(nodeIndexOf(origin), static_cast<int>(PathingDirection::_COUNT), exitDirection), 0, c_noState);
+			openPoints.Push(*estimate,
+				{ origin, nodeIndexOf(origin), 0, *estimate, static_cast<int>(PathingDirection::_COUNT), exitDirection });
 		}
 		
-		while (!openPoints.empty())
+		while (!openPoints.Empty())
 		{
-			auto currentNode = *openPoints.begin();
+			auto currentNode = openPoints.Pop();
+			auto currentState = currentNode.State();
 			if (currentNode.m_coordinates == goal && currentNode.m_exit == PathingDirection::_COUNT)
 			{
-				MacroPath result;
-				result.m_totalPathCost = costToPoint[goal.m_x][goal.m_y]
-					[static_cast<int>(currentNode.m_entry)][static_cast<int>(currentNode.m_exit)];
-				result.m_path = currentNode.m_previousPath;
+				auto result = ReconstructMacroPath(currentState, [&states](int state) {
+					return states.Parent(state);
+				}, [](int nodeIndex) {
+					return CoordinateVector2(nodeIndex / Y, nodeIndex % Y);
+				});
+				result.m_totalPathCost = states.CostTo(currentState);
 				return result;
 			}
 
-			if (visited[currentNode.m_coordinates.m_x][currentNode.m_coordinates.m_y]
-				[static_cast<int>(currentNode.m_entry)][static_cast<int>(currentNode.m_exit)])
+			if (states.Visited(currentState))
 			{
-				openPoints.erase(currentNode);
 				continue;
 			}
 
-			visited[currentNode.m_coordinates.m_x][currentNode.m_coordinates.m_y]
-				[static_cast<int>(currentNode.m_entry)][static_cast<int>(currentNode.m_exit)] = true;
+			states.Visit(currentState);
 
 			auto& neighborOffset = neighborOffsets[static_cast<int>(currentNode.m_exit)];
 			auto neighborCoords = currentNode.m_coordinates + neighborOffset;
 			if (neighborCoords.m_x < 0 || neighborCoords.m_x >= X ||
 				neighborCoords.m_y < 0 || neighborCoords.m_y >= Y)
 			{
-				openPoints.erase(currentNode);
 				continue;
 			}
-			auto nodeMovementCosts = movementCosts[neighborCoords.m_x][neighborCoords.m_y];
+			auto neighborIndex = nodeIndexOf(neighborCoords);
 			auto originDirection = static_cast<int>(Opposite(currentNode.m_exit));
 			for (int exitDirection = static_cast<int>(PathingDirection::NORTH); exitDirection <= static_cast<int>(PathingDirection::_COUNT); ++exitDirection)
 			{
 				if (exitDirection == originDirection) continue;
-				if (!nodeMovementCosts[originDirection][exitDirection]) continue;
+				auto nodeMovementCost = costOf(neighborCoords.m_x, neighborCoords.m_y, originDirection, exitDirection);
+				if (!nodeMovementCost) continue;
 
-				if (visited[neighborCoords.m_x][neighborCoords.m_y][originDirection][exitDirection])
+				auto neighborState = DirectionalState(neighborIndex, originDirection, exitDirection);
+				if (states.Visited(neighborState))
 				{
 					continue;
 				}
 
-				auto costToNeighbor = currentNode.m_costToPoint + *nodeMovementCosts[originDirection][exitDirection];
-				if (costToNeighbor >= costToPoint[neighborCoords.m_x][neighborCoords.m_y][originDirection][exitDirection])
+				auto costToNeighbor = currentNode.m_costToPoint + *nodeMovementCost;
+				if (costToNeighbor >= states.CostTo(neighborState))
+				{
+					continue;
+				}
+				auto estimate = heuristic(neighborCoords, exitDirection);
+				if (!estimate)
 				{
 					continue;
 				}
 
-				fastestDirectionIntoNode[neighborCoords.m_x][neighborCoords.m_y] = Opposite(currentNode.m_exit);
-				costToPoint[neighborCoords.m_x][neighborCoords.m_y][originDirection][exitDirection] = costToNeighbor;
-				openPoints.insert({
+				states.Reach(neighborState, costToNeighbor, currentState);
+				openPoints.Push(costToNeighbor + *estimate, {
 					neighborCoords,
+					neighborIndex,
 					costToNeighbor,
-					pointHeuristic[neighborCoords.m_x][neighborCoords.m_y],
+					*estimate,
 					originDirection,
-					exitDirection,
-					currentNode.m_previousPath });
+					exitDirection });
 			}
-
-			openPoints.erase(currentNode);
 		}
 		return std::nullopt;
 	}
 
+	template<template <typename> class OpenList = HeapOpenList, int X, int Y, typename CostOf>
+	std::optional<MacroPath> GetDirectionalPath(
+		const CostOf& costOf,
+		const CoordinateVector2& origin,
+		const CoordinateVector2& goal)
+	{
+		return GetDirectionalPath<OpenList, X, Y>(costOf, origin, goal, [](int, int, int) -> std::optional<s64> {
+			return 0;
+		});
+	}
+
+	template<template <typename> class OpenList = HeapOpenList, int X, int Y>
+	std::optional<MacroPath> GetPath(
+		const DirectionMovementCostArray<X, Y>& movementCosts,
+		const CoordinateVector2& origin,
+		const CoordinateVector2& goal)
+	{
+		return GetDirectionalPath<OpenList, X, Y>([&movementCosts](int x, int y, int entry, int exit) -> const std::optional<int>& {
+			return movementCosts[x][y][entry][exit];
+		}, origin, goal);
+	}
+
 	// Movement cost is cost to move through the previous node from a certain side to
 	// the side adjacent to the current node
 	std::optional<MacroPath> GetPath(
 		const DirectionMovementCostMap& movementCosts,
 		const CoordinateVector2& origin,
 		const CoordinateVector2& goal);
+
+	// As above, with the origin's exits and the goal's entries taken from the endpoints where they're set
+	// The endpoints needn't be in the map
+	std::optional<MacroPath> GetPath(
+		const DirectionMovementCostMap& movementCosts,
+		const EndpointCosts<s64>& endpoints);
 }
@@ -0,0 +1,321 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/Profiler.cpp
+// Zone recording, per-frame aggregation and trace output
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace
+{
+	// Frames of raw zones kept around for trace output
+	constexpr size_t c_traceFrames = 120;
+	// A run of slow frames only writes one trace, and only so many are written in all
+	constexpr u64 c_spikeTraceCooldownFrames = c_traceFrames;
+	constexpr int c_maxSpikeTraces = 8;
+
+	struct ZoneEvent
+	{
+		const char* m_name;
+		const char* m_category;
+		s64 m_startNs;
+		s64 m_durationNs;
+		u32 m_threadId;
+	};
+
+	// Each thread records into its own buffer, only contended when the frame is collected
+	struct ThreadBuffer
+	{
+		std::mutex m_mutex;
+		std::vector<ZoneEvent> m_events;
+		u32 m_threadId{ 0 };
+	};
+
+	struct ZoneHistory
+	{
+		std::array<timeuS, Profiler::c_windowFrames> m_samples{};
+		std::array<u32, Profiler::c_histogramBuckets> m_buckets{};
+		int m_nextSample{ 0 };
+		int m_sampleCount{ 0 };
+		timeuS m_currentFrame{ 0 };
+		timeuS m_lastFrame{ 0 };
+	};
+
+	struct ProfilerState
+	{
+		std::atomic<bool> m_enabled{ false };
+		std::atomic<u32> m_nextThreadId{ 0 };
+
+		std::mutex m_buffersMutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+		std::mutex m_historyMutex;
+		std::map<std::string, ZoneHistory> m_zones;
+		std::deque<std::vector<ZoneEvent>> m_recentFrames;
+		s64 m_frameStartNs{ 0 };
+		u64 m_frameNumber{ 0 };
+		timeuS m_spikeThreshold{ 0 };
+		std::string m_spikePrefix;
+		int m_spikeTracesWritten{ 0 };
+		std::optional<u64> m_lastSpikeTraceFrame;
+	};
+
+	ProfilerState& State()
+	{
+		static ProfilerState state;
+		return state;
+	}
+
+	s64 NowNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+	}
+
+	ThreadBuffer& LocalBuffer()
+	{
+		thread_local std::shared_ptr<ThreadBuffer> buffer;
+		if (!buffer)
+		{
+			auto& state = State();
+			buffer = std::make_shared<ThreadBuffer>();
+			buffer->m_threadId = state.m_nextThreadId++;
+			std::lock_guard buffersLock(state.m_buffersMutex);
+			state.m_buffers.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	// Power of two buckets of microseconds: bucket b holds samples below 2^b uS
+	int BucketOf(timeuS sample)
+	{
+		int bucket = 0;
+		while (sample > 0 && bucket < Profiler::c_histogramBuckets - 1)
+		{
+			sample >>= 1;
+			++bucket;
+		}
+		return bucket;
+	}
+
+	void AddSample(ZoneHistory& history, timeuS sample)
+	{
+		if (history.m_sampleCount == Profiler::c_windowFrames)
+		{
+			--history.m_buckets[BucketOf(history.m_samples[history.m_nextSample])];
+		}
+		else
+		{
+			++history.m_sampleCount;
+		}
+		history.m_samples[history.m_nextSample] = sample;
+		++history.m_buckets[BucketOf(sample)];
+		history.m_nextSample = (history.m_nextSample + 1) % Profiler::c_windowFrames;
+		history.m_lastFrame = sample;
+	}
+
+	timeuS Percentile(const ZoneHistory& history, f64 fraction, timeuS maxSample)
+	{
+		auto target = static_cast<u32>(fraction * history.m_sampleCount);
+		u32 seen = 0;
+		for (int bucket = 0; bucket < Profiler::c_histogramBuckets; ++bucket)
+		{
+			seen += history.m_buckets[bucket];
+			if (seen > target)
+			{
+				// Upper edge of the bucket, never more than the largest sample
+				return std::min<timeuS>(bucket ? (1ll << bucket) - 1 : 0, maxSample);
+			}
+		}
+		return maxSample;
+	}
+
+	void WriteEscaped(std::ofstream& out, const char* text)
+	{
+		for (; *text; ++text)
+		{
+			if (*text == '"' || *text == '\\') out << '\\';
+			out << *text;
+		}
+	}
+
+	bool WriteTrace(const std::deque<std::vector<ZoneEvent>>& frames, const std::string& path)
+	{
+		std::ofstream out(path, std::ios::trunc);
+		if (!out)
+		{
+			return false;
+		}
+		s64 originNs = 0;
+		for (auto&& frame : frames)
+		{
+			if (!frame.empty())
+			{
+				originNs = frame.front().m_startNs;
+				break;
+			}
+		}
+		out << "{\"traceEvents\":[";
+		bool first = true;
+		for (auto&& frame : frames)
+		{
+			for (auto&& event : frame)
+			{
+				out << (first ? "\n" : ",\n") << "{\"name\":\"";
+				WriteEscaped(out, event.m_name);
+				out << "\",\"cat\":\"";
+				WriteEscaped(out, event.m_category);
+				out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.m_threadId
+					<< ",\"ts\":" << (event.m_startNs - originNs) / 1000.
+					<< ",\"dur\":" << event.m_durationNs / 1000. << "}";
+				first = false;
+			}
+		}
+		out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		return static_cast<bool>(out);
+	}
+}
+
+Profiler::ScopedZone::ScopedZone(const char* name, const char* category)
+	: m_name(name)
+	, m_category(category)
+	, m_startNs(State().m_enabled ? NowNs() : -1)
+{
+}
+
+Profiler::ScopedZone::~ScopedZone()
+{
+	if (m_startNs < 0)
+	{
+		return;
+	}
+	auto endNs = NowNs();
+	auto& buffer = LocalBuffer();
+	std::lock_guard bufferLock(buffer.m_mutex);
+	buffer.m_events.push_back({ m_name, m_category, m_startNs, endNs - m_startNs, buffer.m_threadId });
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+	State().m_enabled = enabled;
+}
+
+bool Profiler::IsEnabled()
+{
+	return State().m_enabled;
+}
+
+void Profiler::EndFrame()
+{
+	auto& state = State();
+	if (!state.m_enabled)
+	{
+		return;
+	}
+	auto frameEndNs = NowNs();
+
+	std::vector<ZoneEvent> frameEvents;
+	{
+		std::lock_guard buffersLock(state.m_buffersMutex);
+		for (auto&& buffer : state.m_buffers)
+		{
+			std::lock_guard bufferLock(buffer->m_mutex);
+			frameEvents.insert(frameEvents.end(), buffer->m_events.begin(), buffer->m_events.end());
+			buffer->m_events.clear();
+		}
+		// Buffers only referenced from here belong to threads that have finished
+		state.m_buffers.erase(
+			std::remove_if(state.m_buffers.begin(), state.m_buffers.end(), [](const auto& buffer) {
+				return buffer.use_count() == 1;
+			}),
+			state.m_buffers.end());
+	}
+
+	std::lock_guard historyLock(state.m_historyMutex);
+	if (state.m_frameStartNs == 0)
+	{
+		state.m_frameStartNs = frameEndNs;
+	}
+	auto frameDuration = static_cast<timeuS>((frameEndNs - state.m_frameStartNs) / 1000);
+	frameEvents.push_back({ "Frame", "frame", state.m_frameStartNs, frameEndNs - state.m_frameStartNs, 0 });
+	state.m_frameStartNs = frameEndNs;
+	++state.m_frameNumber;
+
+	for (auto&& event : frameEvents)
+	{
+		state.m_zones[event.m_name].m_currentFrame += event.m_durationNs / 1000;
+	}
+	for (auto&& zone : state.m_zones)
+	{
+		AddSample(zone.second, zone.second.m_currentFrame);
+		zone.second.m_currentFrame = 0;
+	}
+
+	state.m_recentFrames.push_back(std::move(frameEvents));
+	while (state.m_recentFrames.size() > c_traceFrames)
+	{
+		state.m_recentFrames.pop_front();
+	}
+
+	if (state.m_spikeThreshold > 0
+		&& frameDuration > state.m_spikeThreshold
+		&& state.m_spikeTracesWritten < c_maxSpikeTraces
+		&& (!state.m_lastSpikeTraceFrame || state.m_frameNumber - *state.m_lastSpikeTraceFrame >= c_spikeTraceCooldownFrames))
+	{
+		// The trace already covers the frames since the last one
+		WriteTrace(state.m_recentFrames, state.m_spikePrefix + std::to_string(state.m_frameNumber) + ".json");
+		++state.m_spikeTracesWritten;
+		state.m_lastSpikeTraceFrame = state.m_frameNumber;
+	}
+}
+
+void Profiler::SetSpikeThreshold(timeuS threshold, const std::string& tracePathPrefix)
+{
+	auto& state = State();
+	std::lock_guard historyLock(state.m_historyMutex);
+	state.m_spikeThreshold = threshold;
+	state.m_spikePrefix = tracePathPrefix;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+	auto& state = State();
+	std::lock_guard historyLock(state.m_historyMutex);
+	return WriteTrace(state.m_recentFrames, path);
+}
+
+std::vector<Profiler::ZoneStats> Profiler::GetZoneStats()
+{
+	auto& state = State();
+	std::lock_guard historyLock(state.m_historyMutex);
+	std::vector<ZoneStats> stats;
+	for (auto&& zone : state.m_zones)
+	{
+		auto& history = zone.second;
+		ZoneStats zoneStats;
+		zoneStats.m_name = zone.first;
+		zoneStats.m_lastFrame = history.m_lastFrame;
+		for (int i = 0; i < history.m_sampleCount; ++i)
+		{
+			zoneStats.m_max = std::max(zoneStats.m_max, history.m_samples[i]);
+		}
+		zoneStats.m_median = Percentile(history, 0.5, zoneStats.m_max);
+		zoneStats.m_percentile95 = Percentile(history, 0.95, zoneStats.m_max);
+		stats.push_back(std::move(zoneStats));
+	}
+	return stats;
+}
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// Util/Profiler.h
+// Lightweight frame profiler
+// Scoped zones are timed on whichever thread they run on, aggregated once per frame
+// into rolling histograms, and the most recent frames can be written out
+// as a Chrome trace_event file (chrome://tracing or ui.perfetto.dev)
+// Off until SetEnabled(true), zones then cost no more than a flag check
+
+#pragma once
+
+#include "../Core/typedef.h"
+
+#include <string>
+#include <vector>
+
+namespace Profiler
+{
+	// Rolling statistics of one zone over the last c_windowFrames frames
+	struct ZoneStats
+	{
+		std::string m_name;
+		// Time spent in the zone during the most recent frame
+		timeuS m_lastFrame{ 0 };
+		timeuS m_median{ 0 };
+		timeuS m_percentile95{ 0 };
+		timeuS m_max{ 0 };
+	};
+
+	constexpr int c_windowFrames = 256;
+	constexpr int c_histogramBuckets = 32;
+
+	// Zone names are kept by pointer, so they have to outlive the profiler
+	// (string literals, or strings owned by something that lives as long as the program)
+	class ScopedZone
+	{
+	public:
+		explicit ScopedZone(const char* name, const char* category = "zone");
+		~ScopedZone();
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+	private:
+		const char* m_name;
+		const char* m_category;
+		s64 m_startNs;
+	};
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+	// Call once per frame, after every zone of the frame has closed
+	void EndFrame();
+
+	// Frames longer than this write out a trace of the recent frames by themselves. 0, the default, disables it
+	// Spikes close after one already traced are skipped, and only the first few of a run are written
+	void SetSpikeThreshold(timeuS threshold, const std::string& tracePathPrefix = "frame_spike_");
+
+	// Writes the last few frames of zones as a Chrome trace_event JSON file
+	bool WriteChromeTrace(const std::string& path);
+
+	std::vector<ZoneStats> GetZoneStats();
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_ZONE(name) Profiler::ScopedZone PROFILE_CONCAT(profileZone, __LINE__)(name)
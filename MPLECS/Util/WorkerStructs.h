@@ -12,11 +12,12 @@
 struct WorkerProductionValue
 {
 	WorkerProductionValue() = default;
-	WorkerProductionValue(const ECS_Core::Components::PopulationKey& workerKey, const f64& productionValue)
-		: m_workerKey(workerKey)
+	WorkerProductionValue(size_t workerCohort, const f64& productionValue)
+		: m_workerCohort(workerCohort)
 		, m_productiveValue(productionValue)
 	{ }
-	ECS_Core::Components::PopulationKey m_workerKey;
+	// Index into the C_Population being worked
+	size_t m_workerCohort{ 0 };
 	f64 m_productiveValue{ 0 };
 };
 
@@ -26,7 +27,8 @@ struct WorkerAssignment
 	AssignmentMap m_assignments;
 };
 
-using WorkerAssignmentMap = std::map<ECS_Core::Components::PopulationKey, WorkerAssignment>;
+// Keyed by cohort index
+using WorkerAssignmentMap = std::map<size_t, WorkerAssignment>;
 
 struct WorkerSkillKey
 {
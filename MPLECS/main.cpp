@@ -11,12 +11,15 @@
 
 #include "Systems/Systems.h"
 #include "ECS/System.h"
+#include "ECS/SystemScheduler.h"
 #include "ECS/ECS.h"
 #include "Core/typedef.h"
+#include "Util/Profiler.h"
 
 #include <chrono>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 using namespace std;
@@ -24,6 +27,7 @@ using namespace std;
 ECS_Core::Manager s_manager;
 
 std::vector<std::unique_ptr<SystemBase>> s_systems;
+SystemScheduler s_scheduler(s_manager);
 
 SystemBase::SystemBase()
 	: m_managerRef(s_manager)
@@ -32,15 +36,111 @@ SystemBase::SystemBase()
 }
 
 template <typename SYSTEM>
-void RegisterSystem()
+SYSTEM& RegisterSystem()
 {
-	s_systems.emplace_back(std::move(InstantiateSystem<SYSTEM>()));
+	auto system = InstantiateSystem<SYSTEM>();
+	auto& systemRef = *system;
+	s_systems.emplace_back(std::move(system));
+	s_scheduler.Register<SYSTEM>(systemRef);
+	return systemRef;
 }
 
-int main()
+// Runs every system for the phase, and reports whether any of them wants the program to end
+bool RunPhase(GameLoopPhase phase, timeuS frameDuration)
 {
-	srand(static_cast<unsigned int>(chrono::high_resolution_clock::now().time_since_epoch().count()));
+	s_scheduler.RunPhase(phase, frameDuration);
+	for (auto&& system : s_systems)
+	{
+		if (system->ShouldExit())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int SimulationStepsThisFrame()
+{
+	const auto& timeEntities = s_manager.entitiesMatching<ECS_Core::Signatures::S_TimeTracker>();
+	if (timeEntities.size() == 0)
+	{
+		return 1;
+	}
+	return s_manager.getComponent<ECS_Core::Components::C_TimeTracker>(timeEntities.front()).m_stepsThisFrame;
+}
+
+struct RunOptions
+{
+	// No window, input or rendering. Frames advance by a fixed duration as fast as they can
+	bool m_headless{ false };
+	int m_daysToSimulate{ 360 };
+	timeuS m_frameDuration{ 16667 };
+	int m_gameSpeed{ 1 };
+	// The same seed generates the same world, so runs can be repeated
+	u32 m_worldSeed{ static_cast<u32>(chrono::high_resolution_clock::now().time_since_epoch().count()) };
+	// Wall-clock time the simulation steps of one frame may take before the rest wait for the next frame,
+	// so a slow simulation can't stall drawing and input. Headless runs every step owed, to stay repeatable
+	timeuS m_stepBudget{ 50000 };
+	// The profiler is off unless asked for
+	bool m_profile{ false };
+	// Frames slower than a quarter second write a trace of the last few seconds next to the executable
+	bool m_traceSpikes{ false };
+};
+
+// Dictator.exe [--headless] [--days N] [--frame-duration uS] [--speed N] [--seed N] [--step-budget uS] [--profile] [--trace-spikes]
+RunOptions ParseRunOptions(int argc, char** argv)
+{
+	RunOptions options;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument(argv[i]);
+		bool hasValue = i + 1 < argc;
+		if (argument == "--headless")
+		{
+			options.m_headless = true;
+		}
+		else if (argument == "--days" && hasValue)
+		{
+			options.m_daysToSimulate = stoi(argv[++i]);
+		}
+		else if (argument == "--frame-duration" && hasValue)
+		{
+			options.m_frameDuration = stoll(argv[++i]);
+		}
+		else if (argument == "--speed" && hasValue)
+		{
+			options.m_gameSpeed = stoi(argv[++i]);
+		}
+		else if (argument == "--seed" && hasValue)
+		{
+			options.m_worldSeed = static_cast<u32>(stoul(argv[++i]));
+		}
+		else if (argument == "--step-budget" && hasValue)
+		{
+			options.m_stepBudget = stoll(argv[++i]);
+		}
+		else if (argument == "--profile")
+		{
+			options.m_profile = true;
+		}
+		else if (argument == "--trace-spikes")
+		{
+			options.m_traceSpikes = true;
+		}
+		else
+		{
+			cerr << "Ignoring unknown argument " << argument << endl;
+		}
+	}
+	return options;
+}
+
+int main(int argc, char** argv)
+{
+	auto options = ParseRunOptions(argc, argv);
+	cout << "World seed " << options.m_worldSeed << endl;
 	// Systems registered in processing order
+	// Within a phase, systems that touch different components may run at the same time
 	
 	// Give the UI first shot at any inputs. Draw order is separate from processing order
 	// And we'll read input before the Action phase
@@ -57,12 +157,21 @@ int main()
 	RegisterSystem<Government>();
 	RegisterSystem<PopulationGrowth>();
 	RegisterSystem<BuildingCreation>();
-	RegisterSystem<WorldTile>();
+	RegisterSystem<WorldTile>().SetWorldSeed(options.m_worldSeed);
 	RegisterSystem<CaravanTrade>();
 	RegisterSystem<Education>();
 
-	// Draw last
-	RegisterSystem<SFMLManager>();
+	if (options.m_headless)
+	{
+		auto& session = RegisterSystem<HeadlessSession>();
+		session.SetDaysToSimulate(options.m_daysToSimulate);
+		session.SetGameSpeed(options.m_gameSpeed);
+	}
+	else
+	{
+		// Draw last
+		RegisterSystem<SFMLManager>();
+	}
 
 	// Kill units last, other things may want to refer to them
 	RegisterSystem<UnitDeath>();
@@ -73,6 +182,13 @@ int main()
 	}
 	s_manager.refresh();
 
+	Profiler::SetEnabled(options.m_profile || options.m_traceSpikes);
+	if (options.m_traceSpikes)
+	{
+		// Frames slower than a quarter second write a trace of the last few seconds next to the executable
+		Profiler::SetSpikeThreshold(250000);
+	}
+
 	auto loopStart = chrono::high_resolution_clock::now();
 
 	for (auto&& system : s_systems)
@@ -84,27 +200,50 @@ int main()
 	while(true)
 	{
 		auto now = chrono::high_resolution_clock::now();
-		auto loopDuration = chrono::duration_cast<chrono::microseconds>(now - loopStart).count();
-		static const vector<GameLoopPhase> c_phaseOrder = {
-			GameLoopPhase::PREPARATION,
-			GameLoopPhase::INPUT,
-			GameLoopPhase::ACTION,
-			GameLoopPhase::ACTION_RESPONSE,
-			GameLoopPhase::RENDER,
-			GameLoopPhase::CLEANUP
-		};
-		for (auto&& phase : c_phaseOrder)
+		auto loopDuration = options.m_headless
+			? options.m_frameDuration
+			: chrono::duration_cast<chrono::microseconds>(now - loopStart).count();
+		if (RunPhase(GameLoopPhase::PREPARATION, loopDuration)
+			|| RunPhase(GameLoopPhase::INPUT, loopDuration))
 		{
-			for (auto&& system : s_systems)
+			return 0;
+		}
+		// The simulation runs in fixed steps, as many as the time that passed covers,
+		// and the frame is only drawn once after the last of them
+		auto steps = SimulationStepsThisFrame();
+		auto stepsStart = chrono::high_resolution_clock::now();
+		for (int step = 0; step < steps; ++step)
+		{
+			if (RunPhase(GameLoopPhase::ACTION, loopDuration)
+				|| RunPhase(GameLoopPhase::ACTION_RESPONSE, loopDuration))
+			{
+				return 0;
+			}
+			if (step + 1 == steps
+				|| (!options.m_headless
+					&& chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - stepsStart).count() > options.m_stepBudget))
 			{
-				system->Operate(phase, loopDuration);
-				if (system->ShouldExit())
-				{
-					return 0;
-				}
+				// Steps left over stay owed, and Time hands them to the next frame
+				break;
 			}
+			// Clear out this step's plans and deaths before the next
+			if (RunPhase(GameLoopPhase::CLEANUP, loopDuration))
+			{
+				return 0;
+			}
+			PROFILE_ZONE("Manager refresh");
+			s_manager.refresh();
+		}
+		if (RunPhase(GameLoopPhase::RENDER, loopDuration)
+			|| RunPhase(GameLoopPhase::CLEANUP, loopDuration))
+		{
+			return 0;
+		}
+		{
+			PROFILE_ZONE("Manager refresh");
+			s_manager.refresh();
 		}
-		s_manager.refresh();
+		Profiler::EndFrame();
 		loopStart = now;
 	}
 }
@@ -0,0 +1,261 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/ArchetypeStorageTests.cpp
+// Moving entities between archetypes, and iterating and refreshing a manager that keeps them
+
+#include "../MPLECS/ECS/ecs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+namespace
+{
+	struct Position
+	{
+		Position(int x, int y) : m_x(x), m_y(y) {}
+		int m_x;
+		int m_y;
+	};
+
+	struct Velocity
+	{
+		explicit Velocity(int speed) : m_speed(speed) {}
+		int m_speed;
+	};
+
+	// Counts the live copies, so destroyed rows can be checked for
+	struct Tracked
+	{
+		explicit Tracked(int value) : m_value(value) { ++s_live; }
+		Tracked(Tracked&& other) : m_value(other.m_value) { ++s_live; }
+		Tracked& operator=(Tracked&& other) { m_value = other.m_value; return *this; }
+		~Tracked() { --s_live; }
+		int m_value;
+		static int s_live;
+	};
+	int Tracked::s_live = 0;
+
+	using S_Position = ecs::Signature<Position>;
+	using S_Moving = ecs::Signature<Position, Velocity>;
+	using S_Tracked = ecs::Signature<Tracked>;
+
+	using TestSettings = ecs::Settings<
+		ecs::ComponentList<Position, Velocity, Tracked>,
+		ecs::TagList<>,
+		ecs::SignatureList<S_Position, S_Moving, S_Tracked>,
+		ecs::ArchetypeStorage>;
+	using Storage = ecs::Impl::ArchetypeComponentStorage<TestSettings>;
+	using Manager = ecs::Manager<TestSettings>;
+
+	template <typename... Ts>
+	TestSettings::Bitset BitsetOf()
+	{
+		TestSettings::Bitset bitset;
+		(bitset.set(TestSettings::componentBit<Ts>()), ...);
+		return bitset;
+	}
+
+	// Entity indices visited by a walk over the rows holding all of Ts
+	template <typename... Ts>
+	std::multiset<size_t> RowsMatching(Storage& storage)
+	{
+		std::multiset<size_t> visited;
+		storage.forRowsMatching<Ts...>(BitsetOf<Ts...>(), [&visited](ecs::EntityIndex entity, Ts&...) {
+			visited.insert(entity);
+			return ecs::IterationBehavior::CONTINUE;
+		});
+		return visited;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(ArchetypeStorageTests)
+
+BOOST_AUTO_TEST_CASE(AddKeepsComponentsAcrossArchetypes)
+{
+	Storage storage;
+	storage.grow(8);
+	storage.addComponent<Position>(ecs::EntityIndex{ 0 }, ecs::DataIndex{ 0 }, 1, 2);
+	storage.addComponent<Position>(ecs::EntityIndex{ 1 }, ecs::DataIndex{ 1 }, 3, 4);
+	BOOST_TEST(storage.getArchetypeCount() == 1u);
+
+	// Moves entity 0 into a new archetype, entity 1 fills its old row
+	storage.addComponent<Velocity>(ecs::EntityIndex{ 0 }, ecs::DataIndex{ 0 }, 5);
+	BOOST_TEST(storage.getArchetypeCount() == 2u);
+	BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ 0 }).m_x == 1);
+	BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ 0 }).m_y == 2);
+	BOOST_TEST(storage.getComponent<Velocity>(ecs::DataIndex{ 0 }).m_speed == 5);
+	BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ 1 }).m_x == 3);
+	BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ 1 }).m_y == 4);
+
+	// Adding a component the entity already has replaces it in place
+	storage.addComponent<Velocity>(ecs::EntityIndex{ 0 }, ecs::DataIndex{ 0 }, 7);
+	BOOST_TEST(storage.getArchetypeCount() == 2u);
+	BOOST_TEST(storage.getComponent<Velocity>(ecs::DataIndex{ 0 }).m_speed == 7);
+
+	BOOST_TEST((RowsMatching<Position>(storage) == std::multiset<size_t>{ 0, 1 }));
+	BOOST_TEST((RowsMatching<Position, Velocity>(storage) == std::multiset<size_t>{ 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFillsTheHoleWithTheLastRow)
+{
+	Storage storage;
+	storage.grow(8);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		storage.addComponent<Position>(ecs::EntityIndex{ i }, ecs::DataIndex{ i }, static_cast<int>(i), static_cast<int>(10 * i));
+		storage.addComponent<Velocity>(ecs::EntityIndex{ i }, ecs::DataIndex{ i }, static_cast<int>(100 + i));
+	}
+
+	storage.delComponent<Velocity>(ecs::DataIndex{ 1 });
+	// Removing a component the entity doesn't have changes nothing
+	storage.delComponent<Velocity>(ecs::DataIndex{ 1 });
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ i }).m_x == static_cast<int>(i));
+		BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ i }).m_y == static_cast<int>(10 * i));
+		if (i != 1)
+		{
+			BOOST_TEST(storage.getComponent<Velocity>(ecs::DataIndex{ i }).m_speed == static_cast<int>(100 + i));
+		}
+	}
+	BOOST_TEST((RowsMatching<Position>(storage) == std::multiset<size_t>{ 0, 1, 2, 3 }));
+	BOOST_TEST((RowsMatching<Position, Velocity>(storage) == std::multiset<size_t>{ 0, 2, 3 }));
+
+	// Removing the last component leaves the entity in no archetype
+	storage.delComponent<Velocity>(ecs::DataIndex{ 2 });
+	storage.delComponent<Position>(ecs::DataIndex{ 2 });
+	BOOST_TEST((RowsMatching<Position>(storage) == std::multiset<size_t>{ 0, 1, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(RelocateRenamesTheRowsEntity)
+{
+	Storage storage;
+	storage.grow(8);
+	storage.addComponent<Position>(ecs::EntityIndex{ 6 }, ecs::DataIndex{ 2 }, 1, 1);
+	storage.relocate(ecs::DataIndex{ 2 }, ecs::EntityIndex{ 3 });
+	BOOST_TEST((RowsMatching<Position>(storage) == std::multiset<size_t>{ 3 }));
+
+	// The row keeps the new entity index when it moves archetype
+	storage.addComponent<Velocity>(ecs::EntityIndex{ 3 }, ecs::DataIndex{ 2 }, 1);
+	storage.delComponent<Velocity>(ecs::DataIndex{ 2 });
+	BOOST_TEST((RowsMatching<Position>(storage) == std::multiset<size_t>{ 3 }));
+	BOOST_TEST(storage.getComponent<Position>(ecs::DataIndex{ 2 }).m_x == 1);
+}
+
+BOOST_AUTO_TEST_CASE(DestroysEveryComponentItHolds)
+{
+	{
+		Storage storage;
+		storage.grow(8);
+		for (size_t i = 0; i < 5; ++i)
+		{
+			storage.addComponent<Tracked>(ecs::EntityIndex{ i }, ecs::DataIndex{ i }, static_cast<int>(i));
+		}
+		// Moving archetype moves the component rather than copying it
+		storage.addComponent<Position>(ecs::EntityIndex{ 0 }, ecs::DataIndex{ 0 }, 0, 0);
+		BOOST_TEST(Tracked::s_live == 5);
+
+		storage.destroyComponents(ecs::DataIndex{ 4 }, BitsetOf<Tracked>());
+		BOOST_TEST(Tracked::s_live == 4);
+		BOOST_TEST(storage.getComponent<Tracked>(ecs::DataIndex{ 0 }).m_value == 0);
+		BOOST_TEST(storage.getComponent<Tracked>(ecs::DataIndex{ 3 }).m_value == 3);
+	}
+	BOOST_TEST(Tracked::s_live == 0);
+}
+
+BOOST_AUTO_TEST_CASE(IterationMayChangeTheVisitedEntity)
+{
+	Manager manager;
+	for (int i = 0; i < 10; ++i)
+	{
+		manager.addComponent<Position>(manager.createIndex(), i, 0);
+	}
+	manager.refresh();
+
+	// Each entity is visited once, even though half of them move archetype under the walk
+	std::multiset<size_t> visited;
+	manager.forEntitiesMatching<S_Position>([&manager, &visited](ecs::EntityIndex entity, Position& position) {
+		visited.insert(entity);
+		if (position.m_x % 2 == 0)
+		{
+			// Passes a reference into the row that is about to move
+			manager.addComponent<Velocity>(entity, position.m_x);
+		}
+		return ecs::IterationBehavior::CONTINUE;
+	});
+	BOOST_TEST(visited.size() == 10u);
+	BOOST_TEST(std::set<size_t>(visited.begin(), visited.end()).size() == 10u);
+
+	// And the other way, removing what the walk asked for
+	int moving = 0;
+	manager.forEntitiesMatching<S_Moving>([&manager, &moving](ecs::EntityIndex entity, Position& position, Velocity& velocity) {
+		BOOST_TEST(velocity.m_speed == position.m_x);
+		++moving;
+		manager.delComponent<Velocity>(entity);
+		return ecs::IterationBehavior::CONTINUE;
+	});
+	BOOST_TEST(moving == 5);
+
+	moving = 0;
+	manager.forEntitiesMatching<S_Moving>([&moving](ecs::EntityIndex, Position&, Velocity&) {
+		++moving;
+		return ecs::IterationBehavior::CONTINUE;
+	});
+	BOOST_TEST(moving == 0);
+}
+
+BOOST_AUTO_TEST_CASE(RefreshDestroysTheDeadTail)
+{
+	{
+		Manager manager;
+		std::vector<Manager::Handle> handles;
+		for (int i = 0; i < 6; ++i)
+		{
+			handles.push_back(manager.createHandle());
+			manager.addComponent<Tracked>(handles.back(), i);
+		}
+		manager.refresh();
+		BOOST_TEST(Tracked::s_live == 6);
+
+		// One in the middle, which the last survivor is swapped into, and three off the end
+		for (auto dead : { 1, 3, 4, 5 })
+		{
+			manager.kill(handles[dead]);
+		}
+		manager.refresh();
+		BOOST_TEST(manager.getEntityCount() == 2u);
+		BOOST_TEST(Tracked::s_live == 2);
+		for (auto alive : { 0, 2 })
+		{
+			BOOST_TEST(manager.isHandleValid(handles[alive]));
+			BOOST_TEST(manager.getComponent<Tracked>(handles[alive]).m_value == alive);
+		}
+		for (auto dead : { 1, 3, 4, 5 })
+		{
+			BOOST_TEST(!manager.isHandleValid(handles[dead]));
+		}
+
+		std::set<int> values;
+		manager.forEntitiesMatching<S_Tracked>([&values](ecs::EntityIndex, Tracked& tracked) {
+			values.insert(tracked.m_value);
+			return ecs::IterationBehavior::CONTINUE;
+		});
+		BOOST_TEST((values == std::set<int>{ 0, 2 }));
+
+		// Slots freed by the dead come back empty
+		auto reused = manager.createHandle();
+		manager.refresh();
+		BOOST_TEST(!manager.hasComponent<Tracked>(reused));
+		BOOST_TEST(Tracked::s_live == 2);
+	}
+	BOOST_TEST(Tracked::s_live == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
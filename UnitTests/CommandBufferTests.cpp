@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/CommandBufferTests.cpp
+// Recording changes away from the manager and playing them back on refresh
+
+#include "../MPLECS/ECS/ecs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace
+{
+	struct Position
+	{
+		explicit Position(int x = 0) : m_x(x) {}
+		int m_x;
+	};
+
+	struct Velocity
+	{
+		explicit Velocity(int speed = 0) : m_speed(speed) {}
+		int m_speed;
+	};
+
+	struct T_Marked {};
+
+	using S_Position = ecs::Signature<Position>;
+	using S_Marked = ecs::Signature<T_Marked>;
+
+	using TestSettings = ecs::Settings<
+		ecs::ComponentList<Position, Velocity>,
+		ecs::TagList<T_Marked>,
+		ecs::SignatureList<S_Position, S_Marked>>;
+	using Manager = ecs::Manager<TestSettings>;
+	using CommandBuffer = ecs::CommandBuffer<TestSettings>;
+
+	template <typename Signature>
+	int CountMatching(Manager& manager)
+	{
+		int count = 0;
+		manager.forEntitiesMatching<Signature>([&count](ecs::EntityIndex, auto&...) {
+			++count;
+			return ecs::IterationBehavior::CONTINUE;
+		});
+		return count;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(CommandBufferTests)
+
+BOOST_AUTO_TEST_CASE(NothingHappensUntilRefresh)
+{
+	Manager manager;
+	CommandBuffer commands;
+	BOOST_TEST(commands.empty());
+	auto entity = commands.create();
+	commands.addComponent<Position>(entity, 3);
+	commands.addTag<T_Marked>(entity);
+	BOOST_TEST(!commands.empty());
+
+	manager.submit(std::move(commands));
+	BOOST_TEST(manager.getEntityCount() == 0u);
+
+	manager.refresh();
+	BOOST_TEST(manager.getEntityCount() == 1u);
+	BOOST_TEST(CountMatching<S_Marked>(manager) == 1);
+	manager.forEntitiesMatching<S_Position>([](ecs::EntityIndex, Position& position) {
+		BOOST_TEST(position.m_x == 3);
+		return ecs::IterationBehavior::CONTINUE;
+	});
+}
+
+BOOST_AUTO_TEST_CASE(CreatedEntitiesGetRealHandles)
+{
+	Manager manager;
+	CommandBuffer commands;
+	std::vector<Manager::Handle> handles;
+	for (int i = 0; i < 3; ++i)
+	{
+		auto entity = commands.create();
+		commands.addComponent<Position>(entity, i);
+		commands.onCreated(entity, [&handles](Manager&, const Manager::Handle& handle) {
+			handles.push_back(handle);
+		});
+	}
+	manager.submit(std::move(commands));
+	manager.refresh();
+
+	BOOST_TEST(handles.size() == 3u);
+	for (int i = 0; i < 3; ++i)
+	{
+		BOOST_TEST(manager.isHandleValid(handles[i]));
+		BOOST_TEST(manager.getComponent<Position>(handles[i]).m_x == i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CommandsPlayBackInOrder)
+{
+	Manager manager;
+	auto handle = manager.createHandle();
+	manager.refresh();
+
+	CommandBuffer first;
+	first.addComponent<Position>(handle, 1);
+	first.addComponent<Velocity>(handle, 1);
+	first.delComponent<Velocity>(handle);
+	CommandBuffer second;
+	second.addComponent<Position>(handle, 2);
+	// Removing what isn't there is skipped
+	second.delComponent<Velocity>(handle);
+	second.delTag<T_Marked>(handle);
+	manager.submit(std::move(first));
+	manager.submit(std::move(second));
+	manager.refresh();
+
+	BOOST_TEST(manager.getComponent<Position>(handle).m_x == 2);
+	BOOST_TEST(!manager.hasComponent<Velocity>(handle));
+	BOOST_TEST(!manager.hasTag<T_Marked>(handle));
+}
+
+BOOST_AUTO_TEST_CASE(CommandsForTheDeadAreSkipped)
+{
+	Manager manager;
+	auto doomed = manager.createHandle();
+	manager.refresh();
+
+	CommandBuffer commands;
+	commands.addComponent<Position>(doomed, 1);
+	commands.addTag<T_Marked>(doomed);
+	manager.kill(doomed);
+	manager.refresh();
+	BOOST_TEST(!manager.isHandleValid(doomed));
+
+	// The dead entity's slot is taken again before the commands arrive
+	auto reused = manager.createHandle();
+	manager.submit(std::move(commands));
+	manager.refresh();
+	BOOST_TEST(manager.isHandleValid(reused));
+	BOOST_TEST(!manager.hasComponent<Position>(reused));
+	BOOST_TEST(!manager.hasTag<T_Marked>(reused));
+}
+
+BOOST_AUTO_TEST_CASE(KillsApplyOnTheSameRefresh)
+{
+	Manager manager;
+	CommandBuffer commands;
+	auto entity = commands.create();
+	commands.addComponent<Position>(entity, 1);
+	commands.kill(entity);
+	commands.addComponent<Position>(commands.create(), 2);
+	manager.submit(std::move(commands));
+	manager.refresh();
+
+	BOOST_TEST(manager.getEntityCount() == 1u);
+	manager.forEntitiesMatching<S_Position>([](ecs::EntityIndex, Position& position) {
+		BOOST_TEST(position.m_x == 2);
+		return ecs::IterationBehavior::CONTINUE;
+	});
+}
+
+BOOST_AUTO_TEST_CASE(BuffersMayBeSubmittedFromManyThreads)
+{
+	Manager manager;
+	ecs::ThreadPool pool(3);
+	constexpr size_t c_entities = 200;
+	pool.parallelFor(c_entities, 1, [&manager](size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i)
+		{
+			CommandBuffer commands;
+			commands.addComponent<Position>(commands.create(), static_cast<int>(i));
+			manager.submit(std::move(commands));
+		}
+	});
+	// An empty buffer isn't kept
+	manager.submit(CommandBuffer());
+	manager.refresh();
+
+	BOOST_TEST(manager.getEntityCount() == c_entities);
+	std::vector<int> seen(c_entities, 0);
+	manager.forEntitiesMatching<S_Position>([&seen](ecs::EntityIndex, Position& position) {
+		++seen[position.m_x];
+		return ecs::IterationBehavior::CONTINUE;
+	});
+	BOOST_TEST((seen == std::vector<int>(c_entities, 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/CompactPathTests.cpp
+// Packing, walking and reversing CompactPath
+
+#include "../MPLECS/Util/CompactPath.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using TileCosts = std::vector<std::pair<TilePosition, int>>;
+
+	// Steps east across a sector edge, stays put, jumps to another quadrant and steps north from there
+	const TileCosts c_tiles = {
+		{ TilePosition(0, 0, 1, 1, 48, 10), 3 },
+		{ TilePosition(0, 0, 1, 1, 49, 10), 5 },
+		{ TilePosition(0, 0, 2, 1, 0, 10), 7 },
+		{ TilePosition(0, 0, 2, 1, 0, 10), 11 },
+		{ TilePosition(1, -1, 4, 4, 20, 0), 13 },
+		{ TilePosition(1, -1, 4, 3, 20, 49), 17 },
+		{ TilePosition(1, -1, 4, 3, 20, 49), 19 },
+		{ TilePosition(0, 0, 0, 0, 0, 0), 23 },
+	};
+
+	CompactPath BuildPath(const TileCosts& tiles)
+	{
+		CompactPath path;
+		for (const auto& tile : tiles)
+		{
+			path.Append(tile.first, tile.second);
+		}
+		return path;
+	}
+
+	TileCosts AllTiles(const CompactPath& path)
+	{
+		TileCosts tiles;
+		path.ForEachTile([&tiles](const TilePosition& tile, int movementCost) {
+			tiles.emplace_back(tile, movementCost);
+		});
+		return tiles;
+	}
+
+	TileCosts Reversed(TileCosts tiles)
+	{
+		std::reverse(tiles.begin(), tiles.end());
+		return tiles;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(CompactPathTests)
+
+BOOST_AUTO_TEST_CASE(AppendKeepsStaysAndJumps)
+{
+	auto path = BuildPath(c_tiles);
+	BOOST_TEST(path.Size() == c_tiles.size());
+	BOOST_TEST((path.Front() == c_tiles.front().first));
+	BOOST_TEST((path.Back() == c_tiles.back().first));
+	BOOST_TEST((AllTiles(path) == c_tiles));
+
+	for (size_t i = 0; i < c_tiles.size(); ++i)
+	{
+		BOOST_TEST(path.CurrentIndex() == i);
+		BOOST_TEST((path.CurrentTile() == c_tiles[i].first));
+		BOOST_TEST(path.CurrentMovementCost() == c_tiles[i].second);
+		BOOST_TEST(path.AtBack() == (i + 1 == c_tiles.size()));
+		path.Advance();
+	}
+	// Stays put at the back
+	BOOST_TEST((path.CurrentTile() == c_tiles.back().first));
+	BOOST_TEST(path.CurrentMovementCost() == c_tiles.back().second);
+}
+
+BOOST_AUTO_TEST_CASE(ReverseMidWalkRestartsFromNewFront)
+{
+	auto path = BuildPath(c_tiles);
+	for (size_t i = 0; i < 5; ++i)
+	{
+		path.Advance();
+	}
+	BOOST_TEST((path.CurrentTile() == c_tiles[5].first));
+
+	path.Reverse();
+	auto reversed = Reversed(c_tiles);
+	BOOST_TEST(path.CurrentIndex() == 0u);
+	BOOST_TEST((path.Front() == reversed.front().first));
+	BOOST_TEST((path.Back() == reversed.back().first));
+	BOOST_TEST((AllTiles(path) == reversed));
+
+	// Every tile keeps its own movement cost when walked backwards, across the jump and the stays
+	for (size_t i = 0; i < reversed.size(); ++i)
+	{
+		BOOST_TEST((path.CurrentTile() == reversed[i].first));
+		BOOST_TEST(path.CurrentMovementCost() == reversed[i].second);
+		if (i == 3)
+		{
+			TileCosts remaining;
+			path.ForEachRemainingTile([&remaining](const TilePosition& tile, int movementCost) {
+				remaining.emplace_back(tile, movementCost);
+			});
+			BOOST_TEST((remaining == TileCosts(reversed.begin() + 3, reversed.end())));
+		}
+		path.Advance();
+	}
+
+	// And back again
+	path.Reverse();
+	BOOST_TEST((AllTiles(path) == c_tiles));
+	BOOST_TEST(path.CurrentMovementCost() == c_tiles.front().second);
+}
+
+BOOST_AUTO_TEST_CASE(MovementCostIsClamped)
+{
+	CompactPath path;
+	path.Append(TilePosition(0, 0, 0, 0, 0, 0), -4);
+	path.Append(TilePosition(0, 0, 0, 0, 1, 0), CompactPath::c_maxMovementCost + 100);
+	path.Reverse();
+	BOOST_TEST(path.CurrentMovementCost() == CompactPath::c_maxMovementCost);
+	path.Advance();
+	BOOST_TEST(path.CurrentMovementCost() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
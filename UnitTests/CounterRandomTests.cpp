@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/CounterRandomTests.cpp
+// Repeatability and spread of CounterRandom's streams
+
+#include "../MPLECS/Util/CounterRandom.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <set>
+
+BOOST_AUTO_TEST_SUITE(CounterRandomTests)
+
+BOOST_AUTO_TEST_CASE(SameKeysGiveTheSameValues)
+{
+	auto stream = CounterRandom::StreamKey(12, 34);
+	BOOST_TEST(stream == CounterRandom::StreamKey(12, 34));
+	for (u32 counter = 0; counter < 100; ++counter)
+	{
+		BOOST_TEST(CounterRandom::Draw(stream, counter) == CounterRandom::Draw(stream, counter));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(StreamKeysDependOnOrder)
+{
+	BOOST_TEST(CounterRandom::StreamKey(1, 2) != CounterRandom::StreamKey(2, 1));
+	BOOST_TEST(CounterRandom::StreamKey(0, 1) != CounterRandom::StreamKey(1, 0));
+	BOOST_TEST(CounterRandom::Draw(CounterRandom::StreamKey(1, 2), 0) != CounterRandom::Draw(CounterRandom::StreamKey(2, 1), 0));
+}
+
+BOOST_AUTO_TEST_CASE(AStreamNeverRepeatsWithinItsPeriod)
+{
+	// Every step of Draw is invertible, so distinct counters give distinct values
+	std::set<u32> values;
+	auto stream = CounterRandom::StreamKey(5, 6);
+	for (u32 counter = 0; counter < 10000; ++counter)
+	{
+		values.insert(CounterRandom::Draw(stream, counter));
+	}
+	BOOST_TEST(values.size() == 10000u);
+}
+
+BOOST_AUTO_TEST_CASE(UnitDoublesStayInsideTheInterval)
+{
+	BOOST_TEST(CounterRandom::ToUnitDouble(0) > 0.);
+	BOOST_TEST(CounterRandom::ToUnitDouble(0xffffffffu) < 1.);
+	BOOST_TEST(CounterRandom::ToUnitDouble(0x80000000u) == 0.5, boost::test_tools::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(RangesAreCoveredEvenly)
+{
+	constexpr u32 c_bound = 10;
+	constexpr int c_draws = 100000;
+	BOOST_TEST(CounterRandom::ToRange(0, c_bound) == 0u);
+	BOOST_TEST(CounterRandom::ToRange(0xffffffffu, c_bound) == c_bound - 1);
+
+	std::array<int, c_bound> counts{};
+	auto stream = CounterRandom::StreamKey(7, 8);
+	for (int counter = 0; counter < c_draws; ++counter)
+	{
+		auto value = CounterRandom::ToRange(CounterRandom::Draw(stream, counter), c_bound);
+		BOOST_TEST_REQUIRE(value < c_bound);
+		++counts[value];
+	}
+	// Each bucket expects 10000 with a standard deviation near 95, so this is far outside chance
+	for (auto count : counts)
+	{
+		BOOST_TEST(count > c_draws / c_bound - 600);
+		BOOST_TEST(count < c_draws / c_bound + 600);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
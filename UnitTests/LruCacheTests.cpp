@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/LruCacheTests.cpp
+// Which entries LruCache keeps once it's full
+
+#include "../MPLECS/Util/LruCache.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(LruCacheTests)
+
+BOOST_AUTO_TEST_CASE(DropsTheLeastRecentlyInserted)
+{
+	LruCache<int, std::string> cache(2);
+	cache.Insert(1, "one");
+	cache.Insert(2, "two");
+	cache.Insert(3, "three");
+	BOOST_TEST(cache.Size() == 2u);
+	BOOST_TEST(!cache.Find(1));
+	BOOST_TEST(*cache.Find(2) == "two");
+	BOOST_TEST(*cache.Find(3) == "three");
+}
+
+BOOST_AUTO_TEST_CASE(FindingAnEntryKeepsIt)
+{
+	LruCache<int, std::string> cache(2);
+	cache.Insert(1, "one");
+	cache.Insert(2, "two");
+	BOOST_TEST(cache.Find(1));
+	cache.Insert(3, "three");
+	BOOST_TEST(*cache.Find(1) == "one");
+	BOOST_TEST(!cache.Find(2));
+	BOOST_TEST(*cache.Find(3) == "three");
+}
+
+BOOST_AUTO_TEST_CASE(InsertingAnExistingKeyReplacesAndKeepsIt)
+{
+	LruCache<int, std::string> cache(2);
+	cache.Insert(1, "one");
+	cache.Insert(2, "two");
+	cache.Insert(1, "uno");
+	BOOST_TEST(cache.Size() == 2u);
+	cache.Insert(3, "three");
+	BOOST_TEST(*cache.Find(1) == "uno");
+	BOOST_TEST(!cache.Find(2));
+}
+
+BOOST_AUTO_TEST_CASE(EraseAndClearFreeRoom)
+{
+	LruCache<int, std::string> cache(2);
+	cache.Insert(1, "one");
+	cache.Insert(2, "two");
+	cache.Erase(1);
+	// Erasing a key that isn't there changes nothing
+	cache.Erase(4);
+	BOOST_TEST(cache.Size() == 1u);
+	cache.Insert(3, "three");
+	BOOST_TEST(*cache.Find(2) == "two");
+	BOOST_TEST(*cache.Find(3) == "three");
+
+	cache.Clear();
+	BOOST_TEST(cache.Size() == 0u);
+	BOOST_TEST(!cache.Find(2));
+	cache.Insert(4, "four");
+	BOOST_TEST(*cache.Find(4) == "four");
+}
+
+BOOST_AUTO_TEST_CASE(HoldsMoveOnlyValues)
+{
+	LruCache<int, std::unique_ptr<int>> cache(1);
+	cache.Insert(1, std::make_unique<int>(10));
+	BOOST_TEST(**cache.Find(1) == 10);
+	cache.Insert(2, std::make_unique<int>(20));
+	BOOST_TEST(!cache.Find(1));
+	BOOST_TEST(**cache.Find(2) == 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,328 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/PathingTests.cpp
+// Searches which should find equally cheap paths: both open lists, with and without landmarks,
+// and an incremental search against a full one after costs change
+
+#include "../MPLECS/Util/CounterRandom.h"
+#include "../MPLECS/Util/Pathing.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+
+namespace
+{
+	constexpr int c_side = 8;
+	constexpr int c_sides = static_cast<int>(PathingDirection::_COUNT);
+
+	using DirectionalCosts = Pathing::DirectionMovementCostArray<c_side, c_side>;
+	using TileCosts = Pathing::MovementCostArray2<c_side, c_side>;
+
+	// Costs from 1 to 9, with one in closedOneIn closed
+	std::optional<int> RandomCost(u32 stream, u32& counter, u32 closedOneIn)
+	{
+		auto bits = CounterRandom::Draw(stream, counter++);
+		if (CounterRandom::ToRange(bits, closedOneIn) == 0)
+		{
+			return std::nullopt;
+		}
+		return 1 + static_cast<int>(CounterRandom::ToRange(CounterRandom::Draw(stream, counter++), 9));
+	}
+
+	// Every way through every node, including starting and ending there
+	DirectionalCosts RandomDirectionalCosts(u32 seed)
+	{
+		DirectionalCosts costs;
+		auto stream = CounterRandom::StreamKey(seed, 1);
+		u32 counter = 0;
+		for (int x = 0; x < c_side; ++x)
+		{
+			for (int y = 0; y < c_side; ++y)
+			{
+				for (int entry = 0; entry <= c_sides; ++entry)
+				{
+					for (int exit = 0; exit <= c_sides; ++exit)
+					{
+						if (entry != exit)
+						{
+							costs[x][y][entry][exit] = RandomCost(stream, counter, 8);
+						}
+					}
+				}
+			}
+		}
+		return costs;
+	}
+
+	TileCosts RandomTileCosts(u32 seed)
+	{
+		TileCosts costs;
+		auto stream = CounterRandom::StreamKey(seed, 2);
+		u32 counter = 0;
+		for (auto&& column : costs)
+		{
+			for (auto&& cost : column)
+			{
+				cost = RandomCost(stream, counter, 5);
+			}
+		}
+		return costs;
+	}
+
+	CoordinateVector2 RandomCoordinates(u32 stream, u32& counter)
+	{
+		auto x = CounterRandom::ToRange(CounterRandom::Draw(stream, counter++), c_side);
+		auto y = CounterRandom::ToRange(CounterRandom::Draw(stream, counter++), c_side);
+		return CoordinateVector2(x, y);
+	}
+
+	// The cost of following the path, or nullopt if it doesn't lead from origin to goal
+	// The origin is already stood in, so its crossing is free
+	std::optional<int> FollowMacroPath(
+		const DirectionalCosts& costs,
+		const Pathing::MacroPath& path,
+		const CoordinateVector2& origin,
+		const CoordinateVector2& goal)
+	{
+		if (path.m_path.empty()
+			|| !(path.m_path.front().m_node == origin)
+			|| path.m_path.front().m_entryDirection != PathingDirection::_COUNT
+			|| !(path.m_path.back().m_node == goal)
+			|| path.m_path.back().m_exitDirection != PathingDirection::_COUNT)
+		{
+			return std::nullopt;
+		}
+		int total = 0;
+		for (size_t i = 0; i < path.m_path.size(); ++i)
+		{
+			const auto& step = path.m_path[i];
+			const auto& crossing = costs[step.m_node.m_x][step.m_node.m_y]
+				[static_cast<int>(step.m_entryDirection)][static_cast<int>(step.m_exitDirection)];
+			if (!crossing)
+			{
+				return std::nullopt;
+			}
+			if (i > 0)
+			{
+				total += *crossing;
+			}
+			if (i + 1 < path.m_path.size())
+			{
+				const auto& next = path.m_path[i + 1];
+				if (!(next.m_node == step.m_node + Pathing::neighborOffsets[static_cast<int>(step.m_exitDirection)])
+					|| next.m_entryDirection != Opposite(step.m_exitDirection))
+				{
+					return std::nullopt;
+				}
+			}
+		}
+		return total;
+	}
+
+	// As above, where each step enters a neighbor at the neighbor's cost
+	std::optional<int> FollowPath(
+		const TileCosts& costs,
+		const Pathing::Path& path,
+		const CoordinateVector2& origin,
+		const CoordinateVector2& goal)
+	{
+		if (path.m_path.empty() || !(path.m_path.front() == origin) || !(path.m_path.back() == goal))
+		{
+			return std::nullopt;
+		}
+		int total = 0;
+		for (size_t i = 1; i < path.m_path.size(); ++i)
+		{
+			const auto& step = path.m_path[i];
+			if (Pathing::ManhattanDistance(path.m_path[i - 1], step) != 1 || !costs[step.m_x][step.m_y])
+			{
+				return std::nullopt;
+			}
+			total += *costs[step.m_x][step.m_y];
+		}
+		return total;
+	}
+
+	// Both searches agree on whether there's a path, and on what the cheapest one costs
+	void CheckIncrementalPath(
+		const TileCosts& costs,
+		const std::optional<Pathing::Path>& incremental,
+		const CoordinateVector2& start,
+		const CoordinateVector2& goal)
+	{
+		auto full = Pathing::GetPath<Pathing::BucketOpenList, c_side, c_side>(costs, start, goal);
+		BOOST_TEST(incremental.has_value() == full.has_value());
+		if (incremental && full)
+		{
+			BOOST_TEST(incremental->m_totalPathCost == full->m_totalPathCost);
+			BOOST_TEST((FollowPath(costs, *incremental, start, goal) == incremental->m_totalPathCost));
+		}
+	}
+
+	// Reopens, closes or reprices count random nodes, and tells the search about each
+	void ChangeCosts(TileCosts& costs, Pathing::IncrementalPath& search, u32 stream, u32& counter, int count)
+	{
+		auto costOf = [&costs](int x, int y) -> const std::optional<int>& { return costs[x][y]; };
+		for (int i = 0; i < count; ++i)
+		{
+			auto node = RandomCoordinates(stream, counter);
+			costs[node.m_x][node.m_y] = RandomCost(stream, counter, 4);
+			search.NodeChanged(costOf, node);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(PathingTests)
+
+BOOST_AUTO_TEST_CASE(DirectionalPathsAgreeAcrossOpenListsAndLandmarks)
+{
+	int pathsFound = 0;
+	for (u32 seed = 0; seed < 20; ++seed)
+	{
+		auto costs = RandomDirectionalCosts(seed);
+		auto costOf = [&costs](int x, int y, int entry, int exit) -> const std::optional<int>& {
+			return costs[x][y][entry][exit];
+		};
+		auto oracle = Pathing::BuildLandmarkOracle<c_side, c_side>(costOf);
+		BOOST_TEST(oracle.m_landmarkCount > 0);
+
+		auto stream = CounterRandom::StreamKey(seed, 3);
+		u32 counter = 0;
+		for (int query = 0; query < 10; ++query)
+		{
+			auto origin = RandomCoordinates(stream, counter);
+			auto goal = RandomCoordinates(stream, counter);
+			auto landmarks = [&oracle, &goal](int x, int y, int entry) {
+				return oracle.LowerBound(x, y, entry, goal);
+			};
+
+			auto heap = Pathing::GetDirectionalPath<Pathing::HeapOpenList, c_side, c_side>(costOf, origin, goal);
+			auto bucket = Pathing::GetDirectionalPath<Pathing::BucketOpenList, c_side, c_side>(costOf, origin, goal);
+			auto heapLandmarks = Pathing::GetDirectionalPath<Pathing::HeapOpenList, c_side, c_side>(costOf, origin, goal, landmarks);
+			auto bucketLandmarks = Pathing::GetDirectionalPath<Pathing::BucketOpenList, c_side, c_side>(costOf, origin, goal, landmarks);
+
+			for (const auto* path : { &bucket, &heapLandmarks, &bucketLandmarks })
+			{
+				BOOST_TEST(path->has_value() == heap.has_value());
+				if (*path && heap)
+				{
+					BOOST_TEST((*path)->m_totalPathCost == heap->m_totalPathCost);
+				}
+			}
+			for (const auto* path : { &heap, &bucket, &heapLandmarks, &bucketLandmarks })
+			{
+				if (*path)
+				{
+					BOOST_TEST((FollowMacroPath(costs, **path, origin, goal) == (*path)->m_totalPathCost));
+				}
+			}
+			pathsFound += heap ? 1 : 0;
+		}
+	}
+	// Most queries should have had a path to compare
+	BOOST_TEST(pathsFound > 100);
+}
+
+BOOST_AUTO_TEST_CASE(LandmarkBoundsNeverOverestimate)
+{
+	auto costs = RandomDirectionalCosts(7);
+	auto costOf = [&costs](int x, int y, int entry, int exit) -> const std::optional<int>& {
+		return costs[x][y][entry][exit];
+	};
+	auto oracle = Pathing::BuildLandmarkOracle<c_side, c_side>(costOf);
+
+	auto stream = CounterRandom::StreamKey(7, 4);
+	u32 counter = 0;
+	for (int query = 0; query < 50; ++query)
+	{
+		auto origin = RandomCoordinates(stream, counter);
+		auto goal = RandomCoordinates(stream, counter);
+		auto path = Pathing::GetDirectionalPath<Pathing::HeapOpenList, c_side, c_side>(costOf, origin, goal);
+		if (!path || path->m_path.size() < 2)
+		{
+			continue;
+		}
+		// From the second node on, the rest of the path is what the bound is for
+		auto cost = path->m_totalPathCost;
+		for (size_t i = 1; i < path->m_path.size(); ++i)
+		{
+			const auto& step = path->m_path[i];
+			auto bound = oracle.LowerBound(
+				static_cast<int>(step.m_node.m_x),
+				static_cast<int>(step.m_node.m_y),
+				static_cast<int>(step.m_entryDirection),
+				goal);
+			BOOST_TEST(bound.has_value());
+			if (bound)
+			{
+				BOOST_TEST(*bound <= cost);
+			}
+			cost -= *costs[step.m_node.m_x][step.m_node.m_y]
+				[static_cast<int>(step.m_entryDirection)][static_cast<int>(step.m_exitDirection)];
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalPathMatchesAFullSearchAfterCostChanges)
+{
+	for (u32 seed = 0; seed < 20; ++seed)
+	{
+		auto costs = RandomTileCosts(seed);
+		auto costOf = [&costs](int x, int y) -> const std::optional<int>& { return costs[x][y]; };
+
+		auto stream = CounterRandom::StreamKey(seed, 5);
+		u32 counter = 0;
+		auto start = RandomCoordinates(stream, counter);
+		auto goal = RandomCoordinates(stream, counter);
+		if (start == goal)
+		{
+			continue;
+		}
+
+		Pathing::IncrementalPath search(c_side, c_side, start, goal, 1);
+		CheckIncrementalPath(costs, search.Replan(costOf), start, goal);
+		for (int round = 0; round < 10; ++round)
+		{
+			ChangeCosts(costs, search, stream, counter, 6);
+			CheckIncrementalPath(costs, search.Replan(costOf), start, goal);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalPathFollowsAMovingStart)
+{
+	for (u32 seed = 0; seed < 20; ++seed)
+	{
+		auto costs = RandomTileCosts(seed);
+		auto costOf = [&costs](int x, int y) -> const std::optional<int>& { return costs[x][y]; };
+
+		auto stream = CounterRandom::StreamKey(seed, 6);
+		u32 counter = 0;
+		auto start = RandomCoordinates(stream, counter);
+		auto goal = RandomCoordinates(stream, counter);
+		if (start == goal)
+		{
+			continue;
+		}
+
+		Pathing::IncrementalPath search(c_side, c_side, start, goal, 1);
+		auto path = search.Replan(costOf);
+		CheckIncrementalPath(costs, path, start, goal);
+		// Take a step, then costs change around the unit, until it arrives or gets cut off
+		for (int steps = 0; path && path->m_path.size() > 1 && steps < 4 * c_side * c_side; ++steps)
+		{
+			start = path->m_path[1];
+			search.MoveStart(start);
+			ChangeCosts(costs, search, stream, counter, 3);
+			path = search.Replan(costOf);
+			CheckIncrementalPath(costs, path, start, goal);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
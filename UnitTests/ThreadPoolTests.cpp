@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// All code is property of Dictator Developers Inc
+// Contact at Loesby.dev@gmail.com for permission to use
+// Or to discuss ideas
+// (c) 2018
+
+// UnitTests/ThreadPoolTests.cpp
+// Submitted tasks and parallel ranges each run exactly once, nested or not
+
+#include "../MPLECS/ECS/ThreadPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Each slot counts the calls that covered its index
+	std::vector<std::atomic<int>> Counters(size_t count)
+	{
+		std::vector<std::atomic<int>> counters(count);
+		for (auto&& counter : counters)
+		{
+			counter = 0;
+		}
+		return counters;
+	}
+
+	bool AllOnce(const std::vector<std::atomic<int>>& counters)
+	{
+		for (auto&& counter : counters)
+		{
+			if (counter != 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTests)
+
+BOOST_AUTO_TEST_CASE(SubmittedTasksReturnTheirResults)
+{
+	ecs::ThreadPool pool(3);
+	BOOST_TEST(pool.getWorkerCount() == 3u);
+
+	std::vector<std::future<int>> results;
+	for (int i = 0; i < 100; ++i)
+	{
+		results.push_back(pool.submit([i]() { return i * i; }));
+	}
+	for (int i = 0; i < 100; ++i)
+	{
+		BOOST_TEST(results[i].get() == i * i);
+	}
+
+	auto onWorker = pool.submit([&pool]() { return pool.isWorkerThread(); });
+	BOOST_TEST(onWorker.get());
+	BOOST_TEST(!pool.isWorkerThread());
+}
+
+BOOST_AUTO_TEST_CASE(ParallelForCoversEveryIndexOnce)
+{
+	ecs::ThreadPool pool(3);
+	for (size_t grain : { 1u, 7u, 64u, 1000u, 5000u })
+	{
+		auto counters = Counters(1000);
+		pool.parallelFor(counters.size(), grain, [&counters](size_t begin, size_t end) {
+			for (auto i = begin; i < end; ++i)
+			{
+				++counters[i];
+			}
+		});
+		BOOST_TEST(AllOnce(counters));
+	}
+
+	// Nothing to do, and nothing run
+	bool called = false;
+	pool.parallelFor(0, 1, [&called](size_t, size_t) { called = true; });
+	BOOST_TEST(!called);
+
+	// One range is run on the calling thread
+	std::thread::id caller;
+	pool.parallelFor(10, 10, [&caller](size_t, size_t) { caller = std::this_thread::get_id(); });
+	BOOST_TEST((caller == std::this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_CASE(NestedParallelForDoesNotDeadlock)
+{
+	// Every worker is busy with an outer range while the inner ranges are queued
+	ecs::ThreadPool pool(2);
+	constexpr size_t c_outer = 8;
+	constexpr size_t c_inner = 100;
+	auto counters = Counters(c_outer * c_inner);
+	pool.parallelFor(c_outer, 1, [&pool, &counters](size_t outerBegin, size_t outerEnd) {
+		for (auto outer = outerBegin; outer < outerEnd; ++outer)
+		{
+			pool.parallelFor(c_inner, 10, [&counters, outer](size_t begin, size_t end) {
+				for (auto inner = begin; inner < end; ++inner)
+				{
+					++counters[outer * c_inner + inner];
+				}
+			});
+		}
+	});
+	BOOST_TEST(AllOnce(counters));
+}
+
+BOOST_AUTO_TEST_CASE(WorkersWaitingOnTasksRunThem)
+{
+	// The only worker waits on a task it queued behind itself, so it has to run it while waiting
+	ecs::ThreadPool pool(1);
+	auto outer = pool.submit([&pool]() {
+		auto inner = pool.submit([]() { return 42; });
+		pool.waitUntil([&inner]() {
+			return inner.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		});
+		return inner.get();
+	});
+	BOOST_TEST(outer.get() == 42);
+}
+
+BOOST_AUTO_TEST_SUITE_END()